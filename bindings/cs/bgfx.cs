@@ -1918,6 +1918,7 @@ public static partial class bgfx
 			public uint maxEncoders;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public uint maxTransforms;
 		}
 	
 		public RendererType rendererType;
@@ -1964,6 +1965,9 @@ public static partial class bgfx
 			public ushort maxEncoders;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public uint maxDrawCalls;
+			public uint maxTransforms;
+			public ushort numFrames;
 		}
 	
 		public RendererType type;
@@ -1971,6 +1975,7 @@ public static partial class bgfx
 		public ushort deviceId;
 		public byte debug;
 		public byte profile;
+		public byte mergeDraws;
 		public PlatformData platformData;
 		public Resolution resolution;
 		public Limits limits;
@@ -2059,6 +2064,9 @@ public static partial class bgfx
 	{
 		public long cpuTimeBegin;
 		public long cpuTimeEnd;
+		public uint numSubmitted;
+		public uint numDropped;
+		public uint uniformBufferUsed;
 	}
 	
 	public unsafe struct Stats
@@ -2072,10 +2080,14 @@ public static partial class bgfx
 		public long gpuTimerFreq;
 		public long waitRender;
 		public long waitSubmit;
+		public long cpuTimeSort;
 		public uint numDraw;
 		public uint numCompute;
 		public uint numBlit;
 		public uint maxGpuLatency;
+		public uint numDrawsMerged;
+		public uint numDropped;
+		public uint numUniformsSkipped;
 		public ushort numDynamicIndexBuffers;
 		public ushort numDynamicVertexBuffers;
 		public ushort numFrameBuffers;
@@ -2091,6 +2103,22 @@ public static partial class bgfx
 		public long rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public int transientVbMaxUsed;
+		public int transientIbMaxUsed;
+		public int dynamicVbFree;
+		public int dynamicVbLargestFree;
+		public int dynamicVbFreeBlocks;
+		public int dynamicIbFree;
+		public int dynamicIbLargestFree;
+		public int dynamicIbFreeBlocks;
+		public int transformsUsed;
+		public int transformsMaxUsed;
+		public int rectsUsed;
+		public int rectsMaxUsed;
+		public int uniformBufferUsed;
+		public int uniformBufferMaxUsed;
+		public int cmdBufferUsed;
+		public int cmdBufferMaxUsed;
 		public fixed uint numPrims[5];
 		public long gpuMemoryMax;
 		public long gpuMemoryUsed;
@@ -2116,6 +2144,8 @@ public static partial class bgfx
 	{
 	}
 	
+	public struct DrawBundleHandle{ public ushort idx; }
+	
 	public struct DynamicIndexBufferHandle{ public ushort idx; }
 	
 	public struct DynamicVertexBufferHandle{ public ushort idx; }
@@ -2134,6 +2164,10 @@ public static partial class bgfx
 	
 	public struct TextureHandle{ public ushort idx; }
 	
+	public struct TransformBufferHandle{ public ushort idx; }
+	
+	public struct UniformBlockHandle{ public ushort idx; }
+	
 	public struct UniformHandle{ public ushort idx; }
 	
 	public struct VertexBufferHandle{ public ushort idx; }
@@ -2874,6 +2908,33 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_create_texture", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe TextureHandle create_texture(Memory* _mem, ulong _flags, byte _skip, TextureInfo* _info);
 	
+	/// <summary>
+	/// Create texture from memory buffer asynchronously. Texture data is parsed
+	/// and validated on worker thread, and until texture is ready it's bound as
+	/// 1x1 placeholder texture.
+	/// Render target flags are not supported. Until texture is ready it can't be
+	/// used as frame buffer attachment, and blits to or from it are ignored. Once
+	/// ready, texture can be updated like texture created with `createTexture`.
+	/// </summary>
+	///
+	/// <param name="_mem">DDS, KTX or PVR texture binary data.</param>
+	/// <param name="_flags">Texture creation (see `BGFX_TEXTURE_*`.), and sampler (see `BGFX_SAMPLER_*`) flags. Default texture sampling mode is linear, and wrap mode is repeat. - `BGFX_SAMPLER_[U/V/W]_[MIRROR/CLAMP]` - Mirror or clamp to edge wrap   mode. - `BGFX_SAMPLER_[MIN/MAG/MIP]_[POINT/ANISOTROPIC]` - Point or anisotropic   sampling.</param>
+	/// <param name="_skip">Skip top level mips when parsing texture.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_texture_async", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe TextureHandle create_texture_async(Memory* _mem, ulong _flags, byte _skip);
+	
+	/// <summary>
+	/// Returns true when texture created with `bgfx::createTextureAsync` is
+	/// loaded, or when texture was created synchronously. Returns false while
+	/// texture is loading, or if texture data failed to parse.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_is_texture_ready", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe bool is_texture_ready(TextureHandle _handle);
+	
 	/// <summary>
 	/// Create 2D texture.
 	/// </summary>
@@ -3175,6 +3236,28 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_uniform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_uniform(UniformHandle _handle);
 	
+	/// <summary>
+	/// Create uniform block, a packed layout of uniforms which are set
+	/// together with single call.
+	/// @remarks
+	///   Uniform block holds reference to its uniforms until it's destroyed.
+	/// </summary>
+	///
+	/// <param name="_uniforms">Uniforms in block. Uniform values are packed in order, without padding, each with number of elements passed on uniform creation. Sampler uniforms can't be part of uniform block.</param>
+	/// <param name="_num">Number of uniforms in block.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe UniformBlockHandle create_uniform_block(UniformHandle* _uniforms, ushort _num);
+	
+	/// <summary>
+	/// Destroy uniform block.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to uniform block object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_uniform_block(UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Create occlusion query.
 	/// </summary>
@@ -3201,6 +3284,57 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_occlusion_query", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create draw bundle.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe DrawBundleHandle create_draw_bundle();
+	
+	/// <summary>
+	/// Destroy draw bundle.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw bundle object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_draw_bundle(DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// Create persistent transform buffer. Matrices in transform buffer are
+	/// kept between frames, and are updated only when they change, instead
+	/// of being copied to matrix cache on every draw call.
+	/// </summary>
+	///
+	/// <param name="_num">Number of matrices. Matrices are initialized to identity.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_transform_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe TransformBufferHandle create_transform_buffer(ushort _num);
+	
+	/// <summary>
+	/// Update persistent transform buffer.
+	/// @remarks
+	///   Update takes effect at `bgfx::frame`, all draw calls submitted in the
+	///   frame use the last value.
+	/// </summary>
+	///
+	/// <param name="_handle">Transform buffer handle.</param>
+	/// <param name="_start">Index of first matrix to update.</param>
+	/// <param name="_mtx">Pointer to first matrix in array.</param>
+	/// <param name="_num">Number of matrices in array.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_update_transform_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void update_transform_buffer(TransformBufferHandle _handle, ushort _start, void* _mtx, ushort _num);
+	
+	/// <summary>
+	/// Destroy persistent transform buffer.
+	/// </summary>
+	///
+	/// <param name="_handle">Transform buffer handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_transform_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_transform_buffer(TransformBufferHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3360,7 +3494,26 @@ public static partial class bgfx
 	public static extern unsafe void set_view_order(ushort _id, ushort _num, ushort* _order);
 	
 	/// <summary>
-	/// Begin submitting draw calls from thread.
+	/// Set uniform value for all draw and compute calls in view. Value is
+	/// kept until it's changed, or view is reset, and it's applied once when
+	/// view starts rendering, instead of being stored with every draw call.
+	/// @remarks
+	///   Uniform set with `setUniform` for draw call stays in effect for the
+	///   rest of the view, so the same uniform shouldn't be set both ways in
+	///   one view.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Uniform.</param>
+	/// <param name="_value">Pointer to uniform data. Passing `NULL` will remove uniform from view.</param>
+	/// <param name="_num">Number of elements. Passing `UINT16_MAX` will use the _num passed on uniform creation.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_view_uniform", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void set_view_uniform(ushort _id, UniformHandle _handle, void* _value, ushort _num);
+	
+	/// <summary>
+	/// Begin submitting draw calls from thread. Thread that ends its encoder
+	/// and begins again during the same frame gets the same encoder back.
 	/// </summary>
 	///
 	/// <param name="_forThread">Explicitly request an encoder for a worker thread.</param>
@@ -3417,6 +3570,17 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_set_condition", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_set_condition(Encoder* _this, OcclusionQueryHandle _handle, bool _visible);
 	
+	/// <summary>
+	/// Set material id for draw primitive. Draw calls with the same
+	/// program are grouped by material id when sorted, so draws sharing
+	/// textures and other bindings are submitted next to each other.
+	/// </summary>
+	///
+	/// <param name="_material">Material id. Only lower bits are used, 8 bits by default.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_set_material", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_set_material(Encoder* _this, ushort _material);
+	
 	/// <summary>
 	/// Set stencil test state.
 	/// </summary>
@@ -3463,6 +3627,19 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_set_transform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint encoder_set_transform(Encoder* _this, void* _mtx, ushort _num);
 	
+	/// <summary>
+	/// Set model matrices for draw primitive from palette multiplied by parent
+	/// matrix. Each matrix in cache is `_mtx[ii] * _parent`, computed directly
+	/// into internal matrix cache.
+	/// </summary>
+	///
+	/// <param name="_mtx">Pointer to first matrix in palette.</param>
+	/// <param name="_num">Number of matrices in palette.</param>
+	/// <param name="_parent">Pointer to parent matrix.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_set_transform_palette", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint encoder_set_transform_palette(Encoder* _this, void* _mtx, ushort _num, void* _parent);
+	
 	/// <summary>
 	///  Set model matrix from matrix cache for draw primitive.
 	/// </summary>
@@ -3473,6 +3650,21 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_set_transform_cached", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_set_transform_cached(Encoder* _this, uint _cache, ushort _num);
 	
+	/// <summary>
+	/// Set model matrix from persistent transform buffer for draw primitive.
+	/// Transform buffer can't be used while recording draw bundle.
+	/// Draw uses matrices as they are at `bgfx::frame`, updates made later in the
+	/// same frame apply to draws submitted before them. Matrices of transform buffer
+	/// created in the same frame are copied at the call instead.
+	/// </summary>
+	///
+	/// <param name="_handle">Transform buffer.</param>
+	/// <param name="_start">Index of first matrix in transform buffer.</param>
+	/// <param name="_num">Number of matrices from transform buffer.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_set_transform_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_set_transform_buffer(Encoder* _this, TransformBufferHandle _handle, ushort _start, ushort _num);
+	
 	/// <summary>
 	/// Reserve matrices in internal matrix cache.
 	/// @attention Pointer returned can be modifed until `bgfx::frame` is called.
@@ -3495,6 +3687,16 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_set_uniform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_set_uniform(Encoder* _this, UniformHandle _handle, void* _value, ushort _num);
 	
+	/// <summary>
+	/// Set all uniforms of uniform block for draw primitive.
+	/// </summary>
+	///
+	/// <param name="_handle">Uniform block.</param>
+	/// <param name="_data">Pointer to packed uniform data, laid out as described on uniform block creation.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_set_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_set_uniform_block(Encoder* _this, UniformBlockHandle _handle, void* _data);
+	
 	/// <summary>
 	/// Set index buffer for draw primitive.
 	/// </summary>
@@ -3685,6 +3887,59 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_indirect", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_submit_indirect(Encoder* _this, ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, ushort _start, ushort _num, uint _depth, bool _preserveState);
 	
+	/// <summary>
+	/// Submit batch of primitives sharing program, buffers and state for
+	/// rendering. Equivalent to calling `setTransform`, `setIndexBuffer`
+	/// and `submit` with `_preserveState` for each item, but all items are
+	/// reserved and written in one pass.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_num">Number of items in batch.</param>
+	/// <param name="_mtx">Pointer to `_num` transform matrices, one per item. When `NULL` currently set transform is used for all items.</param>
+	/// <param name="_startIndex">Per item first index, relative to first index set with `setIndexBuffer`. When `NULL` it's 0 for all items.</param>
+	/// <param name="_numIndices">Per item number of indices. When `NULL` currently set number of indices is used for all items.</param>
+	/// <param name="_depth">Per item depth for sorting. When `NULL` it's 0 for all items.</param>
+	/// <param name="_preserveState">Preserve internal draw state for next draw call submit.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_batch", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_batch(Encoder* _this, ushort _id, ProgramHandle _program, ushort _num, void* _mtx, uint* _startIndex, uint* _numIndices, uint* _depth, bool _preserveState);
+	
+	/// <summary>
+	/// Begin recording draw bundle. While recording, draw calls submitted
+	/// to encoder are captured into draw bundle instead of the frame.
+	/// Draw bundle is retained across frames, so it must not reference
+	/// transient buffers. Occlusion queries, compute dispatches, and
+	/// blits can't be recorded. Dynamic buffers are resolved again each
+	/// time bundle is submitted, and draw calls using resources destroyed
+	/// after recording are dropped.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle. Previous contents of draw bundle are discarded.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_begin_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_begin_draw_bundle(Encoder* _this, DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// End recording draw bundle.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_end_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_end_draw_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// Submit recorded draw bundle for rendering.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw bundle handle.</param>
+	/// <param name="_mtx">Pointer to transform matrices. When `NULL` recorded transforms are used.</param>
+	/// <param name="_num">Number of matrices in array. When 1, recorded transforms are multiplied by it. Otherwise it must match number of draw calls in bundle, and each draw call uses its own transform.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_draw_bundle(Encoder* _this, ushort _id, DrawBundleHandle _handle, void* _mtx, ushort _num);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -3823,6 +4078,65 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_request_screen_shot", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void request_screen_shot(FrameBufferHandle _handle, [MarshalAs(UnmanagedType.LPStr)] string _filePath);
 	
+	/// <summary>
+	/// Start capturing submitted frames into frame trace file.
+	/// @remarks
+	///   Resources created before trace is started are stored only when library
+	///   is built with `BGFX_CONFIG_FRAME_TRACE`.
+	/// </summary>
+	///
+	/// <param name="_filePath">Frame trace file path.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_start_frame_trace", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool start_frame_trace([MarshalAs(UnmanagedType.LPStr)] string _filePath);
+	
+	/// <summary>
+	/// Stop capturing frames into frame trace file.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_stop_frame_trace", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void stop_frame_trace();
+	
+	/// <summary>
+	/// Open frame trace file for replay.
+	/// </summary>
+	///
+	/// <param name="_filePath">Frame trace file path.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_open_frame_trace", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint open_frame_trace([MarshalAs(UnmanagedType.LPStr)] string _filePath);
+	
+	/// <summary>
+	/// Replay next frame from frame trace into current frame. Nothing else
+	/// should be submitted in the same frame.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_replay_frame_trace", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool replay_frame_trace();
+	
+	/// <summary>
+	/// Close frame trace file, and destroy resources created by replay.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_close_frame_trace", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void close_frame_trace();
+	
+	/// <summary>
+	/// Save events recorded by built-in profiler into Chrome trace event
+	/// format JSON file.
+	/// @remarks
+	///   Events are recorded only while `BGFX_DEBUG_PROFILER` debug flag is set,
+	///   and when library is built with `BGFX_CONFIG_PROFILER`.
+	/// </summary>
+	///
+	/// <param name="_filePath">Profiler trace file path.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_save_profiler_trace", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool save_profiler_trace([MarshalAs(UnmanagedType.LPStr)] string _filePath);
+	
 	/// <summary>
 	/// Render frame.
 	/// @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -3933,6 +4247,17 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_set_condition", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void set_condition(OcclusionQueryHandle _handle, bool _visible);
 	
+	/// <summary>
+	/// Set material id for draw primitive. Draw calls with the same
+	/// program are grouped by material id when sorted, so draws sharing
+	/// textures and other bindings are submitted next to each other.
+	/// </summary>
+	///
+	/// <param name="_material">Material id. Only lower bits are used, 8 bits by default.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_material", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void set_material(ushort _material);
+	
 	/// <summary>
 	/// Set stencil test state.
 	/// </summary>
@@ -3979,6 +4304,19 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_set_transform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint set_transform(void* _mtx, ushort _num);
 	
+	/// <summary>
+	/// Set model matrices for draw primitive from palette multiplied by parent
+	/// matrix. Each matrix in cache is `_mtx[ii] * _parent`, computed directly
+	/// into internal matrix cache.
+	/// </summary>
+	///
+	/// <param name="_mtx">Pointer to first matrix in palette.</param>
+	/// <param name="_num">Number of matrices in palette.</param>
+	/// <param name="_parent">Pointer to parent matrix.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_transform_palette", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint set_transform_palette(void* _mtx, ushort _num, void* _parent);
+	
 	/// <summary>
 	///  Set model matrix from matrix cache for draw primitive.
 	/// </summary>
@@ -3989,6 +4327,21 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_set_transform_cached", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void set_transform_cached(uint _cache, ushort _num);
 	
+	/// <summary>
+	/// Set model matrix from persistent transform buffer for draw primitive.
+	/// Transform buffer can't be used while recording draw bundle.
+	/// Draw uses matrices as they are at `bgfx::frame`, updates made later in the
+	/// same frame apply to draws submitted before them. Matrices of transform buffer
+	/// created in the same frame are copied at the call instead.
+	/// </summary>
+	///
+	/// <param name="_handle">Transform buffer.</param>
+	/// <param name="_start">Index of first matrix in transform buffer.</param>
+	/// <param name="_num">Number of matrices from transform buffer.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_transform_buffer", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void set_transform_buffer(TransformBufferHandle _handle, ushort _start, ushort _num);
+	
 	/// <summary>
 	/// Reserve matrices in internal matrix cache.
 	/// @attention Pointer returned can be modifed until `bgfx::frame` is called.
@@ -4011,6 +4364,16 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_set_uniform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void set_uniform(UniformHandle _handle, void* _value, ushort _num);
 	
+	/// <summary>
+	/// Set all uniforms of uniform block for draw primitive.
+	/// </summary>
+	///
+	/// <param name="_handle">Uniform block.</param>
+	/// <param name="_data">Pointer to packed uniform data, laid out as described on uniform block creation.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void set_uniform_block(UniformBlockHandle _handle, void* _data);
+	
 	/// <summary>
 	/// Set index buffer for draw primitive.
 	/// </summary>
@@ -4198,6 +4561,59 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_submit_indirect", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void submit_indirect(ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, ushort _start, ushort _num, uint _depth, bool _preserveState);
 	
+	/// <summary>
+	/// Submit batch of primitives sharing program, buffers and state for
+	/// rendering. Equivalent to calling `setTransform`, `setIndexBuffer`
+	/// and `submit` with `_preserveState` for each item, but all items are
+	/// reserved and written in one pass.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_program">Program.</param>
+	/// <param name="_num">Number of items in batch.</param>
+	/// <param name="_mtx">Pointer to `_num` transform matrices, one per item. When `NULL` currently set transform is used for all items.</param>
+	/// <param name="_startIndex">Per item first index, relative to first index set with `setIndexBuffer`. When `NULL` it's 0 for all items.</param>
+	/// <param name="_numIndices">Per item number of indices. When `NULL` currently set number of indices is used for all items.</param>
+	/// <param name="_depth">Per item depth for sorting. When `NULL` it's 0 for all items.</param>
+	/// <param name="_preserveState">Preserve internal draw state for next draw call submit.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_batch", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_batch(ushort _id, ProgramHandle _program, ushort _num, void* _mtx, uint* _startIndex, uint* _numIndices, uint* _depth, bool _preserveState);
+	
+	/// <summary>
+	/// Begin recording draw bundle. While recording, draw calls submitted
+	/// to encoder are captured into draw bundle instead of the frame.
+	/// Draw bundle is retained across frames, so it must not reference
+	/// transient buffers. Occlusion queries, compute dispatches, and
+	/// blits can't be recorded. Dynamic buffers are resolved again each
+	/// time bundle is submitted, and draw calls using resources destroyed
+	/// after recording are dropped.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle. Previous contents of draw bundle are discarded.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_begin_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void begin_draw_bundle(DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// End recording draw bundle.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_end_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void end_draw_bundle();
+	
+	/// <summary>
+	/// Submit recorded draw bundle for rendering.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Draw bundle handle.</param>
+	/// <param name="_mtx">Pointer to transform matrices. When `NULL` recorded transforms are used.</param>
+	/// <param name="_num">Number of matrices in array. When 1, recorded transforms are multiplied by it. Otherwise it must match number of draw calls in bundle, and each draw call uses its own transform.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_draw_bundle(ushort _id, DrawBundleHandle _handle, void* _mtx, ushort _num);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -392,6 +392,7 @@ namespace bgfx
 
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
+	BGFX_HANDLE(DrawBundleHandle)
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
 	BGFX_HANDLE(FrameBufferHandle)
@@ -401,6 +402,8 @@ namespace bgfx
 	BGFX_HANDLE(ProgramHandle)
 	BGFX_HANDLE(ShaderHandle)
 	BGFX_HANDLE(TextureHandle)
+	BGFX_HANDLE(TransformBufferHandle)
+	BGFX_HANDLE(UniformBlockHandle)
 	BGFX_HANDLE(UniformHandle)
 	BGFX_HANDLE(VertexBufferHandle)
 	BGFX_HANDLE(VertexLayoutHandle)
@@ -661,6 +664,11 @@ namespace bgfx
 		bool debug;   //!< Enable device for debuging.
 		bool profile; //!< Enable device for profiling.
 
+		/// Merge adjacent compatible draw calls with contiguous index ranges
+		/// after sorting. Number of merged draw calls is reported in
+		/// `Stats::numDrawsMerged`.
+		bool mergeDraws;
+
 		/// Platform data.
 		PlatformData platformData;
 
@@ -672,6 +680,10 @@ namespace bgfx
 			uint16_t maxEncoders;     //!< Maximum number of encoder threads.
 			uint32_t transientVbSize; //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize; //!< Maximum transient index buffer size.
+			uint32_t maxDrawCalls;    //!< Maximum number of draw calls per frame.
+			uint32_t maxTransforms;   //!< Maximum number of transform matrices per frame, not including
+			                          //!  persistent transform buffers.
+			uint16_t numFrames;       //!< Number of submitted frames in flight (2-4, multithreaded only).
 		};
 
 		Limits limits;
@@ -765,6 +777,8 @@ namespace bgfx
 			uint32_t maxEncoders;             //!< Maximum number of encoder threads.
 			uint32_t transientVbSize;         //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize;         //!< Maximum transient index buffer size.
+			uint32_t maxTransforms;           //!< Maximum number of transform matrices per frame, not
+			                                  //!  including persistent transform buffers.
 		};
 
 		Limits limits;
@@ -921,8 +935,13 @@ namespace bgfx
 	///
 	struct EncoderStats
 	{
-		int64_t cpuTimeBegin; //!< Encoder thread CPU submit begin time.
-		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.
+		int64_t  cpuTimeBegin;      //!< Encoder thread CPU submit begin time.
+		int64_t  cpuTimeEnd;        //!< Encoder thread CPU submit end time.
+		uint32_t numSubmitted;      //!< Number of draw and compute calls submitted.
+		uint32_t numDropped;        //!< Number of draw and compute calls dropped, because
+		                            //!  `Init::limits.maxDrawCalls` is reached, or draw
+		                            //!  call didn't have any vertices or indices set.
+		uint32_t uniformBufferUsed; //!< Amount of uniform data written.
 	};
 
 	/// Renderer statistics data.
@@ -945,11 +964,18 @@ namespace bgfx
 		int64_t waitRender;                 //!< Time spent waiting for render backend thread to finish issuing
 		                                    //!  draw commands to underlying graphics API.
 		int64_t waitSubmit;                 //!< Time spent waiting for submit thread to advance to next frame.
+		int64_t cpuTimeSort;                //!< CPU time spent sorting draw calls, sum of time encoders
+		                                    //!  spent sorting and render thread time merging their output.
 
 		uint32_t numDraw;                   //!< Number of draw calls submitted.
 		uint32_t numCompute;                //!< Number of compute calls submitted.
 		uint32_t numBlit;                   //!< Number of blit calls submitted.
 		uint32_t maxGpuLatency;             //!< GPU driver latency.
+		uint32_t numDrawsMerged;            //!< Number of draw calls merged into previous draw call
+		                                    //!  after sorting.
+		uint32_t numDropped;                //!< Number of draw and compute calls dropped by all encoders.
+		uint32_t numUniformsSkipped;        //!< Number of uniform updates not passed to renderer, because
+		                                    //!  uniform value didn't change.
 
 		uint16_t numDynamicIndexBuffers;    //!< Number of used dynamic index buffers.
 		uint16_t numDynamicVertexBuffers;   //!< Number of used dynamic vertex buffers.
@@ -967,6 +993,27 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int32_t transientVbMaxUsed;         //!< Maximum amount of transient vertex buffer used in a frame.
+		int32_t transientIbMaxUsed;         //!< Maximum amount of transient index buffer used in a frame.
+		int32_t dynamicVbFree;              //!< Free space in dynamic vertex buffer pools.
+		int32_t dynamicVbLargestFree;       //!< Largest free block in dynamic vertex buffer pools.
+		int32_t dynamicVbFreeBlocks;        //!< Number of free blocks in dynamic vertex buffer pools.
+		int32_t dynamicIbFree;              //!< Free space in dynamic index buffer pools.
+		int32_t dynamicIbLargestFree;       //!< Largest free block in dynamic index buffer pools.
+		int32_t dynamicIbFreeBlocks;        //!< Number of free blocks in dynamic index buffer pools.
+		int32_t transformsUsed;             //!< Number of transform matrices used, not including persistent
+		                                    //!  transform buffers.
+		int32_t transformsMaxUsed;          //!< Maximum number of transform matrices used in a frame.
+		                                    //!  Limit is `Init::limits.maxTransforms`.
+		int32_t rectsUsed;                  //!< Number of scissor rects used.
+		int32_t rectsMaxUsed;               //!< Maximum number of scissor rects used in a frame.
+		                                    //!  Limit is `BGFX_CONFIG_MAX_RECT_CACHE`.
+		int32_t uniformBufferUsed;          //!< Amount of uniform data written by all encoders.
+		int32_t uniformBufferMaxUsed;       //!< Maximum amount of uniform data written by single
+		                                    //!  encoder in a frame.
+		int32_t cmdBufferUsed;              //!< Amount of command buffer used by resource commands.
+		int32_t cmdBufferMaxUsed;           //!< Maximum amount of command buffer used by resource
+		                                    //!  commands in a frame.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
@@ -1045,6 +1092,17 @@ namespace bgfx
 			, bool _visible
 			);
 
+		/// Set material id for draw primitive. Draw calls with the same
+		/// program are grouped by material id when sorted, so draws sharing
+		/// textures and other bindings are submitted next to each other.
+		///
+		/// @param[in] _material Material id. Only lower bits are used, 8 bits
+		///   by default.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_set_material`.
+		///
+		void setMaterial(uint16_t _material);
+
 		/// Set stencil test state.
 		///
 		/// @param[in] _fstencil Front stencil state.
@@ -1100,6 +1158,24 @@ namespace bgfx
 			, uint16_t _num = 1
 			);
 
+		/// Set model matrices for draw primitive from palette multiplied by parent
+		/// matrix. Each matrix in cache is `_mtx[ii] * _parent`, computed directly
+		/// into internal matrix cache.
+		///
+		/// @param[in] _mtx Pointer to first matrix in palette.
+		/// @param[in] _num Number of matrices in palette.
+		/// @param[in] _parent Pointer to parent matrix.
+		/// @returns Index into matrix cache in case the same model matrices have
+		///   to be used for other draw primitive call.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_set_transform_palette`.
+		///
+		uint32_t setTransformPalette(
+			  const void* _mtx
+			, uint16_t _num
+			, const void* _parent
+			);
+
 		/// Reserve `_num` matrices in internal matrix cache.
 		///
 		/// @param[in] _transform Pointer to `Transform` structure.
@@ -1126,6 +1202,24 @@ namespace bgfx
 			, uint16_t _num = 1
 			);
 
+		/// Set model matrix from persistent transform buffer for draw primitive.
+		/// Transform buffer can't be used while recording draw bundle.
+		/// Draw uses matrices as they are at `bgfx::frame`, updates made later in the
+		/// same frame apply to draws submitted before them. Matrices of transform buffer
+		/// created in the same frame are copied at the call instead.
+		///
+		/// @param[in] _handle Transform buffer.
+		/// @param[in] _start Index of first matrix in transform buffer.
+		/// @param[in] _num Number of matrices from transform buffer.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_set_transform_buffer`.
+		///
+		void setTransform(
+			  TransformBufferHandle _handle
+			, uint16_t _start
+			, uint16_t _num = 1
+			);
+
 		/// Set shader uniform parameter for draw primitive.
 		///
 		/// @param[in] _handle Uniform.
@@ -1141,6 +1235,19 @@ namespace bgfx
 			, uint16_t _num = 1
 			);
 
+		/// Set all uniforms of uniform block for draw primitive.
+		///
+		/// @param[in] _handle Uniform block.
+		/// @param[in] _data Pointer to packed uniform data, laid out as
+		///   described on uniform block creation.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_set_uniform_block`.
+		///
+		void setUniformBlock(
+			  UniformBlockHandle _handle
+			, const void* _data
+			);
+
 		/// Set index buffer for draw primitive.
 		///
 		/// @param[in] _handle Index buffer.
@@ -1460,6 +1567,80 @@ namespace bgfx
 			, bool _preserveState = false
 			);
 
+		/// Submit batch of primitives sharing program, buffers and state for
+		/// rendering. Equivalent to calling `setTransform`, `setIndexBuffer`
+		/// and `submit` with `_preserveState` for each item, but all items are
+		/// reserved and written in one pass.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _program Program.
+		/// @param[in] _num Number of items in batch.
+		/// @param[in] _mtx Pointer to `_num` transform matrices, one per item.
+		///   When `NULL` currently set transform is used for all items.
+		/// @param[in] _startIndex Per item first index, relative to first index
+		///   set with `setIndexBuffer`. When `NULL` it's 0 for all items.
+		/// @param[in] _numIndices Per item number of indices. When `NULL`
+		///   currently set number of indices is used for all items.
+		/// @param[in] _depth Per item depth for sorting. When `NULL` it's 0 for
+		///   all items.
+		/// @param[in] _preserveState Preserve internal draw state for next draw
+		///   call submit.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_submit_batch`.
+		///
+		void submitBatch(
+			  ViewId _id
+			, ProgramHandle _program
+			, uint16_t _num
+			, const void* _mtx
+			, const uint32_t* _startIndex = NULL
+			, const uint32_t* _numIndices = NULL
+			, const uint32_t* _depth = NULL
+			, bool _preserveState = false
+			);
+
+		/// Begin recording draw bundle. While recording, draw calls submitted
+		/// to encoder are captured into draw bundle instead of the frame.
+		///
+		/// @param[in] _handle Draw bundle handle. Previous contents of draw
+		///   bundle are discarded.
+		///
+		/// @remarks
+		///   Draw bundle is retained across frames, so it must not reference
+		///   transient buffers. Occlusion queries, compute dispatches, and
+		///   blits can't be recorded. Dynamic buffers are resolved again each
+		///   time bundle is submitted, and draw calls using resources destroyed
+		///   after recording are dropped.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_begin_draw_bundle`.
+		///
+		void beginDrawBundle(DrawBundleHandle _handle);
+
+		/// End recording draw bundle.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_end_draw_bundle`.
+		///
+		void endDrawBundle();
+
+		/// Submit recorded draw bundle for rendering.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _handle Draw bundle handle.
+		/// @param[in] _mtx Pointer to transform matrices. When `NULL` recorded
+		///   transforms are used.
+		/// @param[in] _num Number of matrices in array. When 1, recorded
+		///   transforms are multiplied by it. Otherwise it must match number of
+		///   draw calls in bundle, and each draw call uses its own transform.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_submit_draw_bundle`.
+		///
+		void submit(
+			  ViewId _id
+			, DrawBundleHandle _handle
+			, const void* _mtx = NULL
+			, uint16_t _num = 0
+			);
+
 		/// Set compute index buffer.
 		///
 		/// @param[in] _stage Compute stage.
@@ -1946,7 +2127,8 @@ namespace bgfx
 		, TextureFormat::Enum _format = TextureFormat::Count
 		);
 
-	/// Begin submitting draw calls from thread.
+	/// Begin submitting draw calls from thread. Thread that ends its encoder
+	/// and begins again during the same frame gets the same encoder back.
 	///
 	/// @param[in] _forThread Explicitly request an encoder for a worker thread.
 	///
@@ -2639,6 +2821,43 @@ namespace bgfx
 		, TextureInfo* _info = NULL
 		);
 
+	/// Create texture from memory buffer asynchronously. Texture data is parsed
+	/// and validated on worker thread, and until texture is ready it's bound as
+	/// 1x1 placeholder texture.
+	/// Render target flags are not supported. Until texture is ready it can't be
+	/// used as frame buffer attachment, and blits to or from it are ignored. Once
+	/// ready, texture can be updated like texture created with `createTexture`.
+	///
+	/// @param[in] _mem DDS, KTX or PVR texture data.
+	/// @param[in] _flags Texture creation (see `BGFX_TEXTURE_*`.), and sampler (see `BGFX_SAMPLER_*`)
+	///   flags. Default texture sampling mode is linear, and wrap mode is repeat.
+	///   - `BGFX_SAMPLER_[U/V/W]_[MIRROR/CLAMP]` - Mirror or clamp to edge wrap
+	///     mode.
+	///   - `BGFX_SAMPLER_[MIN/MAG/MIP]_[POINT/ANISOTROPIC]` - Point or anisotropic
+	///     sampling.
+	///
+	/// @param[in] _skip Skip top level mips when parsing texture.
+	/// @returns Texture handle.
+	///
+	/// @attention C99 equivalent is `bgfx_create_texture_async`.
+	///
+	TextureHandle createTextureAsync(
+		  const Memory* _mem
+		, uint64_t _flags = BGFX_TEXTURE_NONE|BGFX_SAMPLER_NONE
+		, uint8_t _skip = 0
+		);
+
+	/// Returns true when texture created with `bgfx::createTextureAsync` is
+	/// loaded, or when texture was created synchronously. Returns false while
+	/// texture is loading, or if texture data failed to parse.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @returns True if texture is ready.
+	///
+	/// @attention C99 equivalent is `bgfx_is_texture_ready`.
+	///
+	bool isTextureReady(TextureHandle _handle);
+
 	/// Create 2D texture.
 	///
 	/// @param[in] _width Width.
@@ -3120,6 +3339,34 @@ namespace bgfx
 	///
 	void destroy(UniformHandle _handle);
 
+	/// Create uniform block, a packed layout of uniforms which are set
+	///   together with single call.
+	///
+	/// @param[in] _uniforms Uniforms in block. Uniform values are packed in
+	///   order, without padding, each with number of elements passed on
+	///   uniform creation. Sampler uniforms can't be part of uniform block.
+	/// @param[in] _num Number of uniforms in block.
+	///
+	/// @returns Handle to uniform block object.
+	///
+	/// @remarks
+	///   Uniform block holds reference to its uniforms until it's destroyed.
+	///
+	/// @attention C99 equivalent is `bgfx_create_uniform_block`.
+	///
+	UniformBlockHandle createUniformBlock(
+		  const UniformHandle* _uniforms
+		, uint16_t _num
+		);
+
+	/// Destroy uniform block.
+	///
+	/// @param[in] _handle Handle to uniform block object.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_uniform_block`.
+	///
+	void destroy(UniformBlockHandle _handle);
+
 	/// Create occlusion query.
 	///
 	/// @returns Handle to occlusion query object.
@@ -3150,6 +3397,63 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Create draw bundle.
+	///
+	/// @returns Handle to draw bundle object.
+	///
+	/// @attention C99 equivalent is `bgfx_create_draw_bundle`.
+	///
+	DrawBundleHandle createDrawBundle();
+
+	/// Destroy draw bundle.
+	///
+	/// @param[in] _handle Handle to draw bundle object.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_draw_bundle`.
+	///
+	void destroy(DrawBundleHandle _handle);
+
+	/// Create persistent transform buffer. Matrices in transform buffer are
+	/// kept between frames, and are updated only when they change, instead
+	/// of being copied to matrix cache on every draw call.
+	///
+	/// @param[in] _num Number of matrices. Matrices are initialized to
+	///   identity.
+	///
+	/// @returns Handle to transform buffer object.
+	///
+	/// @attention C99 equivalent is `bgfx_create_transform_buffer`.
+	///
+	TransformBufferHandle createTransformBuffer(uint16_t _num);
+
+	/// Update persistent transform buffer.
+	///
+	/// @param[in] _handle Transform buffer handle.
+	/// @param[in] _start Index of first matrix to update.
+	/// @param[in] _mtx Pointer to first matrix in array.
+	/// @param[in] _num Number of matrices in array.
+	///
+	/// @remarks
+	///   Update takes effect at `bgfx::frame`, all draw calls submitted in the
+	///   frame use the last value.
+	///
+	/// @attention C99 equivalent is `bgfx_update_transform_buffer`.
+	///
+	void updateTransformBuffer(
+		  TransformBufferHandle _handle
+		, uint16_t _start
+		, const void* _mtx
+		, uint16_t _num = 1
+		);
+
+	/// Destroy persistent transform buffer.
+	///
+	/// @param[in] _handle Transform buffer handle.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_transform_buffer`.
+	///
+	void destroy(TransformBufferHandle _handle);
+
 	/// Set palette color value.
 	///
 	/// @param[in] _index Index into palette.
@@ -3382,6 +3686,31 @@ namespace bgfx
 		, const ViewId* _remap = NULL
 		);
 
+	/// Set uniform value for all draw and compute calls in view. Value is
+	/// kept until it's changed, or view is reset, and it's applied once when
+	/// view starts rendering, instead of being stored with every draw call.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Uniform.
+	/// @param[in] _value Pointer to uniform data. Passing `NULL` will remove
+	///   uniform from view.
+	/// @param[in] _num Number of elements. Passing `UINT16_MAX` will
+	///   use the _num passed on uniform creation.
+	///
+	/// @remarks
+	///   Uniform set with `setUniform` for draw call stays in effect for the
+	///   rest of the view, so the same uniform shouldn't be set both ways in
+	///   one view.
+	///
+	/// @attention C99 equivalent is `bgfx_set_view_uniform`.
+	///
+	void setViewUniform(
+		  ViewId _id
+		, UniformHandle _handle
+		, const void* _value
+		, uint16_t _num = 1
+		);
+
 	/// Reset all view settings to default.
 	///
 	/// @param[in] _id View id.
@@ -3441,6 +3770,17 @@ namespace bgfx
 		, bool _visible
 		);
 
+	/// Set material id for draw primitive. Draw calls with the same
+	/// program are grouped by material id when sorted, so draws sharing
+	/// textures and other bindings are submitted next to each other.
+	///
+	/// @param[in] _material Material id. Only lower bits are used, 8 bits
+	///   by default.
+	///
+	/// @attention C99 equivalent is `bgfx_set_material`.
+	///
+	void setMaterial(uint16_t _material);
+
 	/// Set stencil test state.
 	///
 	/// @param[in] _fstencil Front stencil state.
@@ -3496,6 +3836,24 @@ namespace bgfx
 		, uint16_t _num = 1
 		);
 
+	/// Set model matrices for draw primitive from palette multiplied by parent
+	/// matrix. Each matrix in cache is `_mtx[ii] * _parent`, computed directly
+	/// into internal matrix cache.
+	///
+	/// @param[in] _mtx Pointer to first matrix in palette.
+	/// @param[in] _num Number of matrices in palette.
+	/// @param[in] _parent Pointer to parent matrix.
+	/// @returns Index into matrix cache in case the same model matrices have
+	///   to be used for other draw primitive call.
+	///
+	/// @attention C99 equivalent is `bgfx_set_transform_palette`.
+	///
+	uint32_t setTransformPalette(
+		  const void* _mtx
+		, uint16_t _num
+		, const void* _parent
+		);
+
 	/// Reserve `_num` matrices in internal matrix cache.
 	///
 	/// @param[in] _transform Pointer to `Transform` structure.
@@ -3522,6 +3880,24 @@ namespace bgfx
 		, uint16_t _num = 1
 		);
 
+	/// Set model matrix from persistent transform buffer for draw primitive.
+	/// Transform buffer can't be used while recording draw bundle.
+	/// Draw uses matrices as they are at `bgfx::frame`, updates made later in the
+	/// same frame apply to draws submitted before them. Matrices of transform buffer
+	/// created in the same frame are copied at the call instead.
+	///
+	/// @param[in] _handle Transform buffer.
+	/// @param[in] _start Index of first matrix in transform buffer.
+	/// @param[in] _num Number of matrices from transform buffer.
+	///
+	/// @attention C99 equivalent is `bgfx_set_transform_buffer`.
+	///
+	void setTransform(
+		  TransformBufferHandle _handle
+		, uint16_t _start
+		, uint16_t _num = 1
+		);
+
 	/// Set shader uniform parameter for draw primitive.
 	///
 	/// @param[in] _handle Uniform.
@@ -3537,6 +3913,19 @@ namespace bgfx
 		, uint16_t _num = 1
 		);
 
+	/// Set all uniforms of uniform block for draw primitive.
+	///
+	/// @param[in] _handle Uniform block.
+	/// @param[in] _data Pointer to packed uniform data, laid out as
+	///   described on uniform block creation.
+	///
+	/// @attention C99 equivalent is `bgfx_set_uniform_block`.
+	///
+	void setUniformBlock(
+		  UniformBlockHandle _handle
+		, const void* _data
+		);
+
 	/// Set index buffer for draw primitive.
 	///
 	/// @param[in] _handle Index buffer.
@@ -3855,6 +4244,80 @@ namespace bgfx
 		, bool _preserveState = false
 		);
 
+	/// Submit batch of primitives sharing program, buffers and state for
+	/// rendering. Equivalent to calling `setTransform`, `setIndexBuffer`
+	/// and `submit` with `_preserveState` for each item, but all items are
+	/// reserved and written in one pass.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _program Program.
+	/// @param[in] _num Number of items in batch.
+	/// @param[in] _mtx Pointer to `_num` transform matrices, one per item.
+	///   When `NULL` currently set transform is used for all items.
+	/// @param[in] _startIndex Per item first index, relative to first index
+	///   set with `setIndexBuffer`. When `NULL` it's 0 for all items.
+	/// @param[in] _numIndices Per item number of indices. When `NULL`
+	///   currently set number of indices is used for all items.
+	/// @param[in] _depth Per item depth for sorting. When `NULL` it's 0 for
+	///   all items.
+	/// @param[in] _preserveState Preserve internal draw state for next draw
+	///   call submit.
+	///
+	/// @attention C99 equivalent is `bgfx_submit_batch`.
+	///
+	void submitBatch(
+		  ViewId _id
+		, ProgramHandle _program
+		, uint16_t _num
+		, const void* _mtx
+		, const uint32_t* _startIndex = NULL
+		, const uint32_t* _numIndices = NULL
+		, const uint32_t* _depth = NULL
+		, bool _preserveState = false
+		);
+
+	/// Begin recording draw bundle. While recording, draw calls submitted
+	/// to encoder are captured into draw bundle instead of the frame.
+	///
+	/// @param[in] _handle Draw bundle handle. Previous contents of draw
+	///   bundle are discarded.
+	///
+	/// @remarks
+	///   Draw bundle is retained across frames, so it must not reference
+	///   transient buffers. Occlusion queries, compute dispatches, and
+	///   blits can't be recorded. Dynamic buffers are resolved again each
+	///   time bundle is submitted, and draw calls using resources destroyed
+	///   after recording are dropped.
+	///
+	/// @attention C99 equivalent is `bgfx_begin_draw_bundle`.
+	///
+	void beginDrawBundle(DrawBundleHandle _handle);
+
+	/// End recording draw bundle.
+	///
+	/// @attention C99 equivalent is `bgfx_end_draw_bundle`.
+	///
+	void endDrawBundle();
+
+	/// Submit recorded draw bundle for rendering.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Draw bundle handle.
+	/// @param[in] _mtx Pointer to transform matrices. When `NULL` recorded
+	///   transforms are used.
+	/// @param[in] _num Number of matrices in array. When 1, recorded
+	///   transforms are multiplied by it. Otherwise it must match number of
+	///   draw calls in bundle, and each draw call uses its own transform.
+	///
+	/// @attention C99 equivalent is `bgfx_submit_draw_bundle`.
+	///
+	void submit(
+		  ViewId _id
+		, DrawBundleHandle _handle
+		, const void* _mtx = NULL
+		, uint16_t _num = 0
+		);
+
 	/// Set compute index buffer.
 	///
 	/// @param[in] _stage Compute stage.
@@ -4073,6 +4536,65 @@ namespace bgfx
 		, const char* _filePath
 		);
 
+	/// Start capturing submitted frames into frame trace file.
+	///
+	/// @param[in] _filePath Frame trace file path.
+	/// @returns True if frame trace file is opened.
+	///
+	/// @remarks
+	///   Resources created before trace is started are stored only when library
+	///   is built with `BGFX_CONFIG_FRAME_TRACE`.
+	///
+	/// @attention C99 equivalent is `bgfx_start_frame_trace`.
+	///
+	bool startFrameTrace(const char* _filePath);
+
+	/// Stop capturing frames into frame trace file.
+	///
+	/// @attention C99 equivalent is `bgfx_stop_frame_trace`.
+	///
+	void stopFrameTrace();
+
+	/// Open frame trace file for replay.
+	///
+	/// @param[in] _filePath Frame trace file path.
+	/// @returns Number of frames in frame trace, or 0 if file can't be opened,
+	///   or it was captured by incompatible build.
+	///
+	/// @attention C99 equivalent is `bgfx_open_frame_trace`.
+	///
+	uint32_t openFrameTrace(const char* _filePath);
+
+	/// Replay next frame from frame trace into current frame. Nothing else
+	/// should be submitted in the same frame.
+	///
+	/// @returns False when all frames are replayed. Resources created by replay
+	///   are destroyed then, and next call starts replay from the first frame.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_frame_trace`.
+	///
+	bool replayFrameTrace();
+
+	/// Close frame trace file, and destroy resources created by replay.
+	///
+	/// @attention C99 equivalent is `bgfx_close_frame_trace`.
+	///
+	void closeFrameTrace();
+
+	/// Save events recorded by built-in profiler into Chrome trace event
+	/// format JSON file.
+	///
+	/// @param[in] _filePath Profiler trace file path.
+	/// @returns True if profiler trace file is written.
+	///
+	/// @remarks
+	///   Events are recorded only while `BGFX_DEBUG_PROFILER` debug flag is set,
+	///   and when library is built with `BGFX_CONFIG_PROFILER`.
+	///
+	/// @attention C99 equivalent is `bgfx_save_profiler_trace`.
+	///
+	bool saveProfilerTrace(const char* _filePath);
+
 } // namespace bgfx
 
 #endif // BGFX_H_HEADER_GUARD
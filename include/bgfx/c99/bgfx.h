@@ -438,6 +438,8 @@ typedef struct bgfx_callback_vtbl_s
 
 } bgfx_callback_vtbl_t;
 
+typedef struct bgfx_draw_bundle_handle_s { uint16_t idx; } bgfx_draw_bundle_handle_t;
+
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
@@ -456,6 +458,10 @@ typedef struct bgfx_shader_handle_s { uint16_t idx; } bgfx_shader_handle_t;
 
 typedef struct bgfx_texture_handle_s { uint16_t idx; } bgfx_texture_handle_t;
 
+typedef struct bgfx_transform_buffer_handle_s { uint16_t idx; } bgfx_transform_buffer_handle_t;
+
+typedef struct bgfx_uniform_block_handle_s { uint16_t idx; } bgfx_uniform_block_handle_t;
+
 typedef struct bgfx_uniform_handle_s { uint16_t idx; } bgfx_uniform_handle_t;
 
 typedef struct bgfx_vertex_buffer_handle_s { uint16_t idx; } bgfx_vertex_buffer_handle_t;
@@ -514,6 +520,7 @@ typedef struct bgfx_caps_limits_s
     uint32_t             maxEncoders;        /** Maximum number of encoder threads.       */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint32_t             maxTransforms;      /** Maximum number of transform matrices per frame, not including persistent transform buffers. */
 
 } bgfx_caps_limits_t;
 
@@ -610,6 +617,9 @@ typedef struct bgfx_init_limits_s
     uint16_t             maxEncoders;        /** Maximum number of encoder threads.       */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint32_t             maxDrawCalls;       /** Maximum number of draw calls per frame.  */
+    uint32_t             maxTransforms;      /** Maximum number of transform matrices per frame, not including persistent transform buffers. */
+    uint16_t             numFrames;          /** Number of submitted frames in flight (2-4, multithreaded only). */
 
 } bgfx_init_limits_t;
 
@@ -645,6 +655,13 @@ typedef struct bgfx_init_s
     uint16_t             deviceId;
     bool                 debug;              /** Enable device for debuging.              */
     bool                 profile;            /** Enable device for profiling.             */
+    
+    /**
+     * Merge adjacent compatible draw calls with contiguous index ranges
+     * after sorting. Number of merged draw calls is reported in
+     * `Stats::numDrawsMerged`.
+     */
+    bool                 mergeDraws;
     bgfx_platform_data_t platformData;       /** Platform data.                           */
     bgfx_resolution_t    resolution;         /** Backbuffer resolution and reset parameters. See: `bgfx::Resolution`. */
     bgfx_init_limits_t   limits;
@@ -795,6 +812,9 @@ typedef struct bgfx_encoder_stats_s
 {
     int64_t              cpuTimeBegin;       /** Encoder thread CPU submit begin time.    */
     int64_t              cpuTimeEnd;         /** Encoder thread CPU submit end time.      */
+    uint32_t             numSubmitted;       /** Number of draw and compute calls submitted. */
+    uint32_t             numDropped;         /** Number of draw and compute calls dropped, because `Init::limits.maxDrawCalls` is reached, or draw call didn't have any vertices or indices set. */
+    uint32_t             uniformBufferUsed;  /** Amount of uniform data written.          */
 
 } bgfx_encoder_stats_t;
 
@@ -815,10 +835,14 @@ typedef struct bgfx_stats_s
     int64_t              gpuTimerFreq;       /** GPU timer frequency.                     */
     int64_t              waitRender;         /** Time spent waiting for render backend thread to finish issuing draw commands to underlying graphics API. */
     int64_t              waitSubmit;         /** Time spent waiting for submit thread to advance to next frame. */
+    int64_t              cpuTimeSort;        /** CPU time spent sorting draw calls, sum of time encoders spent sorting and render thread time merging their output. */
     uint32_t             numDraw;            /** Number of draw calls submitted.          */
     uint32_t             numCompute;         /** Number of compute calls submitted.       */
     uint32_t             numBlit;            /** Number of blit calls submitted.          */
     uint32_t             maxGpuLatency;      /** GPU driver latency.                      */
+    uint32_t             numDrawsMerged;     /** Number of draw calls merged into previous draw call after sorting. */
+    uint32_t             numDropped;         /** Number of draw and compute calls dropped by all encoders. */
+    uint32_t             numUniformsSkipped; /** Number of uniform updates not passed to renderer, because uniform value didn't change. */
     uint16_t             numDynamicIndexBuffers; /** Number of used dynamic index buffers.    */
     uint16_t             numDynamicVertexBuffers; /** Number of used dynamic vertex buffers.   */
     uint16_t             numFrameBuffers;    /** Number of used frame buffers.            */
@@ -834,6 +858,22 @@ typedef struct bgfx_stats_s
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    int32_t              transientVbMaxUsed; /** Maximum amount of transient vertex buffer used in a frame. */
+    int32_t              transientIbMaxUsed; /** Maximum amount of transient index buffer used in a frame. */
+    int32_t              dynamicVbFree;      /** Free space in dynamic vertex buffer pools. */
+    int32_t              dynamicVbLargestFree; /** Largest free block in dynamic vertex buffer pools. */
+    int32_t              dynamicVbFreeBlocks; /** Number of free blocks in dynamic vertex buffer pools. */
+    int32_t              dynamicIbFree;      /** Free space in dynamic index buffer pools. */
+    int32_t              dynamicIbLargestFree; /** Largest free block in dynamic index buffer pools. */
+    int32_t              dynamicIbFreeBlocks; /** Number of free blocks in dynamic index buffer pools. */
+    int32_t              transformsUsed;     /** Number of transform matrices used, not including persistent transform buffers. */
+    int32_t              transformsMaxUsed;  /** Maximum number of transform matrices used in a frame. Limit is `Init::limits.maxTransforms`. */
+    int32_t              rectsUsed;          /** Number of scissor rects used.            */
+    int32_t              rectsMaxUsed;       /** Maximum number of scissor rects used in a frame. Limit is `BGFX_CONFIG_MAX_RECT_CACHE`. */
+    int32_t              uniformBufferUsed;  /** Amount of uniform data written by all encoders. */
+    int32_t              uniformBufferMaxUsed; /** Maximum amount of uniform data written by single encoder in a frame. */
+    int32_t              cmdBufferUsed;      /** Amount of command buffer used by resource commands. */
+    int32_t              cmdBufferMaxUsed;   /** Maximum amount of command buffer used by resource commands in a frame. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
@@ -1706,6 +1746,40 @@ BGFX_C_API void bgfx_calc_texture_size(bgfx_texture_info_t * _info, uint16_t _wi
  */
 BGFX_C_API bgfx_texture_handle_t bgfx_create_texture(const bgfx_memory_t* _mem, uint64_t _flags, uint8_t _skip, bgfx_texture_info_t* _info);
 
+/**
+ * Create texture from memory buffer asynchronously. Texture data is parsed
+ * and validated on worker thread, and until texture is ready it's bound as
+ * 1x1 placeholder texture.
+ * Render target flags are not supported. Until texture is ready it can't be
+ * used as frame buffer attachment, and blits to or from it are ignored. Once
+ * ready, texture can be updated like texture created with `createTexture`.
+ *
+ * @param[in] _mem DDS, KTX or PVR texture binary data.
+ * @param[in] _flags Texture creation (see `BGFX_TEXTURE_*`.), and sampler (see `BGFX_SAMPLER_*`)
+ *  flags. Default texture sampling mode is linear, and wrap mode is repeat.
+ *  - `BGFX_SAMPLER_[U/V/W]_[MIRROR/CLAMP]` - Mirror or clamp to edge wrap
+ *    mode.
+ *  - `BGFX_SAMPLER_[MIN/MAG/MIP]_[POINT/ANISOTROPIC]` - Point or anisotropic
+ *    sampling.
+ * @param[in] _skip Skip top level mips when parsing texture.
+ *
+ * @returns Texture handle.
+ *
+ */
+BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_async(const bgfx_memory_t* _mem, uint64_t _flags, uint8_t _skip);
+
+/**
+ * Returns true when texture created with `bgfx::createTextureAsync` is
+ * loaded, or when texture was created synchronously. Returns false while
+ * texture is loading, or if texture data failed to parse.
+ *
+ * @param[in] _handle Texture handle.
+ *
+ * @returns True if texture is ready.
+ *
+ */
+BGFX_C_API bool bgfx_is_texture_ready(bgfx_texture_handle_t _handle);
+
 /**
  * Create 2D texture.
  *
@@ -2076,6 +2150,30 @@ BGFX_C_API void bgfx_get_uniform_info(bgfx_uniform_handle_t _handle, bgfx_unifor
  */
 BGFX_C_API void bgfx_destroy_uniform(bgfx_uniform_handle_t _handle);
 
+/**
+ * Create uniform block, a packed layout of uniforms which are set
+ * together with single call.
+ * @remarks
+ *   Uniform block holds reference to its uniforms until it's destroyed.
+ *
+ * @param[in] _uniforms Uniforms in block. Uniform values are packed in
+ *  order, without padding, each with number of elements passed on
+ *  uniform creation. Sampler uniforms can't be part of uniform block.
+ * @param[in] _num Number of uniforms in block.
+ *
+ * @returns Handle to uniform block object.
+ *
+ */
+BGFX_C_API bgfx_uniform_block_handle_t bgfx_create_uniform_block(const bgfx_uniform_handle_t* _uniforms, uint16_t _num);
+
+/**
+ * Destroy uniform block.
+ *
+ * @param[in] _handle Handle to uniform block object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_uniform_block(bgfx_uniform_block_handle_t _handle);
+
 /**
  * Create occlusion query.
  *
@@ -2102,6 +2200,55 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Create draw bundle.
+ *
+ */
+BGFX_C_API bgfx_draw_bundle_handle_t bgfx_create_draw_bundle(void);
+
+/**
+ * Destroy draw bundle.
+ *
+ * @param[in] _handle Handle to draw bundle object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * Create persistent transform buffer. Matrices in transform buffer are
+ * kept between frames, and are updated only when they change, instead
+ * of being copied to matrix cache on every draw call.
+ *
+ * @param[in] _num Number of matrices. Matrices are initialized to
+ *  identity.
+ *
+ * @returns Handle to transform buffer object.
+ *
+ */
+BGFX_C_API bgfx_transform_buffer_handle_t bgfx_create_transform_buffer(uint16_t _num);
+
+/**
+ * Update persistent transform buffer.
+ * @remarks
+ *   Update takes effect at `bgfx::frame`, all draw calls submitted in the
+ *   frame use the last value.
+ *
+ * @param[in] _handle Transform buffer handle.
+ * @param[in] _start Index of first matrix to update.
+ * @param[in] _mtx Pointer to first matrix in array.
+ * @param[in] _num Number of matrices in array.
+ *
+ */
+BGFX_C_API void bgfx_update_transform_buffer(bgfx_transform_buffer_handle_t _handle, uint16_t _start, const void* _mtx, uint16_t _num);
+
+/**
+ * Destroy persistent transform buffer.
+ *
+ * @param[in] _handle Transform buffer handle.
+ *
+ */
+BGFX_C_API void bgfx_destroy_transform_buffer(bgfx_transform_buffer_handle_t _handle);
+
 /**
  * Set palette color value.
  *
@@ -2255,7 +2402,27 @@ BGFX_C_API void bgfx_set_view_transform(bgfx_view_id_t _id, const void* _view, c
 BGFX_C_API void bgfx_set_view_order(bgfx_view_id_t _id, uint16_t _num, const bgfx_view_id_t* _order);
 
 /**
- * Begin submitting draw calls from thread.
+ * Set uniform value for all draw and compute calls in view. Value is
+ * kept until it's changed, or view is reset, and it's applied once when
+ * view starts rendering, instead of being stored with every draw call.
+ * @remarks
+ *   Uniform set with `setUniform` for draw call stays in effect for the
+ *   rest of the view, so the same uniform shouldn't be set both ways in
+ *   one view.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Uniform.
+ * @param[in] _value Pointer to uniform data. Passing `NULL` will remove
+ *  uniform from view.
+ * @param[in] _num Number of elements. Passing `UINT16_MAX` will
+ *  use the _num passed on uniform creation.
+ *
+ */
+BGFX_C_API void bgfx_set_view_uniform(bgfx_view_id_t _id, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+
+/**
+ * Begin submitting draw calls from thread. Thread that ends its encoder
+ * and begins again during the same frame gets the same encoder back.
  *
  * @param[in] _forThread Explicitly request an encoder for a worker thread.
  *
@@ -2318,6 +2485,17 @@ BGFX_C_API void bgfx_encoder_set_state(bgfx_encoder_t* _this, uint64_t _state, u
  */
 BGFX_C_API void bgfx_encoder_set_condition(bgfx_encoder_t* _this, bgfx_occlusion_query_handle_t _handle, bool _visible);
 
+/**
+ * Set material id for draw primitive. Draw calls with the same
+ * program are grouped by material id when sorted, so draws sharing
+ * textures and other bindings are submitted next to each other.
+ *
+ * @param[in] _material Material id. Only lower bits are used, 8 bits
+ *  by default.
+ *
+ */
+BGFX_C_API void bgfx_encoder_set_material(bgfx_encoder_t* _this, uint16_t _material);
+
 /**
  * Set stencil test state.
  *
@@ -2366,6 +2544,21 @@ BGFX_C_API void bgfx_encoder_set_scissor_cached(bgfx_encoder_t* _this, uint16_t
  */
 BGFX_C_API uint32_t bgfx_encoder_set_transform(bgfx_encoder_t* _this, const void* _mtx, uint16_t _num);
 
+/**
+ * Set model matrices for draw primitive from palette multiplied by parent
+ * matrix. Each matrix in cache is `_mtx[ii] * _parent`, computed directly
+ * into internal matrix cache.
+ *
+ * @param[in] _mtx Pointer to first matrix in palette.
+ * @param[in] _num Number of matrices in palette.
+ * @param[in] _parent Pointer to parent matrix.
+ *
+ * @returns Index into matrix cache in case the same model matrices have
+ *  to be used for other draw primitive call.
+ *
+ */
+BGFX_C_API uint32_t bgfx_encoder_set_transform_palette(bgfx_encoder_t* _this, const void* _mtx, uint16_t _num, const void* _parent);
+
 /**
  *  Set model matrix from matrix cache for draw primitive.
  *
@@ -2375,6 +2568,20 @@ BGFX_C_API uint32_t bgfx_encoder_set_transform(bgfx_encoder_t* _this, const void
  */
 BGFX_C_API void bgfx_encoder_set_transform_cached(bgfx_encoder_t* _this, uint32_t _cache, uint16_t _num);
 
+/**
+ * Set model matrix from persistent transform buffer for draw primitive.
+ * Transform buffer can't be used while recording draw bundle.
+ * Draw uses matrices as they are at `bgfx::frame`, updates made later in the
+ * same frame apply to draws submitted before them. Matrices of transform buffer
+ * created in the same frame are copied at the call instead.
+ *
+ * @param[in] _handle Transform buffer.
+ * @param[in] _start Index of first matrix in transform buffer.
+ * @param[in] _num Number of matrices from transform buffer.
+ *
+ */
+BGFX_C_API void bgfx_encoder_set_transform_buffer(bgfx_encoder_t* _this, bgfx_transform_buffer_handle_t _handle, uint16_t _start, uint16_t _num);
+
 /**
  * Reserve matrices in internal matrix cache.
  * @attention Pointer returned can be modifed until `bgfx::frame` is called.
@@ -2398,6 +2605,16 @@ BGFX_C_API uint32_t bgfx_encoder_alloc_transform(bgfx_encoder_t* _this, bgfx_tra
  */
 BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
 
+/**
+ * Set all uniforms of uniform block for draw primitive.
+ *
+ * @param[in] _handle Uniform block.
+ * @param[in] _data Pointer to packed uniform data, laid out as
+ *  described on uniform block creation.
+ *
+ */
+BGFX_C_API void bgfx_encoder_set_uniform_block(bgfx_encoder_t* _this, bgfx_uniform_block_handle_t _handle, const void* _data);
+
 /**
  * Set index buffer for draw primitive.
  *
@@ -2580,6 +2797,63 @@ BGFX_C_API void bgfx_encoder_submit_occlusion_query(bgfx_encoder_t* _this, bgfx_
  */
 BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
 
+/**
+ * Submit batch of primitives sharing program, buffers and state for
+ * rendering. Equivalent to calling `setTransform`, `setIndexBuffer`
+ * and `submit` with `_preserveState` for each item, but all items are
+ * reserved and written in one pass.
+ *
+ * @param[in] _id View id.
+ * @param[in] _program Program.
+ * @param[in] _num Number of items in batch.
+ * @param[in] _mtx Pointer to `_num` transform matrices, one per item.
+ *  When `NULL` currently set transform is used for all items.
+ * @param[in] _startIndex Per item first index, relative to first index
+ *  set with `setIndexBuffer`. When `NULL` it's 0 for all items.
+ * @param[in] _numIndices Per item number of indices. When `NULL`
+ *  currently set number of indices is used for all items.
+ * @param[in] _depth Per item depth for sorting. When `NULL` it's 0 for
+ *  all items.
+ * @param[in] _preserveState Preserve internal draw state for next draw call submit.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_batch(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState);
+
+/**
+ * Begin recording draw bundle. While recording, draw calls submitted
+ * to encoder are captured into draw bundle instead of the frame.
+ * Draw bundle is retained across frames, so it must not reference
+ * transient buffers. Occlusion queries, compute dispatches, and
+ * blits can't be recorded. Dynamic buffers are resolved again each
+ * time bundle is submitted, and draw calls using resources destroyed
+ * after recording are dropped.
+ *
+ * @param[in] _handle Draw bundle handle. Previous contents of draw
+ *  bundle are discarded.
+ *
+ */
+BGFX_C_API void bgfx_encoder_begin_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * End recording draw bundle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_end_draw_bundle(bgfx_encoder_t* _this);
+
+/**
+ * Submit recorded draw bundle for rendering.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw bundle handle.
+ * @param[in] _mtx Pointer to transform matrices. When `NULL` recorded
+ *  transforms are used.
+ * @param[in] _num Number of matrices in array. When 1, recorded
+ *  transforms are multiplied by it. Otherwise it must match number of
+ *  draw calls in bundle, and each draw call uses its own transform.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_draw_bundle(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle, const void* _mtx, uint16_t _num);
+
 /**
  * Set compute index buffer.
  *
@@ -2713,6 +2987,66 @@ BGFX_C_API void bgfx_encoder_blit(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgf
  */
 BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
 
+/**
+ * Start capturing submitted frames into frame trace file.
+ * @remarks
+ *   Resources created before trace is started are stored only when library
+ *   is built with `BGFX_CONFIG_FRAME_TRACE`.
+ *
+ * @param[in] _filePath Frame trace file path.
+ *
+ * @returns True if frame trace file is opened.
+ *
+ */
+BGFX_C_API bool bgfx_start_frame_trace(const char* _filePath);
+
+/**
+ * Stop capturing frames into frame trace file.
+ *
+ */
+BGFX_C_API void bgfx_stop_frame_trace(void);
+
+/**
+ * Open frame trace file for replay.
+ *
+ * @param[in] _filePath Frame trace file path.
+ *
+ * @returns Number of frames in frame trace, or 0 if file can't be opened,
+ *  or it was captured by incompatible build.
+ *
+ */
+BGFX_C_API uint32_t bgfx_open_frame_trace(const char* _filePath);
+
+/**
+ * Replay next frame from frame trace into current frame. Nothing else
+ * should be submitted in the same frame.
+ *
+ * @returns False when all frames are replayed. Resources created by replay
+ *  are destroyed then, and next call starts replay from the first frame.
+ *
+ */
+BGFX_C_API bool bgfx_replay_frame_trace(void);
+
+/**
+ * Close frame trace file, and destroy resources created by replay.
+ *
+ */
+BGFX_C_API void bgfx_close_frame_trace(void);
+
+/**
+ * Save events recorded by built-in profiler into Chrome trace event
+ * format JSON file.
+ * @remarks
+ *   Events are recorded only while `BGFX_DEBUG_PROFILER` debug flag is set,
+ *   and when library is built with `BGFX_CONFIG_PROFILER`.
+ *
+ * @param[in] _filePath Profiler trace file path.
+ *
+ * @returns True if profiler trace file is written.
+ *
+ */
+BGFX_C_API bool bgfx_save_profiler_trace(const char* _filePath);
+
 /**
  * Render frame.
  * @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -2837,6 +3171,17 @@ BGFX_C_API void bgfx_set_state(uint64_t _state, uint32_t _rgba);
  */
 BGFX_C_API void bgfx_set_condition(bgfx_occlusion_query_handle_t _handle, bool _visible);
 
+/**
+ * Set material id for draw primitive. Draw calls with the same
+ * program are grouped by material id when sorted, so draws sharing
+ * textures and other bindings are submitted next to each other.
+ *
+ * @param[in] _material Material id. Only lower bits are used, 8 bits
+ *  by default.
+ *
+ */
+BGFX_C_API void bgfx_set_material(uint16_t _material);
+
 /**
  * Set stencil test state.
  *
@@ -2885,6 +3230,21 @@ BGFX_C_API void bgfx_set_scissor_cached(uint16_t _cache);
  */
 BGFX_C_API uint32_t bgfx_set_transform(const void* _mtx, uint16_t _num);
 
+/**
+ * Set model matrices for draw primitive from palette multiplied by parent
+ * matrix. Each matrix in cache is `_mtx[ii] * _parent`, computed directly
+ * into internal matrix cache.
+ *
+ * @param[in] _mtx Pointer to first matrix in palette.
+ * @param[in] _num Number of matrices in palette.
+ * @param[in] _parent Pointer to parent matrix.
+ *
+ * @returns Index into matrix cache in case the same model matrices have
+ *  to be used for other draw primitive call.
+ *
+ */
+BGFX_C_API uint32_t bgfx_set_transform_palette(const void* _mtx, uint16_t _num, const void* _parent);
+
 /**
  *  Set model matrix from matrix cache for draw primitive.
  *
@@ -2894,6 +3254,20 @@ BGFX_C_API uint32_t bgfx_set_transform(const void* _mtx, uint16_t _num);
  */
 BGFX_C_API void bgfx_set_transform_cached(uint32_t _cache, uint16_t _num);
 
+/**
+ * Set model matrix from persistent transform buffer for draw primitive.
+ * Transform buffer can't be used while recording draw bundle.
+ * Draw uses matrices as they are at `bgfx::frame`, updates made later in the
+ * same frame apply to draws submitted before them. Matrices of transform buffer
+ * created in the same frame are copied at the call instead.
+ *
+ * @param[in] _handle Transform buffer.
+ * @param[in] _start Index of first matrix in transform buffer.
+ * @param[in] _num Number of matrices from transform buffer.
+ *
+ */
+BGFX_C_API void bgfx_set_transform_buffer(bgfx_transform_buffer_handle_t _handle, uint16_t _start, uint16_t _num);
+
 /**
  * Reserve matrices in internal matrix cache.
  * @attention Pointer returned can be modifed until `bgfx::frame` is called.
@@ -2917,6 +3291,16 @@ BGFX_C_API uint32_t bgfx_alloc_transform(bgfx_transform_t* _transform, uint16_t
  */
 BGFX_C_API void bgfx_set_uniform(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
 
+/**
+ * Set all uniforms of uniform block for draw primitive.
+ *
+ * @param[in] _handle Uniform block.
+ * @param[in] _data Pointer to packed uniform data, laid out as
+ *  described on uniform block creation.
+ *
+ */
+BGFX_C_API void bgfx_set_uniform_block(bgfx_uniform_block_handle_t _handle, const void* _data);
+
 /**
  * Set index buffer for draw primitive.
  *
@@ -3096,6 +3480,63 @@ BGFX_C_API void bgfx_submit_occlusion_query(bgfx_view_id_t _id, bgfx_program_han
  */
 BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
 
+/**
+ * Submit batch of primitives sharing program, buffers and state for
+ * rendering. Equivalent to calling `setTransform`, `setIndexBuffer`
+ * and `submit` with `_preserveState` for each item, but all items are
+ * reserved and written in one pass.
+ *
+ * @param[in] _id View id.
+ * @param[in] _program Program.
+ * @param[in] _num Number of items in batch.
+ * @param[in] _mtx Pointer to `_num` transform matrices, one per item.
+ *  When `NULL` currently set transform is used for all items.
+ * @param[in] _startIndex Per item first index, relative to first index
+ *  set with `setIndexBuffer`. When `NULL` it's 0 for all items.
+ * @param[in] _numIndices Per item number of indices. When `NULL`
+ *  currently set number of indices is used for all items.
+ * @param[in] _depth Per item depth for sorting. When `NULL` it's 0 for
+ *  all items.
+ * @param[in] _preserveState Preserve internal draw state for next draw call submit.
+ *
+ */
+BGFX_C_API void bgfx_submit_batch(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState);
+
+/**
+ * Begin recording draw bundle. While recording, draw calls submitted
+ * to encoder are captured into draw bundle instead of the frame.
+ * Draw bundle is retained across frames, so it must not reference
+ * transient buffers. Occlusion queries, compute dispatches, and
+ * blits can't be recorded. Dynamic buffers are resolved again each
+ * time bundle is submitted, and draw calls using resources destroyed
+ * after recording are dropped.
+ *
+ * @param[in] _handle Draw bundle handle. Previous contents of draw
+ *  bundle are discarded.
+ *
+ */
+BGFX_C_API void bgfx_begin_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * End recording draw bundle.
+ *
+ */
+BGFX_C_API void bgfx_end_draw_bundle(void);
+
+/**
+ * Submit recorded draw bundle for rendering.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw bundle handle.
+ * @param[in] _mtx Pointer to transform matrices. When `NULL` recorded
+ *  transforms are used.
+ * @param[in] _num Number of matrices in array. When 1, recorded
+ *  transforms are multiplied by it. Otherwise it must match number of
+ *  draw calls in bundle, and each draw call uses its own transform.
+ *
+ */
+BGFX_C_API void bgfx_submit_draw_bundle(bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle, const void* _mtx, uint16_t _num);
+
 /**
  * Set compute index buffer.
  *
@@ -3478,6 +3919,8 @@ struct bgfx_interface_vtbl
     bool (*is_texture_valid)(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags);
     void (*calc_texture_size)(bgfx_texture_info_t * _info, uint16_t _width, uint16_t _height, uint16_t _depth, bool _cubeMap, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format);
     bgfx_texture_handle_t (*create_texture)(const bgfx_memory_t* _mem, uint64_t _flags, uint8_t _skip, bgfx_texture_info_t* _info);
+    bgfx_texture_handle_t (*create_texture_async)(const bgfx_memory_t* _mem, uint64_t _flags, uint8_t _skip);
+    bool (*is_texture_ready)(bgfx_texture_handle_t _handle);
     bgfx_texture_handle_t (*create_texture_2d)(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags, const bgfx_memory_t* _mem);
     bgfx_texture_handle_t (*create_texture_2d_scaled)(bgfx_backbuffer_ratio_t _ratio, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags);
     bgfx_texture_handle_t (*create_texture_3d)(uint16_t _width, uint16_t _height, uint16_t _depth, bool _hasMips, bgfx_texture_format_t _format, uint64_t _flags, const bgfx_memory_t* _mem);
@@ -3500,9 +3943,16 @@ struct bgfx_interface_vtbl
     bgfx_uniform_handle_t (*create_uniform)(const char* _name, bgfx_uniform_type_t _type, uint16_t _num);
     void (*get_uniform_info)(bgfx_uniform_handle_t _handle, bgfx_uniform_info_t * _info);
     void (*destroy_uniform)(bgfx_uniform_handle_t _handle);
+    bgfx_uniform_block_handle_t (*create_uniform_block)(const bgfx_uniform_handle_t* _uniforms, uint16_t _num);
+    void (*destroy_uniform_block)(bgfx_uniform_block_handle_t _handle);
     bgfx_occlusion_query_handle_t (*create_occlusion_query)(void);
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    bgfx_draw_bundle_handle_t (*create_draw_bundle)(void);
+    void (*destroy_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
+    bgfx_transform_buffer_handle_t (*create_transform_buffer)(uint16_t _num);
+    void (*update_transform_buffer)(bgfx_transform_buffer_handle_t _handle, uint16_t _start, const void* _mtx, uint16_t _num);
+    void (*destroy_transform_buffer)(bgfx_transform_buffer_handle_t _handle);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
     void (*set_view_name)(bgfx_view_id_t _id, const char* _name);
@@ -3515,18 +3965,23 @@ struct bgfx_interface_vtbl
     void (*set_view_frame_buffer)(bgfx_view_id_t _id, bgfx_frame_buffer_handle_t _handle);
     void (*set_view_transform)(bgfx_view_id_t _id, const void* _view, const void* _proj);
     void (*set_view_order)(bgfx_view_id_t _id, uint16_t _num, const bgfx_view_id_t* _order);
+    void (*set_view_uniform)(bgfx_view_id_t _id, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
     bgfx_encoder_t* (*encoder_begin)(bool _forThread);
     void (*encoder_end)(bgfx_encoder_t* _encoder);
     void (*encoder_set_marker)(bgfx_encoder_t* _this, const char* _marker);
     void (*encoder_set_state)(bgfx_encoder_t* _this, uint64_t _state, uint32_t _rgba);
     void (*encoder_set_condition)(bgfx_encoder_t* _this, bgfx_occlusion_query_handle_t _handle, bool _visible);
+    void (*encoder_set_material)(bgfx_encoder_t* _this, uint16_t _material);
     void (*encoder_set_stencil)(bgfx_encoder_t* _this, uint32_t _fstencil, uint32_t _bstencil);
     uint16_t (*encoder_set_scissor)(bgfx_encoder_t* _this, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height);
     void (*encoder_set_scissor_cached)(bgfx_encoder_t* _this, uint16_t _cache);
     uint32_t (*encoder_set_transform)(bgfx_encoder_t* _this, const void* _mtx, uint16_t _num);
+    uint32_t (*encoder_set_transform_palette)(bgfx_encoder_t* _this, const void* _mtx, uint16_t _num, const void* _parent);
     void (*encoder_set_transform_cached)(bgfx_encoder_t* _this, uint32_t _cache, uint16_t _num);
+    void (*encoder_set_transform_buffer)(bgfx_encoder_t* _this, bgfx_transform_buffer_handle_t _handle, uint16_t _start, uint16_t _num);
     uint32_t (*encoder_alloc_transform)(bgfx_encoder_t* _this, bgfx_transform_t* _transform, uint16_t _num);
     void (*encoder_set_uniform)(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+    void (*encoder_set_uniform_block)(bgfx_encoder_t* _this, bgfx_uniform_block_handle_t _handle, const void* _data);
     void (*encoder_set_index_buffer)(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_dynamic_index_buffer)(bgfx_encoder_t* _this, bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_transient_index_buffer)(bgfx_encoder_t* _this, const bgfx_transient_index_buffer_t* _tib, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3543,6 +3998,10 @@ struct bgfx_interface_vtbl
     void (*encoder_submit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, bool _preserveState);
     void (*encoder_submit_occlusion_query)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, bool _preserveState);
     void (*encoder_submit_indirect)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
+    void (*encoder_submit_batch)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState);
+    void (*encoder_begin_draw_bundle)(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+    void (*encoder_end_draw_bundle)(bgfx_encoder_t* _this);
+    void (*encoder_submit_draw_bundle)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle, const void* _mtx, uint16_t _num);
     void (*encoder_set_compute_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_vertex_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_dynamic_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -3554,6 +4013,12 @@ struct bgfx_interface_vtbl
     void (*encoder_discard)(bgfx_encoder_t* _this);
     void (*encoder_blit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_texture_handle_t _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, bgfx_texture_handle_t _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
     void (*request_screen_shot)(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
+    bool (*start_frame_trace)(const char* _filePath);
+    void (*stop_frame_trace)(void);
+    uint32_t (*open_frame_trace)(const char* _filePath);
+    bool (*replay_frame_trace)(void);
+    void (*close_frame_trace)(void);
+    bool (*save_profiler_trace)(const char* _filePath);
     bgfx_render_frame_t (*render_frame)(int32_t _msecs);
     void (*set_platform_data)(const bgfx_platform_data_t * _data);
     const bgfx_internal_data_t* (*get_internal_data)(void);
@@ -3562,13 +4027,17 @@ struct bgfx_interface_vtbl
     void (*set_marker)(const char* _marker);
     void (*set_state)(uint64_t _state, uint32_t _rgba);
     void (*set_condition)(bgfx_occlusion_query_handle_t _handle, bool _visible);
+    void (*set_material)(uint16_t _material);
     void (*set_stencil)(uint32_t _fstencil, uint32_t _bstencil);
     uint16_t (*set_scissor)(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height);
     void (*set_scissor_cached)(uint16_t _cache);
     uint32_t (*set_transform)(const void* _mtx, uint16_t _num);
+    uint32_t (*set_transform_palette)(const void* _mtx, uint16_t _num, const void* _parent);
     void (*set_transform_cached)(uint32_t _cache, uint16_t _num);
+    void (*set_transform_buffer)(bgfx_transform_buffer_handle_t _handle, uint16_t _start, uint16_t _num);
     uint32_t (*alloc_transform)(bgfx_transform_t* _transform, uint16_t _num);
     void (*set_uniform)(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+    void (*set_uniform_block)(bgfx_uniform_block_handle_t _handle, const void* _data);
     void (*set_index_buffer)(bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*set_dynamic_index_buffer)(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*set_transient_index_buffer)(const bgfx_transient_index_buffer_t* _tib, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3585,6 +4054,10 @@ struct bgfx_interface_vtbl
     void (*submit)(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, bool _preserveState);
     void (*submit_occlusion_query)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, bool _preserveState);
     void (*submit_indirect)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
+    void (*submit_batch)(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState);
+    void (*begin_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
+    void (*end_draw_bundle)(void);
+    void (*submit_draw_bundle)(bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle, const void* _mtx, uint16_t _num);
     void (*set_compute_index_buffer)(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_vertex_buffer)(uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_dynamic_index_buffer)(uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
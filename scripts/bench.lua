@@ -0,0 +1,57 @@
+--
+-- Copyright 2010-2020 Branimir Karadzic. All rights reserved.
+-- License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+--
+
+project "bgfx-bench"
+	uuid (os.uuid("bgfx-bench"))
+	kind "ConsoleApp"
+
+	includedirs {
+		path.join(BX_DIR,   "include"),
+		path.join(BIMG_DIR, "include"),
+		path.join(BGFX_DIR, "include"),
+	}
+
+	files {
+		path.join(BGFX_DIR, "tools/bench/**.cpp"),
+		path.join(BGFX_DIR, "tools/bench/**.h"),
+	}
+
+	links {
+		"bgfx",
+		"bimg",
+		"bx",
+	}
+
+	configuration { "mingw-*" }
+		targetextension ".exe"
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "vs20*", "x32 or x64" }
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "linux-*" }
+		links {
+			"X11",
+			"GL",
+			"pthread",
+		}
+
+	configuration { "osx" }
+		linkoptions {
+			"-framework Cocoa",
+			"-framework Metal",
+			"-framework QuartzCore",
+			"-framework OpenGL",
+		}
+
+	configuration {}
+
+	strip()
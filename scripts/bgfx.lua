@@ -169,6 +169,7 @@ function bgfxProjectBase(_kind, _defines)
 			path.join(BGFX_DIR, "src/bgfx.cpp"),
 			path.join(BGFX_DIR, "src/debug_**.cpp"),
 			path.join(BGFX_DIR, "src/dxgi.cpp"),
+			path.join(BGFX_DIR, "src/frametrace.cpp"),
 			path.join(BGFX_DIR, "src/glcontext_**.cpp"),
 			path.join(BGFX_DIR, "src/hmd**.cpp"),
 			path.join(BGFX_DIR, "src/image.cpp"),
@@ -534,9 +534,11 @@ end
 
 if _OPTIONS["with-tools"] then
 	group "tools"
+	dofile "bench.lua"
 	dofile "shaderc.lua"
 	dofile "texturec.lua"
 	dofile "texturev.lua"
 	dofile "geometryc.lua"
 	dofile "geometryv.lua"
+	dofile "frameplay.lua"
 end
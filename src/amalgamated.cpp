@@ -6,6 +6,7 @@
 #include "bgfx.cpp"
 #include "debug_renderdoc.cpp"
 #include "dxgi.cpp"
+#include "frametrace.cpp"
 #include "glcontext_egl.cpp"
 #include "glcontext_glx.cpp"
 #include "glcontext_wgl.cpp"
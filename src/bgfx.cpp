@@ -16,6 +16,17 @@
 #	include <objc/message.h>
 #endif // BX_PLATFORM_OSX
 
+#if BGFX_CONFIG_SIMD_AVX2
+#	include <immintrin.h>
+#	if BX_COMPILER_MSVC
+#		include <intrin.h>
+#		define BGFX_TARGET_AVX2
+#	else
+#		include <cpuid.h>
+#		define BGFX_TARGET_AVX2 __attribute__( (target("avx2") ) )
+#	endif // BX_COMPILER_MSVC
+#endif // BGFX_CONFIG_SIMD_AVX2
+
 BX_ERROR_RESULT(BGFX_ERROR_TEXTURE_VALIDATION,  BX_MAKEFOURCC('b', 'g', 0, 1) );
 
 namespace bgfx
@@ -289,12 +300,386 @@ namespace bgfx
 	};
 
 	static ThreadData s_threadIndex(0);
+	static ThreadData s_encoderIndex(0);
 #elif !BGFX_CONFIG_MULTITHREADED
 	static uint32_t s_threadIndex(0);
 #else
 	static BX_THREAD_LOCAL uint32_t s_threadIndex(0);
+	static BX_THREAD_LOCAL uintptr_t s_encoderIndex(0);
 #endif
 
+#if BGFX_CONFIG_MULTITHREADED
+	// Encoder epoch keeps increasing across init/shutdown, so that per-thread
+	// encoder index left from previous context is never reused.
+	static uint32_t s_encoderEpoch = 1;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+#if BGFX_CONFIG_PROFILER
+#	if BGFX_CONFIG_MULTITHREADED && !defined(BX_THREAD_LOCAL)
+	static ThreadData s_profilerRing(0);
+#	elif !BGFX_CONFIG_MULTITHREADED
+	static uintptr_t s_profilerRing(0);
+#	else
+	static BX_THREAD_LOCAL uintptr_t s_profilerRing(0);
+#	endif // BGFX_CONFIG_MULTITHREADED
+
+	BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_PROFILER_MAX_EVENTS) );
+	BX_STATIC_ASSERT(BGFX_CONFIG_PROFILER_MAX_THREADS < 0xff);
+
+	struct ProfilerEvent
+	{
+		enum Enum
+		{
+			Begin,
+			End,
+			AsyncBegin,
+			AsyncEnd,
+		};
+
+		const char* getName() const
+		{
+			return NULL != m_literal ? m_literal : m_name;
+		}
+
+		int64_t     m_time;
+		const char* m_literal;
+		uint32_t    m_abgr;
+		uint8_t     m_type;
+		uint8_t     m_id;
+		char        m_name[26];
+	};
+
+	// Each thread writes only into its own ring, so recording doesn't need any
+	// locking. Export copies rings while threads keep writing, and drops events
+	// overwritten during copy.
+	struct ProfilerRing
+	{
+		ProfilerEvent m_event[BGFX_CONFIG_PROFILER_MAX_EVENTS];
+		uint32_t      m_write;
+		uint32_t      m_tid;
+	};
+
+	struct ProfilerThreadName
+	{
+		uint32_t m_tid;
+		char     m_name[64];
+	};
+
+	class Profiler
+	{
+	public:
+		Profiler()
+			: m_numRings(0)
+			, m_numThreadNames(0)
+			, m_generation(1)
+			, m_enabled(false)
+		{
+			bx::memSet(m_ring, 0, sizeof(m_ring) );
+		}
+
+		void setEnabled(bool _enabled)
+		{
+			m_enabled = _enabled;
+		}
+
+		void add(ProfilerEvent::Enum _type, const char* _name, uint32_t _abgr, bool _literal, uint8_t _id)
+		{
+			if (!m_enabled)
+			{
+				return;
+			}
+
+			ProfilerRing* ring = getRing();
+			if (NULL == ring)
+			{
+				return;
+			}
+
+			const uint32_t write = ring->m_write;
+			ProfilerEvent& event = ring->m_event[write & (BGFX_CONFIG_PROFILER_MAX_EVENTS-1)];
+			event.m_time = bx::getHPCounter();
+			event.m_abgr = _abgr;
+			event.m_type = uint8_t(_type);
+			event.m_id   = _id;
+
+			if (_literal
+			||  NULL == _name)
+			{
+				event.m_literal = _name;
+			}
+			else
+			{
+				event.m_literal = NULL;
+				bx::strCopy(event.m_name, sizeof(event.m_name), _name);
+			}
+
+			bx::atomicFetchAndAdd<uint32_t>(&ring->m_write, 1);
+		}
+
+		void setThreadName(const char* _name)
+		{
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_numThreadNames, 1);
+			if (idx < BGFX_CONFIG_PROFILER_MAX_THREADS)
+			{
+				ProfilerThreadName& threadName = m_threadName[idx];
+				bx::strCopy(threadName.m_name, sizeof(threadName.m_name), _name);
+				bx::atomicExchange<uint32_t>(&threadName.m_tid, bx::getTid() );
+			}
+		}
+
+		bool save(const char* _filePath)
+		{
+			bx::FileWriter writer;
+			bx::Error err;
+
+			if (!bx::open(&writer, _filePath, false, &err) )
+			{
+				BX_TRACE("Failed to open profiler trace file %s.", _filePath);
+				return false;
+			}
+
+			ProfilerEvent* events = (ProfilerEvent*)BX_ALLOC(g_allocator, sizeof(ProfilerEvent)*BGFX_CONFIG_PROFILER_MAX_EVENTS);
+
+			// Chrome trace event format, it's also accepted by Perfetto.
+			writef(&writer, &err, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+			const double toUs = 1000000.0/double(bx::getHPFrequency() );
+			const char* separator = "";
+
+			for (uint32_t ii = 0, num = bx::min<uint32_t>(m_numThreadNames, BGFX_CONFIG_PROFILER_MAX_THREADS); ii < num; ++ii)
+			{
+				const ProfilerThreadName& threadName = m_threadName[ii];
+				if (0 != threadName.m_tid)
+				{
+					writef(&writer, &err, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":"
+						, separator
+						, threadName.m_tid
+						);
+					writeString(&writer, threadName.m_name, &err);
+					writef(&writer, &err, "}}");
+					separator = ",\n";
+				}
+			}
+
+			for (uint32_t ii = 0, num = bx::min<uint32_t>(m_numRings, BGFX_CONFIG_PROFILER_MAX_THREADS); ii < num; ++ii)
+			{
+				const ProfilerRing* ring = m_ring[ii];
+				if (NULL == ring)
+				{
+					continue;
+				}
+
+				const uint32_t end   = bx::atomicFetchAndAdd<uint32_t>(const_cast<uint32_t*>(&ring->m_write), 0);
+				const uint32_t begin = end > BGFX_CONFIG_PROFILER_MAX_EVENTS ? end - BGFX_CONFIG_PROFILER_MAX_EVENTS : 0;
+
+				for (uint32_t pos = begin; pos < end; ++pos)
+				{
+					events[pos-begin] = ring->m_event[pos & (BGFX_CONFIG_PROFILER_MAX_EVENTS-1)];
+				}
+
+				// Events at positions ring wrapped over while copying are not
+				// valid, including the one being written.
+				const uint32_t written = bx::atomicFetchAndAdd<uint32_t>(const_cast<uint32_t*>(&ring->m_write), 0) + 1;
+				const uint32_t valid   = written > BGFX_CONFIG_PROFILER_MAX_EVENTS ? written - BGFX_CONFIG_PROFILER_MAX_EVENTS : 0;
+
+				uint32_t depth = 0;
+
+				for (uint32_t pos = bx::max(begin, valid); pos < end; ++pos)
+				{
+					const ProfilerEvent& event = events[pos-begin];
+					const double ts = double(event.m_time)*toUs;
+
+					switch (event.m_type)
+					{
+					case ProfilerEvent::Begin:
+						++depth;
+						writef(&writer, &err, "%s{\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":", separator, ring->m_tid, ts);
+						writeString(&writer, event.getName(), &err);
+						writef(&writer, &err, "}");
+						break;
+
+					case ProfilerEvent::End:
+						// Begin was overwritten by ring.
+						if (0 == depth)
+						{
+							continue;
+						}
+
+						--depth;
+						writef(&writer, &err, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", separator, ring->m_tid, ts);
+						break;
+
+					default:
+						writef(&writer, &err, "%s{\"ph\":\"%c\",\"cat\":\"bgfx\",\"id\":%d,\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":"
+							, separator
+							, ProfilerEvent::AsyncBegin == event.m_type ? 'b' : 'e'
+							, event.m_id
+							, ring->m_tid
+							, ts
+							);
+						writeString(&writer, event.getName(), &err);
+						writef(&writer, &err, "}");
+						break;
+					}
+
+					separator = ",\n";
+				}
+			}
+
+			writef(&writer, &err, "\n]}\n");
+			bx::close(&writer);
+
+			BX_FREE(g_allocator, events);
+
+			return err.isOk();
+		}
+
+		void shutdown()
+		{
+			// Bumping generation makes threads allocate new ring on the next
+			// event, instead of using index left from previous context.
+			m_enabled = false;
+			++m_generation;
+
+			for (uint32_t ii = 0, num = bx::min<uint32_t>(m_numRings, BGFX_CONFIG_PROFILER_MAX_THREADS); ii < num; ++ii)
+			{
+				BX_FREE(g_allocator, m_ring[ii]);
+				m_ring[ii] = NULL;
+			}
+
+			m_numRings       = 0;
+			m_numThreadNames = 0;
+			bx::memSet(m_threadName, 0, sizeof(m_threadName) );
+		}
+
+	private:
+		ProfilerRing* getRing()
+		{
+			const uintptr_t tls = s_profilerRing;
+			if (uint32_t(tls >> 8) == m_generation)
+			{
+				const uint32_t idx = uint32_t(tls & 0xff);
+				return idx < BGFX_CONFIG_PROFILER_MAX_THREADS ? m_ring[idx] : NULL;
+			}
+
+			// Threads past maximum get index 0xff, and they are not recorded.
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_numRings, 1);
+			s_profilerRing = (uintptr_t(m_generation) << 8) | bx::min<uint32_t>(idx, 0xff);
+
+			if (idx >= BGFX_CONFIG_PROFILER_MAX_THREADS)
+			{
+				return NULL;
+			}
+
+			ProfilerRing* ring = (ProfilerRing*)BX_ALLOC(g_allocator, sizeof(ProfilerRing) );
+			ring->m_write = 0;
+			ring->m_tid   = bx::getTid();
+			bx::atomicExchangePtr( (void**)&m_ring[idx], ring);
+
+			return ring;
+		}
+
+		static void writef(bx::WriterI* _writer, bx::Error* _err, const char* _format, ...)
+		{
+			va_list argList;
+			va_start(argList, _format);
+			char temp[256];
+			int32_t len = bx::vsnprintf(temp, sizeof(temp), _format, argList);
+			va_end(argList);
+
+			bx::write(_writer, temp, bx::min<int32_t>(len, int32_t(sizeof(temp) )-1), _err);
+		}
+
+		static void writeString(bx::WriterI* _writer, const char* _str, bx::Error* _err)
+		{
+			bx::write(_writer, '"', _err);
+
+			for (const char* ptr = _str; '\0' != *ptr; ++ptr)
+			{
+				const char ch = *ptr;
+				if ('"'  == ch
+				||  '\\' == ch)
+				{
+					bx::write(_writer, '\\', _err);
+				}
+
+				if (0x20 <= uint8_t(ch) )
+				{
+					bx::write(_writer, ch, _err);
+				}
+			}
+
+			bx::write(_writer, '"', _err);
+		}
+
+		ProfilerRing*      m_ring[BGFX_CONFIG_PROFILER_MAX_THREADS];
+		ProfilerThreadName m_threadName[BGFX_CONFIG_PROFILER_MAX_THREADS];
+		uint32_t           m_numRings;
+		uint32_t           m_numThreadNames;
+		uint32_t           m_generation;
+		volatile bool      m_enabled;
+	};
+
+	static Profiler s_profiler;
+
+	void profilerBegin(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line, bool _literal)
+	{
+		s_profiler.add(ProfilerEvent::Begin, _name, _abgr, _literal, 0);
+
+		if (_literal)
+		{
+			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+		}
+		else
+		{
+			g_callback->profilerBegin(_name, _abgr, _filePath, _line);
+		}
+	}
+
+	void profilerEnd()
+	{
+		s_profiler.add(ProfilerEvent::End, NULL, 0, true, 0);
+		g_callback->profilerEnd();
+	}
+
+	void profilerAsync(bool _begin, const char* _name, uint8_t _id)
+	{
+		s_profiler.add(_begin ? ProfilerEvent::AsyncBegin : ProfilerEvent::AsyncEnd, _name, 0, true, _id);
+	}
+
+	void profilerSetThreadName(const char* _name)
+	{
+		s_profiler.setThreadName(_name);
+	}
+#endif // BGFX_CONFIG_PROFILER
+
+	void profilerSetEnabled(bool _enabled)
+	{
+#if BGFX_CONFIG_PROFILER
+		s_profiler.setEnabled(_enabled);
+#else
+		BX_UNUSED(_enabled);
+#endif // BGFX_CONFIG_PROFILER
+	}
+
+	bool profilerSave(const char* _filePath)
+	{
+#if BGFX_CONFIG_PROFILER
+		return s_profiler.save(_filePath);
+#else
+		BX_UNUSED(_filePath);
+		BX_TRACE("Built-in profiler requires BGFX_CONFIG_PROFILER.");
+		return false;
+#endif // BGFX_CONFIG_PROFILER
+	}
+
+	void profilerShutdown()
+	{
+#if BGFX_CONFIG_PROFILER
+		s_profiler.shutdown();
+#endif // BGFX_CONFIG_PROFILER
+	}
+
 	static Context* s_ctx = NULL;
 	static bool s_renderFrameCalled = false;
 	InternalData g_internalData;
@@ -881,120 +1266,459 @@ namespace bgfx
 		}
 	}
 
-	const char* s_uniformTypeName[] =
+	// Free command buffer blocks, linked through first bytes of each block.
+	// Only accessed from API thread.
+	static uint8_t* s_cmdBufferFreeBlock = NULL;
+
+	uint8_t* CommandBuffer::allocBlock()
 	{
-		"sampler1",
-		NULL,
-		"vec4",
-		"mat3",
-		"mat4",
-	};
-	BX_STATIC_ASSERT(UniformType::Count == BX_COUNTOF(s_uniformTypeName) );
+		uint8_t* block = s_cmdBufferFreeBlock;
+		if (NULL != block)
+		{
+			s_cmdBufferFreeBlock = *(uint8_t**)block;
+			return block;
+		}
 
-	const char* getUniformTypeName(UniformType::Enum _enum)
+		return (uint8_t*)BX_ALLOC(g_allocator, BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE);
+	}
+
+	void CommandBuffer::freeBlock(uint8_t* _block)
 	{
-		BX_CHECK(_enum < UniformType::Count, "%d < UniformType::Count %d", _enum, UniformType::Count);
-		return s_uniformTypeName[_enum];
+		*(uint8_t**)_block = s_cmdBufferFreeBlock;
+		s_cmdBufferFreeBlock = _block;
 	}
 
-	UniformType::Enum nameToUniformTypeEnum(const char* _name)
+	void CommandBuffer::destroyBlockPool()
 	{
-		for (uint32_t ii = 0; ii < UniformType::Count; ++ii)
+		while (NULL != s_cmdBufferFreeBlock)
 		{
-			if (NULL != s_uniformTypeName[ii]
-			&&  0 == bx::strCmp(_name, s_uniformTypeName[ii]) )
-			{
-				return UniformType::Enum(ii);
-			}
+			uint8_t* block = s_cmdBufferFreeBlock;
+			s_cmdBufferFreeBlock = *(uint8_t**)block;
+			BX_FREE(g_allocator, block);
 		}
-
-		return UniformType::Count;
 	}
 
-	static const char* s_predefinedName[PredefinedUniform::Count] =
+	NonLocalAllocator::NonLocalAllocator()
 	{
-		"u_viewRect",
-		"u_viewTexel",
-		"u_view",
-		"u_invView",
-		"u_proj",
-		"u_invProj",
-		"u_viewProj",
-		"u_invViewProj",
-		"u_model",
-		"u_modelView",
-		"u_modelViewProj",
-		"u_alphaRef4",
-	};
+		reset();
+	}
 
-	const char* getPredefinedUniformName(PredefinedUniform::Enum _enum)
+	NonLocalAllocator::~NonLocalAllocator()
 	{
-		return s_predefinedName[_enum];
 	}
 
-	PredefinedUniform::Enum nameToPredefinedUniformEnum(const char* _name)
+	void NonLocalAllocator::reset()
 	{
-		for (uint32_t ii = 0; ii < PredefinedUniform::Count; ++ii)
-		{
-			if (0 == bx::strCmp(_name, s_predefinedName[ii]) )
-			{
-				return PredefinedUniform::Enum(ii);
-			}
-		}
+		m_block.clear();
+		m_unusedBlock.clear();
+		m_used.clear();
 
-		return PredefinedUniform::Count;
+		bx::memSet(m_head, 0xff, sizeof(m_head) );
+		bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+		m_flBitmap      = 0;
+		m_freeSize      = 0;
+		m_numFreeBlocks = 0;
 	}
 
-	void srtToMatrix4_x1(void* _dst, const void* _src)
+	void NonLocalAllocator::add(uint64_t _ptr, uint32_t _size)
 	{
-		      Matrix4* mtx = reinterpret_cast<  Matrix4*>(_dst);
-		const     Srt* srt = reinterpret_cast<const Srt*>(_src);
+		const uint32_t idx = allocBlock();
 
-		const float rx = srt->rotate[0];
-		const float ry = srt->rotate[1];
-		const float rz = srt->rotate[2];
-		const float rw = srt->rotate[3];
+		Block& block = m_block[idx];
+		block.m_ptr      = _ptr;
+		block.m_size     = _size;
+		block.m_prevPhys = kInvalidIndex;
+		block.m_nextPhys = kInvalidIndex;
 
-		const float xx2 = 2.0f * rx * rx;
-		const float yy2 = 2.0f * ry * ry;
-		const float zz2 = 2.0f * rz * rz;
-		const float yx2 = 2.0f * ry * rx;
-		const float yz2 = 2.0f * ry * rz;
-		const float yw2 = 2.0f * ry * rw;
-		const float wz2 = 2.0f * rw * rz;
-		const float wx2 = 2.0f * rw * rx;
-		const float xz2 = 2.0f * rx * rz;
+		insertFree(idx);
+	}
 
-		const float sx = srt->scale[0];
-		const float sy = srt->scale[1];
-		const float sz = srt->scale[2];
+	uint64_t NonLocalAllocator::remove()
+	{
+		BX_CHECK(0 == m_used.size(), "");
 
-		mtx->un.val[ 0] = (1.0f - yy2 - zz2)*sx;
-		mtx->un.val[ 1] = (       yx2 + wz2)*sx;
-		mtx->un.val[ 2] = (       xz2 - yw2)*sx;
-		mtx->un.val[ 3] = 0.0f;
+		if (0 != m_flBitmap)
+		{
+			const uint32_t fl  = bx::uint32_cnttz(m_flBitmap);
+			const uint32_t sl  = bx::uint32_cnttz(m_slBitmap[fl]);
+			const uint32_t idx = m_head[fl][sl];
 
-		mtx->un.val[ 4] = (       yx2 - wz2)*sy;
-		mtx->un.val[ 5] = (1.0f - xx2 - zz2)*sy;
-		mtx->un.val[ 6] = (       yz2 + wx2)*sy;
-		mtx->un.val[ 7] = 0.0f;
+			removeFree(idx);
 
-		mtx->un.val[ 8] = (       xz2 + yw2)*sz;
-		mtx->un.val[ 9] = (       yz2 - wx2)*sz;
-		mtx->un.val[10] = (1.0f - xx2 - yy2)*sz;
-		mtx->un.val[11] = 0.0f;
+			const uint64_t ptr = m_block[idx].m_ptr;
+			freeBlock(idx);
 
-		const float tx = srt->translate[0];
-		const float ty = srt->translate[1];
-		const float tz = srt->translate[2];
+			return ptr;
+		}
 
-		mtx->un.val[12] = tx;
-		mtx->un.val[13] = ty;
-		mtx->un.val[14] = tz;
-		mtx->un.val[15] = 1.0f;
+		return kInvalidBlock;
 	}
 
-	void transpose(void* _dst, uint32_t _dstStride, const void* _src, uint32_t _srcStride = sizeof(bx::simd128_t) )
+	uint64_t NonLocalAllocator::alloc(uint32_t _size)
+	{
+		_size = bx::max(_size, kMinBlockSize);
+
+		const uint32_t idx = findFree(_size);
+		if (kInvalidIndex == idx)
+		{
+			// there is no block large enough.
+			return kInvalidBlock;
+		}
+
+		removeFree(idx);
+
+		if (m_block[idx].m_size - _size >= kMinBlockSize)
+		{
+			const uint32_t rest = allocBlock();
+
+			Block& block = m_block[idx];
+			Block& restBlock = m_block[rest];
+			restBlock.m_ptr      = block.m_ptr  + _size;
+			restBlock.m_size     = block.m_size - _size;
+			restBlock.m_prevPhys = idx;
+			restBlock.m_nextPhys = block.m_nextPhys;
+
+			if (kInvalidIndex != block.m_nextPhys)
+			{
+				m_block[block.m_nextPhys].m_prevPhys = rest;
+			}
+
+			block.m_nextPhys = rest;
+			block.m_size     = _size;
+
+			insertFree(rest);
+		}
+
+		const uint64_t ptr = m_block[idx].m_ptr;
+		m_used.insert(stl::make_pair(ptr, idx) );
+
+		return ptr;
+	}
+
+	void NonLocalAllocator::free(uint64_t _block)
+	{
+		UsedMap::iterator it = m_used.find(_block);
+		if (it == m_used.end() )
+		{
+			return;
+		}
+
+		uint32_t idx = it->second;
+		m_used.erase(it);
+
+		const uint32_t next = m_block[idx].m_nextPhys;
+		if (kInvalidIndex != next
+		&&  m_block[next].m_free)
+		{
+			removeFree(next);
+
+			Block& block = m_block[idx];
+			block.m_size    += m_block[next].m_size;
+			block.m_nextPhys = m_block[next].m_nextPhys;
+
+			if (kInvalidIndex != block.m_nextPhys)
+			{
+				m_block[block.m_nextPhys].m_prevPhys = idx;
+			}
+
+			freeBlock(next);
+		}
+
+		const uint32_t prev = m_block[idx].m_prevPhys;
+		if (kInvalidIndex != prev
+		&&  m_block[prev].m_free)
+		{
+			removeFree(prev);
+
+			Block& prevBlock = m_block[prev];
+			prevBlock.m_size    += m_block[idx].m_size;
+			prevBlock.m_nextPhys = m_block[idx].m_nextPhys;
+
+			if (kInvalidIndex != prevBlock.m_nextPhys)
+			{
+				m_block[prevBlock.m_nextPhys].m_prevPhys = prev;
+			}
+
+			freeBlock(idx);
+			idx = prev;
+		}
+
+		insertFree(idx);
+	}
+
+	uint32_t NonLocalAllocator::getLargestFreeBlock() const
+	{
+		if (0 == m_flBitmap)
+		{
+			return 0;
+		}
+
+		const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+		const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+
+		uint32_t largest = 0;
+		for (uint32_t idx = m_head[fl][sl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+		{
+			largest = bx::max(largest, m_block[idx].m_size);
+		}
+
+		return largest;
+	}
+
+	void NonLocalAllocator::mapping(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+	{
+		if (_size < kNumSl)
+		{
+			_fl = 0;
+			_sl = _size;
+		}
+		else
+		{
+			const uint32_t msb = 31 - bx::uint32_cntlz(_size);
+			_fl = msb - kSlLog2 + 1;
+			_sl = (_size >> (msb - kSlLog2) ) - kNumSl;
+		}
+	}
+
+	uint32_t NonLocalAllocator::allocBlock()
+	{
+		if (!m_unusedBlock.empty() )
+		{
+			const uint32_t idx = m_unusedBlock.back();
+			m_unusedBlock.pop_back();
+			return idx;
+		}
+
+		m_block.push_back(Block() );
+		return uint32_t(m_block.size() - 1);
+	}
+
+	void NonLocalAllocator::freeBlock(uint32_t _idx)
+	{
+		m_unusedBlock.push_back(_idx);
+	}
+
+	void NonLocalAllocator::insertFree(uint32_t _idx)
+	{
+		Block& block = m_block[_idx];
+
+		uint32_t fl, sl;
+		mapping(block.m_size, fl, sl);
+
+		const uint32_t head = m_head[fl][sl];
+		block.m_free     = true;
+		block.m_prevFree = kInvalidIndex;
+		block.m_nextFree = head;
+
+		if (kInvalidIndex != head)
+		{
+			m_block[head].m_prevFree = _idx;
+		}
+
+		m_head[fl][sl] = _idx;
+		m_slBitmap[fl] |= UINT32_C(1)<<sl;
+		m_flBitmap     |= UINT32_C(1)<<fl;
+
+		m_freeSize += block.m_size;
+		++m_numFreeBlocks;
+	}
+
+	void NonLocalAllocator::removeFree(uint32_t _idx)
+	{
+		Block& block = m_block[_idx];
+
+		uint32_t fl, sl;
+		mapping(block.m_size, fl, sl);
+
+		if (kInvalidIndex != block.m_prevFree)
+		{
+			m_block[block.m_prevFree].m_nextFree = block.m_nextFree;
+		}
+		else
+		{
+			m_head[fl][sl] = block.m_nextFree;
+
+			if (kInvalidIndex == block.m_nextFree)
+			{
+				m_slBitmap[fl] &= ~(UINT32_C(1)<<sl);
+
+				if (0 == m_slBitmap[fl])
+				{
+					m_flBitmap &= ~(UINT32_C(1)<<fl);
+				}
+			}
+		}
+
+		if (kInvalidIndex != block.m_nextFree)
+		{
+			m_block[block.m_nextFree].m_prevFree = block.m_prevFree;
+		}
+
+		block.m_free = false;
+
+		m_freeSize -= block.m_size;
+		--m_numFreeBlocks;
+	}
+
+	uint32_t NonLocalAllocator::findFree(uint32_t _size) const
+	{
+		uint32_t fl, sl;
+
+		// Round size up to next size class, so any block in that class fits.
+		const uint64_t rounded = _size < kNumSl
+			? _size
+			: uint64_t(_size) + (UINT32_C(1) << (31 - bx::uint32_cntlz(_size) - kSlLog2) ) - 1
+			;
+
+		if (rounded <= UINT32_MAX)
+		{
+			mapping(uint32_t(rounded), fl, sl);
+
+			uint32_t slMap = m_slBitmap[fl] & (UINT32_MAX << sl);
+			if (0 == slMap)
+			{
+				const uint32_t flMap = fl+1 < kNumFl ? m_flBitmap & (UINT32_MAX << (fl+1) ) : 0;
+				if (0 != flMap)
+				{
+					fl    = bx::uint32_cnttz(flMap);
+					slMap = m_slBitmap[fl];
+				}
+			}
+
+			if (0 != slMap)
+			{
+				return m_head[fl][bx::uint32_cnttz(slMap)];
+			}
+		}
+
+		// No block in larger size classes, check blocks in requested size
+		// class that might still be large enough.
+		mapping(_size, fl, sl);
+		for (uint32_t idx = m_head[fl][sl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+		{
+			if (m_block[idx].m_size >= _size)
+			{
+				return idx;
+			}
+		}
+
+		return kInvalidIndex;
+	}
+
+	const char* s_uniformTypeName[] =
+	{
+		"sampler1",
+		NULL,
+		"vec4",
+		"mat3",
+		"mat4",
+	};
+	BX_STATIC_ASSERT(UniformType::Count == BX_COUNTOF(s_uniformTypeName) );
+
+	const char* getUniformTypeName(UniformType::Enum _enum)
+	{
+		BX_CHECK(_enum < UniformType::Count, "%d < UniformType::Count %d", _enum, UniformType::Count);
+		return s_uniformTypeName[_enum];
+	}
+
+	UniformType::Enum nameToUniformTypeEnum(const char* _name)
+	{
+		for (uint32_t ii = 0; ii < UniformType::Count; ++ii)
+		{
+			if (NULL != s_uniformTypeName[ii]
+			&&  0 == bx::strCmp(_name, s_uniformTypeName[ii]) )
+			{
+				return UniformType::Enum(ii);
+			}
+		}
+
+		return UniformType::Count;
+	}
+
+	static const char* s_predefinedName[PredefinedUniform::Count] =
+	{
+		"u_viewRect",
+		"u_viewTexel",
+		"u_view",
+		"u_invView",
+		"u_proj",
+		"u_invProj",
+		"u_viewProj",
+		"u_invViewProj",
+		"u_model",
+		"u_modelView",
+		"u_modelViewProj",
+		"u_alphaRef4",
+	};
+
+	const char* getPredefinedUniformName(PredefinedUniform::Enum _enum)
+	{
+		return s_predefinedName[_enum];
+	}
+
+	PredefinedUniform::Enum nameToPredefinedUniformEnum(const char* _name)
+	{
+		for (uint32_t ii = 0; ii < PredefinedUniform::Count; ++ii)
+		{
+			if (0 == bx::strCmp(_name, s_predefinedName[ii]) )
+			{
+				return PredefinedUniform::Enum(ii);
+			}
+		}
+
+		return PredefinedUniform::Count;
+	}
+
+	void srtToMatrix4_x1(void* _dst, const void* _src)
+	{
+		      Matrix4* mtx = reinterpret_cast<  Matrix4*>(_dst);
+		const     Srt* srt = reinterpret_cast<const Srt*>(_src);
+
+		const float rx = srt->rotate[0];
+		const float ry = srt->rotate[1];
+		const float rz = srt->rotate[2];
+		const float rw = srt->rotate[3];
+
+		const float xx2 = 2.0f * rx * rx;
+		const float yy2 = 2.0f * ry * ry;
+		const float zz2 = 2.0f * rz * rz;
+		const float yx2 = 2.0f * ry * rx;
+		const float yz2 = 2.0f * ry * rz;
+		const float yw2 = 2.0f * ry * rw;
+		const float wz2 = 2.0f * rw * rz;
+		const float wx2 = 2.0f * rw * rx;
+		const float xz2 = 2.0f * rx * rz;
+
+		const float sx = srt->scale[0];
+		const float sy = srt->scale[1];
+		const float sz = srt->scale[2];
+
+		mtx->un.val[ 0] = (1.0f - yy2 - zz2)*sx;
+		mtx->un.val[ 1] = (       yx2 + wz2)*sx;
+		mtx->un.val[ 2] = (       xz2 - yw2)*sx;
+		mtx->un.val[ 3] = 0.0f;
+
+		mtx->un.val[ 4] = (       yx2 - wz2)*sy;
+		mtx->un.val[ 5] = (1.0f - xx2 - zz2)*sy;
+		mtx->un.val[ 6] = (       yz2 + wx2)*sy;
+		mtx->un.val[ 7] = 0.0f;
+
+		mtx->un.val[ 8] = (       xz2 + yw2)*sz;
+		mtx->un.val[ 9] = (       yz2 - wx2)*sz;
+		mtx->un.val[10] = (1.0f - xx2 - yy2)*sz;
+		mtx->un.val[11] = 0.0f;
+
+		const float tx = srt->translate[0];
+		const float ty = srt->translate[1];
+		const float tz = srt->translate[2];
+
+		mtx->un.val[12] = tx;
+		mtx->un.val[13] = ty;
+		mtx->un.val[14] = tz;
+		mtx->un.val[15] = 1.0f;
+	}
+
+	void transpose(void* _dst, uint32_t _dstStride, const void* _src, uint32_t _srcStride = sizeof(bx::simd128_t) )
 	{
 		      uint8_t* dst = reinterpret_cast<      uint8_t *>(_dst);
 		const uint8_t* src = reinterpret_cast<const uint8_t *>(_src);
@@ -1132,23 +1856,227 @@ namespace bgfx
 		transpose(dst + 3, sizeof(Matrix4), tmp);
 	}
 
-	void srtToMatrix4(void* _dst, const void* _src, uint32_t _num)
+#if BGFX_CONFIG_SIMD_AVX2
+	static bool s_simdAvx2 = false;
+
+	static void cpuId(uint32_t* _regs, uint32_t _leaf)
 	{
-		      uint8_t* dst = reinterpret_cast<      uint8_t*>(_dst);
-		const uint8_t* src = reinterpret_cast<const uint8_t*>(_src);
+#	if BX_COMPILER_MSVC
+		__cpuidex( (int*)_regs, int(_leaf), 0);
+#	else
+		__cpuid_count(_leaf, 0, _regs[0], _regs[1], _regs[2], _regs[3]);
+#	endif // BX_COMPILER_MSVC
+	}
+
+	static uint64_t cpuXgetbv()
+	{
+#	if BX_COMPILER_MSVC
+		return _xgetbv(0);
+#	else
+		uint32_t eax;
+		uint32_t edx;
+		__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0) );
+		return (uint64_t(edx)<<32) | eax;
+#	endif // BX_COMPILER_MSVC
+	}
 
-		if (!bx::isAligned(src, 16) )
+	static bool cpuHasAvx2()
+	{
+		uint32_t regs[4];
+		cpuId(regs, 0);
+		if (regs[0] < 7)
 		{
-			for (uint32_t ii = 0, num = _num / 4; ii < num; ++ii)
-			{
-				srtToMatrix4_x4_Ref(dst, src);
-				src += 4*sizeof(Srt);
-				dst += 4*sizeof(Matrix4);
-			}
+			return false;
 		}
-		else
+
+		// AVX and OSXSAVE, and OS must preserve YMM registers.
+		cpuId(regs, 1);
+		if (0 == (regs[2] & (1<<27) )
+		||  0 == (regs[2] & (1<<28) )
+		||  6 != (cpuXgetbv() & 6) )
 		{
-			for (uint32_t ii = 0, num = _num / 4; ii < num; ++ii)
+			return false;
+		}
+
+		cpuId(regs, 7);
+		return 0 != (regs[1] & (1<<5) );
+	}
+
+	// Transpose 4x4 within each 128-bit lane.
+	BGFX_TARGET_AVX2 static void transpose_x8(__m256* _dst, const __m256* _src)
+	{
+		const __m256 aibj = _mm256_unpacklo_ps(_src[0], _src[1]);
+		const __m256 ckdl = _mm256_unpackhi_ps(_src[0], _src[1]);
+		const __m256 emfn = _mm256_unpacklo_ps(_src[2], _src[3]);
+		const __m256 gohp = _mm256_unpackhi_ps(_src[2], _src[3]);
+		_dst[0] = _mm256_shuffle_ps(aibj, emfn, _MM_SHUFFLE(1, 0, 1, 0) );
+		_dst[1] = _mm256_shuffle_ps(aibj, emfn, _MM_SHUFFLE(3, 2, 3, 2) );
+		_dst[2] = _mm256_shuffle_ps(ckdl, gohp, _MM_SHUFFLE(1, 0, 1, 0) );
+		_dst[3] = _mm256_shuffle_ps(ckdl, gohp, _MM_SHUFFLE(3, 2, 3, 2) );
+	}
+
+	// Load same member of SRTs ii and ii+4 into low and high lane, so that
+	// after transpose each register holds one component of eight SRTs.
+	BGFX_TARGET_AVX2 static void srtLoad_x8(__m256* _dst, const float* _src)
+	{
+		const uint32_t stride = sizeof(Srt)/sizeof(float);
+
+		__m256 tmp[4];
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			tmp[ii] = _mm256_insertf128_ps(
+				  _mm256_castps128_ps256(_mm_load_ps(&_src[ii*stride]) )
+				, _mm_load_ps(&_src[(ii+4)*stride])
+				, 1
+				);
+		}
+
+		transpose_x8(_dst, tmp);
+	}
+
+	BGFX_TARGET_AVX2 static void mtxStoreRow_x8(float* _dst, uint32_t _row, const __m256* _src)
+	{
+		__m256 tmp[4];
+		transpose_x8(tmp, _src);
+
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			_mm_store_ps(&_dst[ ii   *16 + _row*4], _mm256_castps256_ps128(tmp[ii]) );
+			_mm_store_ps(&_dst[(ii+4)*16 + _row*4], _mm256_extractf128_ps(tmp[ii], 1) );
+		}
+	}
+
+	BGFX_TARGET_AVX2 void srtToMatrix4_x8_Avx2(void* _dst, const void* _src)
+	{
+		      float* dst = reinterpret_cast<      float*>(_dst);
+		const float* src = reinterpret_cast<const float*>(_src);
+
+		__m256 rotate[4];
+		__m256 translate[4];
+		__m256 scale[4];
+
+		srtLoad_x8(rotate,    src + 0);
+		srtLoad_x8(translate, src + 4);
+		srtLoad_x8(scale,     src + 8);
+
+		const __m256 rx    = rotate[0];
+		const __m256 ry    = rotate[1];
+		const __m256 rz    = rotate[2];
+		const __m256 rw    = rotate[3];
+
+		const __m256 zero  = _mm256_setzero_ps();
+		const __m256 one   = _mm256_set1_ps(1.0f);
+		const __m256 two   = _mm256_set1_ps(2.0f);
+
+		const __m256 xx2   = _mm256_mul_ps(two,   _mm256_mul_ps(rx, rx) );
+		const __m256 yy2   = _mm256_mul_ps(two,   _mm256_mul_ps(ry, ry) );
+		const __m256 zz2   = _mm256_mul_ps(two,   _mm256_mul_ps(rz, rz) );
+		const __m256 yx2   = _mm256_mul_ps(two,   _mm256_mul_ps(ry, rx) );
+		const __m256 yz2   = _mm256_mul_ps(two,   _mm256_mul_ps(ry, rz) );
+		const __m256 yw2   = _mm256_mul_ps(two,   _mm256_mul_ps(ry, rw) );
+		const __m256 wz2   = _mm256_mul_ps(two,   _mm256_mul_ps(rw, rz) );
+		const __m256 wx2   = _mm256_mul_ps(two,   _mm256_mul_ps(rw, rx) );
+		const __m256 xz2   = _mm256_mul_ps(two,   _mm256_mul_ps(rx, rz) );
+		const __m256 r0x   = _mm256_sub_ps(_mm256_sub_ps(one, yy2), zz2);
+		const __m256 r0y   = _mm256_add_ps(yx2,   wz2);
+		const __m256 r0z   = _mm256_sub_ps(xz2,   yw2);
+		const __m256 r1x   = _mm256_sub_ps(yx2,   wz2);
+		const __m256 omxx2 = _mm256_sub_ps(one,   xx2);
+		const __m256 r1y   = _mm256_sub_ps(omxx2, zz2);
+		const __m256 r1z   = _mm256_add_ps(yz2,   wx2);
+		const __m256 r2x   = _mm256_add_ps(xz2,   yw2);
+		const __m256 r2y   = _mm256_sub_ps(yz2,   wx2);
+		const __m256 r2z   = _mm256_sub_ps(omxx2, yy2);
+
+		__m256 tmp[4];
+		tmp[0] = _mm256_mul_ps(r0x, scale[0]);
+		tmp[1] = _mm256_mul_ps(r0y, scale[0]);
+		tmp[2] = _mm256_mul_ps(r0z, scale[0]);
+		tmp[3] = zero;
+		mtxStoreRow_x8(dst, 0, tmp);
+
+		tmp[0] = _mm256_mul_ps(r1x, scale[1]);
+		tmp[1] = _mm256_mul_ps(r1y, scale[1]);
+		tmp[2] = _mm256_mul_ps(r1z, scale[1]);
+		tmp[3] = zero;
+		mtxStoreRow_x8(dst, 1, tmp);
+
+		tmp[0] = _mm256_mul_ps(r2x, scale[2]);
+		tmp[1] = _mm256_mul_ps(r2y, scale[2]);
+		tmp[2] = _mm256_mul_ps(r2z, scale[2]);
+		tmp[3] = zero;
+		mtxStoreRow_x8(dst, 2, tmp);
+
+		tmp[0] = translate[0];
+		tmp[1] = translate[1];
+		tmp[2] = translate[2];
+		tmp[3] = one;
+		mtxStoreRow_x8(dst, 3, tmp);
+	}
+
+	// Two matrix rows per iteration, parent rows are broadcast to both lanes.
+	BGFX_TARGET_AVX2 void mtxMulPalette_Avx2(void* _dst, const void* _src, const float* _parent, uint32_t _num)
+	{
+		      float* dst = reinterpret_cast<      float*>(_dst);
+		const float* src = reinterpret_cast<const float*>(_src);
+
+		__m256 parent[4];
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			const __m128 row = _mm_loadu_ps(&_parent[ii*4]);
+			parent[ii] = _mm256_insertf128_ps(_mm256_castps128_ps256(row), row, 1);
+		}
+
+		for (uint32_t ii = 0, num = _num*16; ii < num; ii += 8)
+		{
+			const __m256 row  = _mm256_loadu_ps(&src[ii]);
+			const __m256 xxxx = _mm256_permute_ps(row, _MM_SHUFFLE(0, 0, 0, 0) );
+			const __m256 yyyy = _mm256_permute_ps(row, _MM_SHUFFLE(1, 1, 1, 1) );
+			const __m256 zzzz = _mm256_permute_ps(row, _MM_SHUFFLE(2, 2, 2, 2) );
+			const __m256 wwww = _mm256_permute_ps(row, _MM_SHUFFLE(3, 3, 3, 3) );
+			const __m256 tmp0 = _mm256_mul_ps(wwww, parent[3]);
+			const __m256 tmp1 = _mm256_add_ps(_mm256_mul_ps(zzzz, parent[2]), tmp0);
+			const __m256 tmp2 = _mm256_add_ps(_mm256_mul_ps(yyyy, parent[1]), tmp1);
+			const __m256 tmp3 = _mm256_add_ps(_mm256_mul_ps(xxxx, parent[0]), tmp2);
+			_mm256_storeu_ps(&dst[ii], tmp3);
+		}
+	}
+#endif // BGFX_CONFIG_SIMD_AVX2
+
+	void srtToMatrix4(void* _dst, const void* _src, uint32_t _num)
+	{
+		      uint8_t* dst = reinterpret_cast<      uint8_t*>(_dst);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(_src);
+
+#if BGFX_CONFIG_SIMD_AVX2
+		if (s_simdAvx2
+		&&  bx::isAligned(src, 16)
+		&&  bx::isAligned(dst, 16) )
+		{
+			for (uint32_t ii = 0, num = _num / 8; ii < num; ++ii)
+			{
+				srtToMatrix4_x8_Avx2(dst, src);
+				src += 8*sizeof(Srt);
+				dst += 8*sizeof(Matrix4);
+			}
+
+			_num &= 7;
+		}
+#endif // BGFX_CONFIG_SIMD_AVX2
+
+		if (!bx::isAligned(src, 16)
+		||  !bx::isAligned(dst, 16) )
+		{
+			for (uint32_t ii = 0, num = _num / 4; ii < num; ++ii)
+			{
+				srtToMatrix4_x4_Ref(dst, src);
+				src += 4*sizeof(Srt);
+				dst += 4*sizeof(Matrix4);
+			}
+		}
+		else
+		{
+			for (uint32_t ii = 0, num = _num / 4; ii < num; ++ii)
 			{
 				srtToMatrix4_x4_Simd(dst, src);
 				src += 4*sizeof(Srt);
@@ -1164,6 +2092,62 @@ namespace bgfx
 		}
 	}
 
+	void mtxMulPalette_Simd(void* _dst, const void* _src, const float* _parent, uint32_t _num)
+	{
+		using namespace bx;
+
+		      simd128_t* dst = reinterpret_cast<      simd128_t*>(_dst);
+		const simd128_t* src = reinterpret_cast<const simd128_t*>(_src);
+
+		Matrix4 parent;
+		bx::memCopy(parent.un.val, _parent, sizeof(Matrix4) );
+
+		const simd128_t p0 = simd_ld<simd128_t>(&parent.un.val[ 0]);
+		const simd128_t p1 = simd_ld<simd128_t>(&parent.un.val[ 4]);
+		const simd128_t p2 = simd_ld<simd128_t>(&parent.un.val[ 8]);
+		const simd128_t p3 = simd_ld<simd128_t>(&parent.un.val[12]);
+
+		for (uint32_t ii = 0, num = _num*4; ii < num; ++ii)
+		{
+			const simd128_t row  = simd_ld<simd128_t>(src + ii);
+			const simd128_t xxxx = simd_swiz_xxxx(row);
+			const simd128_t yyyy = simd_swiz_yyyy(row);
+			const simd128_t zzzz = simd_swiz_zzzz(row);
+			const simd128_t wwww = simd_swiz_wwww(row);
+			const simd128_t tmp0 = simd_mul(wwww, p3);
+			const simd128_t tmp1 = simd_madd(zzzz, p2, tmp0);
+			const simd128_t tmp2 = simd_madd(yyyy, p1, tmp1);
+			const simd128_t tmp3 = simd_madd(xxxx, p0, tmp2);
+			simd_st(dst + ii, tmp3);
+		}
+	}
+
+	void mtxMulPalette(void* _dst, const void* _src, const void* _parent, uint32_t _num)
+	{
+		      Matrix4* dst = reinterpret_cast<      Matrix4*>(_dst);
+		const Matrix4* src = reinterpret_cast<const Matrix4*>(_src);
+
+#if BGFX_CONFIG_SIMD_AVX2
+		if (s_simdAvx2)
+		{
+			mtxMulPalette_Avx2(dst, src, (const float*)_parent, _num);
+			return;
+		}
+#endif // BGFX_CONFIG_SIMD_AVX2
+
+		if (bx::isAligned(src, 16)
+		&&  bx::isAligned(dst, 16) )
+		{
+			mtxMulPalette_Simd(dst, src, (const float*)_parent, _num);
+			return;
+		}
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			bx::mtxMul(dst[ii].un.val, src[ii].un.val, (const float*)_parent);
+		}
+	}
+
 	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
@@ -1196,8 +2180,15 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		if (NULL != m_drawBundle)
+		{
+			BX_CHECK(!isValid(_occlusionQuery), "Occlusion query can't be recorded into draw bundle.");
+			record(_program, _depth, _preserveState);
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard();
 			++m_numDropped;
@@ -1227,33 +2218,12 @@ namespace bgfx
 
 		uint64_t key = m_key.encodeDraw(type);
 
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		m_frame->m_sortRun[m_uniformIdx].add(key, RenderItemCount(renderItemIdx) );
 
 		m_draw.m_uniformIdx   = m_uniformIdx;
 		m_draw.m_uniformBegin = m_uniformBegin;
 		m_draw.m_uniformEnd   = m_uniformEnd;
-
-		if (UINT8_MAX != m_draw.m_streamMask)
-		{
-			uint32_t numVertices = UINT32_MAX;
-			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
-				; 0 != streamMask
-				; streamMask >>= 1, idx += 1
-				)
-			{
-				const uint32_t ntz = bx::uint32_cnttz(streamMask);
-				streamMask >>= ntz;
-				idx         += ntz;
-				numVertices = bx::min(numVertices, m_numVertices[idx]);
-			}
-
-			m_draw.m_numVertices = numVertices;
-		}
-		else
-		{
-			m_draw.m_numVertices = m_numVertices[0];
-		}
+		m_draw.m_numVertices  = getNumVertices();
 
 		if (isValid(_occlusionQuery) )
 		{
@@ -1262,807 +2232,2152 @@ namespace bgfx
 		}
 
 		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+		m_frame->m_renderItemBind[renderItemIdx]  = internBind();
 
 		if (!_preserveState)
 		{
 			m_draw.clear();
-			m_bind.clear();
+			clearBind();
+			m_key.m_material = 0;
 			m_uniformBegin = m_uniformEnd;
 		}
 	}
 
-	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ)
+	void EncoderImpl::submitBatch(ViewId _id, ProgramHandle _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState)
 	{
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		if (NULL != m_drawBundle)
+		{
+			// Recording is done once, there is no per submit overhead to save.
+			const RenderDraw draw = m_draw;
+			const float* mtx = (const float*)_mtx;
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				if (NULL != mtx)
+				{
+					setTransform(&mtx[ii*16], 1);
+				}
+
+				m_draw.m_startIndex = draw.m_startIndex + (NULL != _startIndex ? _startIndex[ii] : 0);
+				m_draw.m_numIndices = NULL != _numIndices ? _numIndices[ii] : draw.m_numIndices;
+
+				OcclusionQueryHandle handle = BGFX_INVALID_HANDLE;
+				submit(_id, _program, handle, NULL != _depth ? _depth[ii] : 0, true);
+			}
+
+			if (!_preserveState)
+			{
+				discard();
+				m_uniformBegin = m_uniformEnd;
+			}
+			else
+			{
+				m_draw.m_startIndex = draw.m_startIndex;
+				m_draw.m_numIndices = draw.m_numIndices;
+			}
+
+			return;
+		}
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
+		&& !_preserveState)
 		{
 			m_uniformSet.clear();
 		}
 
-		if (m_discard)
+		if (m_discard
+		||  0 == _num)
 		{
 			discard();
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		if (0 == m_draw.m_numVertices
+		&&  0 == m_draw.m_numIndices
+		&&  NULL == _numIndices)
 		{
 			discard();
-			++m_numDropped;
+			m_numDropped += _num;
 			return;
 		}
 
-		++m_numSubmitted;
+		uint32_t first = 0;
+		const uint32_t num = allocRenderItems(_num, &first);
+		m_numDropped += _num - num;
+
+		if (0 == num)
+		{
+			discard();
+			return;
+		}
+
+		m_numSubmitted += num;
+
+		MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+		uint16_t numMatrices = 0;
+		uint32_t firstMatrix = 0;
+		if (NULL != _mtx)
+		{
+			numMatrices = uint16_t(num);
+			firstMatrix = matrixCache.reserve(&numMatrices);
+			bx::memCopy(&matrixCache.m_cache[firstMatrix], _mtx, numMatrices*sizeof(Matrix4) );
+		}
 
 		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 		m_uniformEnd = uniformBuffer->getPos();
 
-		m_compute.m_startMatrix = m_draw.m_startMatrix;
-		m_compute.m_numMatrices = m_draw.m_numMatrices;
-		m_compute.m_numX   = bx::max(_numX, 1u);
-		m_compute.m_numY   = bx::max(_numY, 1u);
-		m_compute.m_numZ   = bx::max(_numZ, 1u);
+		m_key.m_program = isValid(_program)
+			? _program
+			: ProgramHandle{0}
+			;
 
-		m_key.m_program = _handle;
-		m_key.m_depth   = 0;
-		m_key.m_view    = _id;
-		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+		m_key.m_view = _id;
 
-		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		m_draw.m_uniformIdx   = m_uniformIdx;
+		m_draw.m_uniformBegin = m_uniformBegin;
+		m_draw.m_uniformEnd   = m_uniformEnd;
+		m_draw.m_numVertices  = getNumVertices();
 
-		m_compute.m_uniformIdx   = m_uniformIdx;
-		m_compute.m_uniformBegin = m_uniformBegin;
-		m_compute.m_uniformEnd   = m_uniformEnd;
-		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
-		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+		const uint8_t viewMode = s_ctx->m_view[_id].m_mode;
 
-		m_compute.clear();
-		m_bind.clear();
-		m_uniformBegin = m_uniformEnd;
-	}
+		SortRun& sortRun = m_frame->m_sortRun[m_uniformIdx];
+		sortRun.reserve(num);
 
-	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
-	{
-		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
-			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
-			, BGFX_CONFIG_MAX_BLIT_ITEMS
-			);
-		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		const RenderItemCount bindIdx = internBind();
+
+		for (uint32_t ii = 0; ii < num; ++ii)
 		{
-			uint16_t item = m_frame->m_numBlitItems++;
+			const uint32_t depth = NULL != _depth ? _depth[ii] : 0;
 
-			BlitItem& bi = m_frame->m_blitItem[item];
-			bi.m_srcX    = _srcX;
-			bi.m_srcY    = _srcY;
-			bi.m_srcZ    = _srcZ;
-			bi.m_dstX    = _dstX;
-			bi.m_dstY    = _dstY;
-			bi.m_dstZ    = _dstZ;
-			bi.m_width   = _width;
-			bi.m_height  = _height;
-			bi.m_depth   = _depth;
-			bi.m_srcMip  = _srcMip;
-			bi.m_dstMip  = _dstMip;
-			bi.m_src     = _src;
-			bi.m_dst     = _dst;
+			SortKey::Enum type = SortKey::SortProgram;
+			switch (viewMode)
+			{
+			case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
+			case ViewMode::DepthAscending:  m_key.m_depth =            depth;       type = SortKey::SortDepth;    break;
+			case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-depth;       type = SortKey::SortDepth;    break;
+			default: break;
+			}
 
-			BlitKey key;
-			key.m_view = _id;
-			key.m_item = item;
-			m_frame->m_blitKeys[item] = key.encode();
+			const uint32_t renderItemIdx = first + ii;
+			sortRun.add(m_key.encodeDraw(type), RenderItemCount(renderItemIdx) );
+
+			RenderDraw& draw = m_frame->m_renderItem[renderItemIdx].draw;
+			draw = m_draw;
+
+			if (NULL != _mtx)
+			{
+				const bool valid = ii < numMatrices;
+				draw.m_startMatrix = valid ? firstMatrix + ii : 0;
+				draw.m_numMatrices = 1;
+			}
+
+			if (NULL != _startIndex)
+			{
+				draw.m_startIndex += _startIndex[ii];
+			}
+
+			if (NULL != _numIndices)
+			{
+				draw.m_numIndices = _numIndices[ii];
+			}
+
+			m_frame->m_renderItemBind[renderItemIdx] = bindIdx;
+		}
+
+		if (!_preserveState)
+		{
+			m_draw.clear();
+			clearBind();
+			m_key.m_material = 0;
+			m_uniformBegin = m_uniformEnd;
 		}
 	}
 
-	void Frame::sort()
+	void EncoderImpl::record(ProgramHandle _program, uint32_t _depth, bool _preserveState)
 	{
-		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+		UniformBuffer* uniformBuffer = m_drawBundle->m_uniformBuffer;
+		m_uniformEnd = uniformBuffer->getPos();
 
-		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		SortKey key = m_key;
+		key.m_program = isValid(_program)
+			? _program
+			: ProgramHandle{0}
+			;
+		key.m_depth = _depth;
+
+		m_draw.m_uniformIdx   = UINT8_MAX;
+		m_draw.m_uniformBegin = m_uniformBegin;
+		m_draw.m_uniformEnd   = m_uniformEnd;
+		m_draw.m_numVertices  = getNumVertices();
+
+		m_drawBundle->add(key, m_draw, m_bind, m_dynamic);
+
+		if (!_preserveState)
 		{
-			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+			m_draw.clear();
+			clearBind();
+			m_dynamic.clear();
+			m_key.m_material = 0;
+			m_uniformBegin = m_uniformEnd;
 		}
+	}
+
+	// Bundle doesn't hold references to resources it uses, item is dropped
+	// from replay if any of its resources was destroyed.
+	static bool isDrawBundleItemValid(const DrawBundle& _drawBundle, uint32_t _item)
+	{
+		const RenderDraw& draw = _drawBundle.m_draw[_item];
+		const RenderBind& bind = _drawBundle.m_bind[_drawBundle.m_bindIdx[_item] ];
+		const DrawBundle::Dynamic& dynamic = _drawBundle.m_dynamic[_item];
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		if (!s_ctx->m_programHandle.isValid(_drawBundle.m_key[_item].m_program.idx) )
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			return false;
 		}
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
 
-		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		if (0 != (dynamic.m_mask & 1) )
 		{
-			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+			if (!s_ctx->m_dynamicIndexBufferHandle.isValid(dynamic.m_indexBuffer) )
+			{
+				return false;
+			}
+		}
+		else if (isValid(draw.m_indexBuffer)
+			 &&  !s_ctx->m_indexBufferHandle.isValid(draw.m_indexBuffer.idx) )
+		{
+			return false;
 		}
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
-	}
 
-	RenderFrame::Enum renderFrame(int32_t _msecs)
-	{
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
 		{
-			if (s_renderFrameCalled)
+			if (0 != (dynamic.m_mask & (2<<ii) ) )
 			{
-				BGFX_CHECK_RENDER_THREAD();
+				if (!s_ctx->m_dynamicVertexBufferHandle.isValid(dynamic.m_vertexBuffer[ii]) )
+				{
+					return false;
+				}
 			}
-
-			if (NULL == s_ctx)
+			else if (0 != (draw.m_streamMask & (1<<ii) )
+				 &&  isValid(draw.m_stream[ii].m_handle)
+				 &&  !s_ctx->m_vertexBufferHandle.isValid(draw.m_stream[ii].m_handle.idx) )
 			{
-				s_renderFrameCalled = true;
-				s_threadIndex = ~BGFX_API_THREAD_MAGIC;
-				return RenderFrame::NoContext;
+				return false;
 			}
+		}
 
-			int32_t msecs = -1 == _msecs
-				? BGFX_CONFIG_API_SEMAPHORE_TIMEOUT
-				: _msecs
-				;
-			RenderFrame::Enum result = s_ctx->renderFrame(msecs);
-			if (RenderFrame::Exiting == result)
+		if ( (isValid(draw.m_instanceDataBuffer) && !s_ctx->m_vertexBufferHandle.isValid(draw.m_instanceDataBuffer.idx) )
+		||   (isValid(draw.m_indirectBuffer)     && !s_ctx->m_vertexBufferHandle.isValid(draw.m_indirectBuffer.idx) ) )
+		{
+			return false;
+		}
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		{
+			const Binding& binding = bind.m_bind[ii];
+			if (kInvalidHandle == binding.m_idx)
 			{
-				Context* ctx = s_ctx;
-				ctx->apiSemWait();
-				s_ctx = NULL;
-				ctx->renderSemPost();
+				continue;
 			}
 
-			return result;
+			bool valid = false;
+			switch (binding.m_type)
+			{
+			case Binding::Image:
+			case Binding::Texture:      valid = s_ctx->m_textureHandle.isValid(binding.m_idx);      break;
+			case Binding::IndexBuffer:  valid = s_ctx->m_indexBufferHandle.isValid(binding.m_idx);  break;
+			case Binding::VertexBuffer: valid = s_ctx->m_vertexBufferHandle.isValid(binding.m_idx); break;
+			default: break;
+			}
+
+			if (!valid)
+			{
+				return false;
+			}
 		}
 
-		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");
-		return RenderFrame::NoContext;
+		return true;
 	}
 
-	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
+	// Builds list of items replayed on submit. It's done when recording ends,
+	// and again at frame swap after resource handles are freed, before they
+	// can be reused.
+	static void validateDrawBundle(DrawBundle& _drawBundle)
 	{
-		sizeof(int32_t),
-		0,
-		4*sizeof(float),
-		3*3*sizeof(float),
-		4*4*sizeof(float),
-		1,
-	};
+		uint32_t numValid = 0;
+		for (uint32_t ii = 0, num = _drawBundle.m_num; ii < num; ++ii)
+		{
+			if (isDrawBundleItemValid(_drawBundle, ii) )
+			{
+				_drawBundle.m_valid[numValid++] = ii;
+			}
+		}
 
-	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
-	{
-		uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
-		write(opcode);
-		write(_value, g_uniformTypeSize[_type]*_num);
+		BX_WARN(numValid == _drawBundle.m_num
+			, "Draw bundle has %d items using destroyed resources, items are dropped."
+			, _drawBundle.m_num - numValid
+			);
+		_drawBundle.m_numValid = numValid;
 	}
 
-	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	static void resolveDrawBundleDynamic(RenderDraw& _draw, const DrawBundle::Dynamic& _dynamic)
 	{
-		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
-		write(opcode);
-		write(&_handle, sizeof(UniformHandle) );
-	}
+		if (0 != (_dynamic.m_mask & 1) )
+		{
+			const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_dynamic.m_indexBuffer];
+			_draw.m_indexBuffer = dib.m_handle;
+			_draw.m_startIndex  = _draw.m_startIndex - _dynamic.m_startIndex + dib.m_startIndex;
+		}
 
-	void UniformBuffer::writeMarker(const char* _marker)
-	{
-		uint16_t num = (uint16_t)bx::strLen(_marker)+1;
-		uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
-		write(opcode);
-		write(_marker, num);
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
+		{
+			if (0 != (_dynamic.m_mask & (2<<ii) ) )
+			{
+				const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_dynamic.m_vertexBuffer[ii]];
+				Stream& stream = _draw.m_stream[ii];
+				stream.m_handle      = dvb.m_handle;
+				stream.m_startVertex = stream.m_startVertex - _dynamic.m_startVertex[ii] + dvb.m_startVertex;
+			}
+		}
 	}
 
-	struct CapsFlags
+	void EncoderImpl::endDrawBundle()
 	{
-		uint64_t m_flag;
-		const char* m_str;
-	};
+		BX_CHECK(NULL != m_drawBundle, "Draw bundle recording is not in progress.");
 
-	static const CapsFlags s_capsFlags[] =
-	{
-#define CAPS_FLAGS(_x) { _x, #_x }
-		CAPS_FLAGS(BGFX_CAPS_ALPHA_TO_COVERAGE),
-		CAPS_FLAGS(BGFX_CAPS_BLEND_INDEPENDENT),
-		CAPS_FLAGS(BGFX_CAPS_COMPUTE),
-		CAPS_FLAGS(BGFX_CAPS_CONSERVATIVE_RASTER),
-		CAPS_FLAGS(BGFX_CAPS_DRAW_INDIRECT),
-		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_DEPTH),
-		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_ORDERING),
-		CAPS_FLAGS(BGFX_CAPS_GRAPHICS_DEBUGGER),
-		CAPS_FLAGS(BGFX_CAPS_HDR10),
-		CAPS_FLAGS(BGFX_CAPS_HIDPI),
-		CAPS_FLAGS(BGFX_CAPS_INDEX32),
-		CAPS_FLAGS(BGFX_CAPS_INSTANCING),
-		CAPS_FLAGS(BGFX_CAPS_OCCLUSION_QUERY),
-		CAPS_FLAGS(BGFX_CAPS_RENDERER_MULTITHREADED),
-		CAPS_FLAGS(BGFX_CAPS_SWAP_CHAIN),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_2D_ARRAY),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_3D),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_BLIT),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_ALL),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_LEQUAL),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_CUBE_ARRAY),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_DIRECT_ACCESS),
-		CAPS_FLAGS(BGFX_CAPS_TEXTURE_READ_BACK),
-		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_HALF),
-		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_UINT10),
-		CAPS_FLAGS(BGFX_CAPS_VERTEX_ID),
-#undef CAPS_FLAGS
-	};
+		discard();
 
-	static void dumpCaps()
+		if (0 != m_drawBundle->m_serial
+		&&  m_drawBundleSerial == m_drawBundle->m_serial)
+		{
+			m_drawBundle->finish();
+			validateDrawBundle(*m_drawBundle);
+		}
+		else
+		{
+			BX_WARN(false, "Draw bundle was destroyed while recording, recording is dropped.");
+		}
+
+		m_drawBundle   = NULL;
+		m_uniformBegin = m_frame->m_uniformBuffer[m_uniformIdx]->getPos();
+		m_uniformEnd   = m_uniformBegin;
+	}
+
+	void EncoderImpl::submit(ViewId _id, const DrawBundle& _drawBundle, const void* _mtx, uint16_t _num)
 	{
-		BX_TRACE("");
+		BX_CHECK(NULL == m_drawBundle, "Draw bundle can't be submitted while recording draw bundle.");
 
-		if (0 < g_caps.numGPUs)
+		discard();
+
+		if (0 == _drawBundle.m_serial)
 		{
-			BX_TRACE("Detected GPUs (%d):", g_caps.numGPUs);
-			BX_TRACE("\t +----------------   Index");
-			BX_TRACE("\t |  +-------------   Device ID");
-			BX_TRACE("\t |  |    +--------   Vendor ID");
-			for (uint32_t ii = 0; ii < g_caps.numGPUs; ++ii)
-			{
-				const Caps::GPU& gpu = g_caps.gpu[ii];
-				BX_UNUSED(gpu);
+			BX_WARN(false, "Draw bundle is destroyed, submit is ignored.");
+			return;
+		}
 
-				BX_TRACE("\t %d: %04x %04x"
-					, ii
-					, gpu.deviceId
-					, gpu.vendorId
-					);
-			}
+		if (NULL != _mtx
+		&&  1 != _num
+		&&  _drawBundle.m_num != _num)
+		{
+			BX_WARN(false
+				, "Number of transforms (%d) must be 1, or number of items in draw bundle (%d), submit is ignored."
+				, _num
+				, _drawBundle.m_num
+				);
+			return;
+		}
 
-			BX_TRACE("");
+		const uint32_t numItems = _drawBundle.m_numValid;
+		if (0 == numItems)
+		{
+			return;
 		}
 
-		RendererType::Enum renderers[RendererType::Count];
-		uint8_t num = getSupportedRenderers(BX_COUNTOF(renderers), renderers);
+		// Uniform stream of bundle is position independent, it's appended to
+		// encoder's uniform buffer and item uniform ranges are rebased.
+		const uint32_t uniformSize = _drawBundle.m_uniformBuffer->getPos();
+		UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx], uniformSize + (64<<10), BX_ALIGN_16(uniformSize) + (1<<20) );
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		const uint32_t uniformBase = uniformBuffer->getPos();
+		uniformBuffer->write(_drawBundle.m_uniformBuffer->getData(), uniformSize);
+		m_uniformBegin = uniformBuffer->getPos();
+		m_uniformEnd   = m_uniformBegin;
 
-		BX_TRACE("Supported renderer backends (%d):", num);
-		for (uint32_t ii = 0; ii < num; ++ii)
+		// Transforms recorded into bundle are copied into frame matrix cache,
+		// or multiplied by base transform, or replaced with per item transform.
+		MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+		const bool perItem = NULL != _mtx && 1 != _num;
+		uint16_t numMatrices = uint16_t(perItem ? _drawBundle.m_num : _drawBundle.m_numMatrix);
+		const uint32_t firstMatrix = matrixCache.reserve(&numMatrices);
+
+		if (NULL == _mtx)
 		{
-			BX_TRACE("\t - %s", getRendererName(renderers[ii]) );
+			bx::memCopy(&matrixCache.m_cache[firstMatrix], _drawBundle.m_matrix, numMatrices*sizeof(Matrix4) );
+		}
+		else if (perItem)
+		{
+			bx::memCopy(&matrixCache.m_cache[firstMatrix], _mtx, numMatrices*sizeof(Matrix4) );
+		}
+		else
+		{
+			mtxMulPalette(&matrixCache.m_cache[firstMatrix], _drawBundle.m_matrix, _mtx, numMatrices);
 		}
 
-		BX_TRACE("");
-		BX_TRACE("Sort key masks:");
-		BX_TRACE("\t   View     %016" PRIx64, kSortKeyViewMask);
-		BX_TRACE("\t   Draw bit %016" PRIx64, kSortKeyDrawBit);
-
-		BX_TRACE("");
-		BX_TRACE("\tD  Type     %016" PRIx64, kSortKeyDrawTypeMask);
+		uint16_t scissor[BGFX_CONFIG_MAX_RECT_CACHE];
+		for (uint32_t ii = 0, num = _drawBundle.m_numRect; ii < num; ++ii)
+		{
+			const Rect& rect = _drawBundle.m_rect[ii];
+			scissor[ii] = uint16_t(m_frame->m_frameCache.m_rectCache.add(rect.m_x, rect.m_y, rect.m_width, rect.m_height) );
+		}
 
-		BX_TRACE("");
-		BX_TRACE("\tD0 Trans    %016" PRIx64, kSortKeyDraw0TransMask);
-		BX_TRACE("\tD0 Program  %016" PRIx64, kSortKeyDraw0ProgramMask);
-		BX_TRACE("\tD0 Depth    %016" PRIx64, kSortKeyDraw0DepthMask);
+		uint32_t renderItemIdx = 0;
+		const uint32_t num = allocRenderItems(numItems, &renderItemIdx);
+		m_numSubmitted += num;
+		m_numDropped   += numItems - num;
 
-		BX_TRACE("");
-		BX_TRACE("\tD1 Depth    %016" PRIx64, kSortKeyDraw1DepthMask);
-		BX_TRACE("\tD1 Trans    %016" PRIx64, kSortKeyDraw1TransMask);
-		BX_TRACE("\tD1 Program  %016" PRIx64, kSortKeyDraw1ProgramMask);
+		// Unique bindings of bundle are copied into frame bind table at once.
+		// Bind table can't hold more bindings than there are render items, if
+		// bundle doesn't fit whole, bindings are interned per item.
+		uint32_t bindBase = UINT32_MAX;
+		if (num == numItems
+		&&  _drawBundle.m_numBind <= num)
+		{
+			bindBase = bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numRenderBinds, _drawBundle.m_numBind);
+			bx::memCopy(&m_frame->m_renderBind[bindBase], _drawBundle.m_bind, _drawBundle.m_numBind*sizeof(RenderBind) );
+		}
 
-		BX_TRACE("");
-		BX_TRACE("\tD2 Seq      %016" PRIx64, kSortKeyDraw2SeqMask);
-		BX_TRACE("\tD2 Trans    %016" PRIx64, kSortKeyDraw2TransMask);
-		BX_TRACE("\tD2 Program  %016" PRIx64, kSortKeyDraw2ProgramMask);
+		const uint8_t viewMode = s_ctx->m_view[_id].m_mode;
 
-		BX_TRACE("");
-		BX_TRACE("\t C Seq      %016" PRIx64, kSortKeyComputeSeqMask);
-		BX_TRACE("\t C Program  %016" PRIx64, kSortKeyComputeProgramMask);
+		SortRun& sortRun = m_frame->m_sortRun[m_uniformIdx];
+		sortRun.reserve(num);
 
-		BX_TRACE("");
-		BX_TRACE("Supported capabilities (renderer %s, vendor 0x%04x, device 0x%04x):"
-				, s_ctx->m_renderCtx->getRendererName()
-				, g_caps.vendorId
-				, g_caps.deviceId
-				);
-		for (uint32_t ii = 0; ii < BX_COUNTOF(s_capsFlags); ++ii)
+		for (uint32_t ii = 0; ii < num; ++ii, ++renderItemIdx)
 		{
-			if (0 != (g_caps.supported & s_capsFlags[ii].m_flag) )
+			const uint32_t item = _drawBundle.m_valid[ii];
+
+			SortKey key = _drawBundle.m_key[item];
+			key.m_view = _id;
+
+			SortKey::Enum type = SortKey::SortProgram;
+			switch (viewMode)
 			{
-				BX_TRACE("\t%s", s_capsFlags[ii].m_str);
+			case ViewMode::Sequential:      key.m_seq   = s_ctx->getSeqIncr(_id);    type = SortKey::SortSequence; break;
+			case ViewMode::DepthAscending:                                           type = SortKey::SortDepth;    break;
+			case ViewMode::DepthDescending: key.m_depth = UINT32_MAX-key.m_depth;    type = SortKey::SortDepth;    break;
+			default: break;
 			}
-		}
 
-		BX_TRACE("");
-		BX_TRACE("Limits:");
-#define LIMITS(_x) BX_TRACE("\t%-24s %d", #_x, g_caps.limits._x)
-		LIMITS(maxDrawCalls);
-		LIMITS(maxBlits);
-		LIMITS(maxTextureSize);
-		LIMITS(maxTextureLayers);
-		LIMITS(maxViews);
-		LIMITS(maxFrameBuffers);
-		LIMITS(maxFBAttachments);
-		LIMITS(maxPrograms);
-		LIMITS(maxShaders);
-		LIMITS(maxTextures);
-		LIMITS(maxTextureSamplers);
-		LIMITS(maxComputeBindings);
-		LIMITS(maxVertexLayouts);
-		LIMITS(maxVertexStreams);
-		LIMITS(maxIndexBuffers);
-		LIMITS(maxVertexBuffers);
-		LIMITS(maxDynamicIndexBuffers);
-		LIMITS(maxDynamicVertexBuffers);
-		LIMITS(maxUniforms);
-		LIMITS(maxOcclusionQueries);
-		LIMITS(maxEncoders);
-		LIMITS(transientVbSize);
-		LIMITS(transientIbSize);
-#undef LIMITS
+			sortRun.add(key.encodeDraw(type), RenderItemCount(renderItemIdx) );
 
-		BX_TRACE("");
-		BX_TRACE("Supported texture formats:");
-		BX_TRACE("\t +----------------   2D: x = supported / * = emulated");
-		BX_TRACE("\t |+---------------   2D: sRGB format");
-		BX_TRACE("\t ||+--------------   3D: x = supported / * = emulated");
-		BX_TRACE("\t |||+-------------   3D: sRGB format");
-		BX_TRACE("\t ||||+------------ Cube: x = supported / * = emulated");
-		BX_TRACE("\t |||||+----------- Cube: sRGB format");
-		BX_TRACE("\t ||||||+---------- vertex format");
-		BX_TRACE("\t |||||||+--------- image");
-		BX_TRACE("\t ||||||||+-------- framebuffer");
-		BX_TRACE("\t |||||||||+------- MSAA framebuffer");
-		BX_TRACE("\t ||||||||||+------ MSAA texture");
-		BX_TRACE("\t |||||||||||+----- Auto-generated mips");
-		BX_TRACE("\t ||||||||||||  +-- name");
-		for (uint32_t ii = 0; ii < TextureFormat::Count; ++ii)
-		{
-			if (TextureFormat::Unknown != ii
-			&&  TextureFormat::UnknownDepth != ii)
+			RenderDraw& draw = m_frame->m_renderItem[renderItemIdx].draw;
+			draw = _drawBundle.m_draw[item];
+			draw.m_uniformIdx    = m_uniformIdx;
+			draw.m_uniformBegin += uniformBase;
+			draw.m_uniformEnd   += uniformBase;
+
+			if (0 != _drawBundle.m_numDynamic)
 			{
-				uint16_t flags = g_caps.formats[ii];
-				BX_TRACE("\t[%c%c%c%c%c%c%c%c%c%c%c%c] %s"
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED ? '*' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB          ? 'l' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED ? '*' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB          ? 'l' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE             ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED ? '*' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB        ? 'l' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_VERTEX           ? 'v' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_IMAGE            ? 'i' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER      ? 'f' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA ? '+' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_MSAA             ? 'm' : ' '
-					, flags&BGFX_CAPS_FORMAT_TEXTURE_MIP_AUTOGEN      ? 'M' : ' '
-					, getName(TextureFormat::Enum(ii) )
-					);
-				BX_UNUSED(flags);
+				resolveDrawBundleDynamic(draw, _drawBundle.m_dynamic[item]);
 			}
-		}
 
-		BX_TRACE("");
-		BX_TRACE("NDC depth [%d, 1], origin %s left."
-			, g_caps.homogeneousDepth ? -1 : 0
-			, g_caps.originBottomLeft ? "bottom" : "top"
-			);
+			if (perItem)
+			{
+				draw.m_startMatrix = firstMatrix + item;
+				draw.m_numMatrices = 1;
+			}
+			else
+			{
+				draw.m_startMatrix += firstMatrix;
+			}
+
+			if (draw.m_startMatrix + draw.m_numMatrices > firstMatrix + numMatrices)
+			{
+				draw.m_startMatrix = 0;
+				draw.m_numMatrices = 1;
+			}
+
+			if (UINT16_MAX != draw.m_scissor)
+			{
+				draw.m_scissor = scissor[draw.m_scissor];
+			}
+
+			const uint32_t bindIdx = _drawBundle.m_bindIdx[item];
+			m_frame->m_renderItemBind[renderItemIdx] = UINT32_MAX != bindBase
+				? RenderItemCount(bindBase + bindIdx)
+				: internBind(_drawBundle.m_bind[bindIdx])
+				;
+		}
+	}
+
+	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			m_uniformSet.clear();
+		}
+
+		BX_CHECK(NULL == m_drawBundle, "Compute dispatch can't be recorded into draw bundle.");
+
+		if (m_discard
+		||  NULL != m_drawBundle)
+		{
+			discard();
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard();
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_compute.m_startMatrix = m_draw.m_startMatrix;
+		m_compute.m_numMatrices = m_draw.m_numMatrices;
+		m_compute.m_numX   = bx::max(_numX, 1u);
+		m_compute.m_numY   = bx::max(_numY, 1u);
+		m_compute.m_numZ   = bx::max(_numZ, 1u);
+
+		m_key.m_program = _handle;
+		m_key.m_depth   = 0;
+		m_key.m_view    = _id;
+		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+
+		uint64_t key = m_key.encodeCompute();
+		m_frame->m_sortRun[m_uniformIdx].add(key, RenderItemCount(renderItemIdx) );
+
+		m_compute.m_uniformIdx   = m_uniformIdx;
+		m_compute.m_uniformBegin = m_uniformBegin;
+		m_compute.m_uniformEnd   = m_uniformEnd;
+		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
+		m_frame->m_renderItemBind[renderItemIdx]     = internBind();
+
+		m_compute.clear();
+		clearBind();
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	{
+		BX_CHECK(NULL == m_drawBundle, "Blit can't be recorded into draw bundle.");
+		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
+			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
+			, BGFX_CONFIG_MAX_BLIT_ITEMS
+			);
+		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			uint16_t item = m_frame->m_numBlitItems++;
+
+			BlitItem& bi = m_frame->m_blitItem[item];
+			bi.m_srcX    = _srcX;
+			bi.m_srcY    = _srcY;
+			bi.m_srcZ    = _srcZ;
+			bi.m_dstX    = _dstX;
+			bi.m_dstY    = _dstY;
+			bi.m_dstZ    = _dstZ;
+			bi.m_width   = _width;
+			bi.m_height  = _height;
+			bi.m_depth   = _depth;
+			bi.m_srcMip  = _srcMip;
+			bi.m_dstMip  = _dstMip;
+			bi.m_src     = _src;
+			bi.m_dst     = _dst;
+
+			BlitKey key;
+			key.m_view = _id;
+			key.m_item = item;
+			m_frame->m_blitKeys[item] = key.encode();
+		}
+	}
+
+	void SortRun::sort(uint64_t* _tempKeys, RenderItemCount* _tempValues)
+	{
+		if (m_sorted == m_num)
+		{
+			return;
+		}
+
+		const uint32_t num = m_num - m_sorted;
+		bx::radixSort(&m_keys[m_sorted], _tempKeys, &m_values[m_sorted], _tempValues, num);
+
+		if (0 != m_sorted)
+		{
+			// Merge keys sorted on previous close with new tail. On equal keys
+			// older item goes first to keep submission order.
+			uint32_t ii = 0;
+			uint32_t jj = m_sorted;
+			uint32_t kk = 0;
+
+			while (ii < m_sorted
+			&&     jj < m_num)
+			{
+				const uint32_t src = m_keys[jj] < m_keys[ii] ? jj++ : ii++;
+				_tempKeys[kk]   = m_keys[src];
+				_tempValues[kk] = m_values[src];
+				++kk;
+			}
+
+			for (; ii < m_sorted; ++ii, ++kk)
+			{
+				_tempKeys[kk]   = m_keys[ii];
+				_tempValues[kk] = m_values[ii];
+			}
+
+			// Remaining tail is already in place.
+			bx::memCopy(m_keys,   _tempKeys,   kk*sizeof(uint64_t) );
+			bx::memCopy(m_values, _tempValues, kk*sizeof(RenderItemCount) );
+		}
+
+		m_sorted = m_num;
+
+		// View is in most significant bits of sort key, find where each view
+		// starts in the sorted run so that runs can be merged view by view.
+		uint32_t item = 0;
+		for (uint32_t view = 0; view < BGFX_CONFIG_MAX_VIEWS; ++view)
+		{
+			m_viewOffset[view] = item;
+
+			while (item < m_num
+			&&     view == SortKey::decodeView(m_keys[item]) )
+			{
+				++item;
+			}
+		}
+
+		m_viewOffset[BGFX_CONFIG_MAX_VIEWS] = m_num;
+	}
+
+	void EncoderImpl::sortRun()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Encoder sort", 0xff2040ff);
+
+		SortRun& run = m_frame->m_sortRun[m_uniformIdx];
+		if (0 == run.m_num)
+		{
+			return;
+		}
+
+		if (m_tempMax < run.m_num)
+		{
+			m_tempMax    = run.m_max;
+			m_tempKeys   = (uint64_t*       )BX_REALLOC(g_allocator, m_tempKeys,   m_tempMax*sizeof(uint64_t) );
+			m_tempValues = (RenderItemCount*)BX_REALLOC(g_allocator, m_tempValues, m_tempMax*sizeof(RenderItemCount) );
+		}
+
+		const int64_t timeBegin = bx::getHPCounter();
+		run.sort(m_tempKeys, m_tempValues);
+		run.m_cpuTimeSort += bx::getHPCounter() - timeBegin;
+	}
+
+	struct SortRunCursor
+	{
+		const uint64_t*        keys;
+		const RenderItemCount* values;
+		uint32_t               num;
+		uint32_t               run;
+	};
+
+	static bool sortRunCursorLess(const SortRunCursor& _a, const SortRunCursor& _b)
+	{
+		return _a.keys[0] < _b.keys[0]
+			|| (_a.keys[0] == _b.keys[0] && _a.run < _b.run)
+			;
+	}
+
+	static void siftDown(SortRunCursor* _heap, uint32_t _num, uint32_t _idx)
+	{
+		for (uint32_t child = _idx*2+1; child < _num; _idx = child, child = _idx*2+1)
+		{
+			if (child+1 < _num
+			&&  sortRunCursorLess(_heap[child+1], _heap[child]) )
+			{
+				++child;
+			}
+
+			if (!sortRunCursorLess(_heap[child], _heap[_idx]) )
+			{
+				break;
+			}
+
+			bx::swap(_heap[_idx], _heap[child]);
+		}
+	}
+
+	static uint32_t mergeRuns(uint64_t* _keys, RenderItemCount* _values, SortRunCursor* _heap, uint32_t _num, uint64_t _view)
+	{
+		uint32_t item = 0;
+
+		if (1 == _num)
+		{
+			const SortRunCursor& cursor = _heap[0];
+			for (; item < cursor.num; ++item)
+			{
+				_keys[item]   = (cursor.keys[item] & ~kSortKeyViewMask) | _view;
+				_values[item] = cursor.values[item];
+			}
+
+			return item;
+		}
+
+		for (uint32_t ii = _num/2; 0 < ii--;)
+		{
+			siftDown(_heap, _num, ii);
+		}
+
+		while (0 < _num)
+		{
+			SortRunCursor& top = _heap[0];
+			_keys[item]   = (top.keys[0] & ~kSortKeyViewMask) | _view;
+			_values[item] = top.values[0];
+			++item;
+
+			++top.keys;
+			++top.values;
+			--top.num;
+
+			if (0 == top.num)
+			{
+				--_num;
+				top = _heap[_num];
+			}
+
+			siftDown(_heap, _num, 0);
+		}
+
+		return item;
+	}
+
+	static bool isMergeable(const Binding& _a, const Binding& _b)
+	{
+		return _a.m_idx  == _b.m_idx
+			&& _a.m_type == _b.m_type
+			&& (kInvalidHandle == _a.m_idx
+			|| (_a.m_samplerFlags == _b.m_samplerFlags
+			&&  _a.m_format       == _b.m_format
+			&&  _a.m_access       == _b.m_access
+			&&  _a.m_mip          == _b.m_mip) )
+			;
+	}
+
+	static bool isMergeable(const RenderDraw& _a, const RenderDraw& _b)
+	{
+		const uint64_t pt = _a.m_stateFlags & BGFX_STATE_PT_MASK;
+
+		if (!isValid(_a.m_indexBuffer)
+		||  _a.m_indexBuffer.idx != _b.m_indexBuffer.idx
+		||  UINT32_MAX == _a.m_numIndices
+		||  UINT32_MAX == _b.m_numIndices
+		||  _a.m_startIndex + _a.m_numIndices != _b.m_startIndex
+		||  BGFX_STATE_PT_TRISTRIP  == pt
+		||  BGFX_STATE_PT_LINESTRIP == pt
+		||  _a.m_stateFlags  != _b.m_stateFlags
+		||  _a.m_stencil     != _b.m_stencil
+		||  _a.m_rgba        != _b.m_rgba
+		||  _a.m_scissor     != _b.m_scissor
+		||  _a.m_startMatrix != _b.m_startMatrix
+		||  _a.m_numMatrices != _b.m_numMatrices
+		||  _a.m_submitFlags != _b.m_submitFlags
+		||  _a.m_streamMask  != _b.m_streamMask
+		||  _a.m_numVertices != _b.m_numVertices
+		||  1 != _a.m_numInstances
+		||  1 != _b.m_numInstances
+		||  isValid(_a.m_instanceDataBuffer)
+		||  isValid(_b.m_instanceDataBuffer)
+		||  isValid(_a.m_indirectBuffer)
+		||  isValid(_b.m_indirectBuffer)
+		||  isValid(_a.m_occlusionQuery)
+		||  isValid(_b.m_occlusionQuery) )
+		{
+			return false;
+		}
+
+		// Uniforms are applied in draw order, item without uniforms keeps
+		// what previous item set.
+		if (_b.m_uniformBegin != _b.m_uniformEnd
+		&& (_a.m_uniformIdx   != _b.m_uniformIdx
+		||  _a.m_uniformBegin != _b.m_uniformBegin
+		||  _a.m_uniformEnd   != _b.m_uniformEnd) )
+		{
+			return false;
+		}
+
+		for (uint32_t idx = 0, streamMask = _a.m_streamMask
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1
+			)
+		{
+			const uint32_t ntz = bx::uint32_cnttz(streamMask);
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const Stream& sa = _a.m_stream[idx];
+			const Stream& sb = _b.m_stream[idx];
+			if (sa.m_handle.idx       != sb.m_handle.idx
+			||  sa.m_layoutHandle.idx != sb.m_layoutHandle.idx
+			||  sa.m_startVertex      != sb.m_startVertex)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	uint32_t Frame::mergeDraws()
+	{
+		const uint32_t numItems = m_numRenderItems;
+		if (2 > numItems)
+		{
+			return 0;
+		}
+
+		SortKey key;
+		key.decode(m_sortKeys[0], m_viewRemap);
+		ProgramHandle program = key.m_program;
+
+		uint32_t num = 1;
+
+		for (uint32_t ii = 1; ii < numItems; ++ii)
+		{
+			const uint64_t encodedKey = m_sortKeys[ii];
+			const uint64_t prevKey    = m_sortKeys[num-1];
+			const RenderItemCount itemIdx = m_sortValues[ii];
+			const RenderItemCount prevIdx = m_sortValues[num-1];
+
+			const bool isCompute = key.decode(encodedKey, m_viewRemap);
+			const bool sameProgram = program.idx == key.m_program.idx;
+			program = key.m_program;
+
+			if (!isCompute
+			&&  sameProgram
+			&&  0 != (prevKey & kSortKeyDrawBit)
+			&&  (prevKey & kSortKeyViewMask) == (encodedKey & kSortKeyViewMask) )
+			{
+				RenderDraw&       prev = m_renderItem[prevIdx].draw;
+				const RenderDraw& draw = m_renderItem[itemIdx].draw;
+
+				if (isMergeable(prev, draw) )
+				{
+					bool mergeable = m_renderItemBind[prevIdx] == m_renderItemBind[itemIdx];
+					if (!mergeable)
+					{
+						const RenderBind& prevBind = getRenderBind(prevIdx);
+						const RenderBind& bind     = getRenderBind(itemIdx);
+
+						mergeable = true;
+						for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS && mergeable; ++stage)
+						{
+							mergeable = isMergeable(prevBind.m_bind[stage], bind.m_bind[stage]);
+						}
+					}
+
+					if (mergeable)
+					{
+						prev.m_numIndices += draw.m_numIndices;
+						continue;
+					}
+				}
+			}
+
+			m_sortKeys[num]   = encodedKey;
+			m_sortValues[num] = itemIdx;
+			++num;
+		}
+
+		m_numRenderItems = num;
+
+		return numItems - num;
+	}
+
+	void Frame::sort()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+
+		const int64_t timeBegin = bx::getHPCounter();
+
+		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+		}
+
+		// Runs are already sorted by encoders. View remapping changes order of
+		// views only, so runs are merged per view in remapped view order.
+		const uint32_t numRuns = g_caps.limits.maxEncoders;
+		SortRunCursor* heap = (SortRunCursor*)alloca(numRuns*sizeof(SortRunCursor) );
+
+		uint32_t numItems = 0;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			const ViewId view = m_viewRemap[ii];
+			if (ii != viewRemap[view])
+			{
+				continue;
+			}
+
+			uint32_t num = 0;
+			for (uint32_t run = 0; run < numRuns; ++run)
+			{
+				const SortRun& sortRun = m_sortRun[run];
+				const uint32_t begin   = sortRun.m_viewOffset[view];
+				const uint32_t end     = sortRun.m_viewOffset[view+1];
+
+				if (0 != sortRun.m_num
+				&&  begin < end)
+				{
+					SortRunCursor& cursor = heap[num++];
+					cursor.keys   = &sortRun.m_keys[begin];
+					cursor.values = &sortRun.m_values[begin];
+					cursor.num    = end - begin;
+					cursor.run    = run;
+				}
+			}
+
+			if (0 < num)
+			{
+				numItems += mergeRuns(
+					  &m_sortKeys[numItems]
+					, &m_sortValues[numItems]
+					, heap
+					, num
+					, uint64_t(ii) << kSortKeyViewBitShift
+					);
+			}
+		}
+
+		// Encoders reserve render items in blocks, unused slots in those blocks
+		// don't have sort key in any run and they are skipped by merge.
+		m_numRenderItems = numItems;
+
+		m_perfStats.numDrawsMerged = s_ctx->m_init.mergeDraws
+			? mergeDraws()
+			: 0
+			;
+
+		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		{
+			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+		}
+		bx::radixSort(m_blitKeys, s_ctx->m_tempBlitKeys, m_numBlitItems);
+
+		// Most of sorting is done by encoders, their time is added to time
+		// spent merging runs.
+		int64_t cpuTimeSort = bx::getHPCounter() - timeBegin;
+		for (uint32_t ii = 0; ii < numRuns; ++ii)
+		{
+			cpuTimeSort += m_sortRun[ii].m_cpuTimeSort;
+		}
+
+		m_perfStats.cpuTimeSort = cpuTimeSort;
+	}
+
+	RenderFrame::Enum renderFrame(int32_t _msecs)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		{
+			if (s_renderFrameCalled)
+			{
+				BGFX_CHECK_RENDER_THREAD();
+			}
+
+			if (NULL == s_ctx)
+			{
+				s_renderFrameCalled = true;
+				s_threadIndex = ~BGFX_API_THREAD_MAGIC;
+				return RenderFrame::NoContext;
+			}
+
+			int32_t msecs = -1 == _msecs
+				? BGFX_CONFIG_API_SEMAPHORE_TIMEOUT
+				: _msecs
+				;
+			RenderFrame::Enum result = s_ctx->renderFrame(msecs);
+			if (RenderFrame::Exiting == result)
+			{
+				Context* ctx = s_ctx;
+				ctx->apiSemWait();
+				s_ctx = NULL;
+				ctx->renderSemPost();
+			}
+
+			return result;
+		}
+
+		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");
+		return RenderFrame::NoContext;
+	}
+
+	const uint32_t g_uniformTypeSize[UniformType::Count+2] =
+	{
+		sizeof(int32_t),
+		0,
+		4*sizeof(float),
+		3*3*sizeof(float),
+		4*4*sizeof(float),
+		1,
+		16,
+	};
+
+	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
+		write(opcode);
+		write(_value, g_uniformTypeSize[_type]*_num);
+	}
+
+	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(&_handle, sizeof(UniformHandle) );
+	}
+
+	void UniformBuffer::writeUniformBlock(uint16_t _idx, const void* _data, uint32_t _size)
+	{
+		static const uint8_t s_zero[16] = { 0 };
+
+		const uint16_t num = uint16_t( (_size+15)/16);
+		uint32_t opcode = encodeOpcode(kBlockType, _idx, num, true);
+		write(opcode);
+		write(_data, _size);
+		write(s_zero, num*16 - _size);
+	}
+
+	void UniformBuffer::writeMarker(const char* _marker)
+	{
+		uint16_t num = (uint16_t)bx::strLen(_marker)+1;
+		uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
+		write(opcode);
+		write(_marker, num);
+	}
+
+	void UniformBuffer::removeUniform(uint16_t _loc)
+	{
+		for (uint32_t pos = 0; pos < m_pos;)
+		{
+			uint32_t opcode;
+			bx::memCopy(&opcode, &m_buffer[pos], sizeof(uint32_t) );
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			decodeOpcode(opcode, type, loc, num, copy);
+
+			const uint32_t size = sizeof(uint32_t) + g_uniformTypeSize[type]*num;
+
+			if (UniformType::Count > type
+			&&  _loc == loc)
+			{
+				bx::memMove(&m_buffer[pos], &m_buffer[pos+size], m_pos-pos-size);
+				m_pos -= size;
+			}
+			else
+			{
+				pos += size;
+			}
+		}
+	}
+
+	struct CapsFlags
+	{
+		uint64_t m_flag;
+		const char* m_str;
+	};
+
+	static const CapsFlags s_capsFlags[] =
+	{
+#define CAPS_FLAGS(_x) { _x, #_x }
+		CAPS_FLAGS(BGFX_CAPS_ALPHA_TO_COVERAGE),
+		CAPS_FLAGS(BGFX_CAPS_BLEND_INDEPENDENT),
+		CAPS_FLAGS(BGFX_CAPS_COMPUTE),
+		CAPS_FLAGS(BGFX_CAPS_CONSERVATIVE_RASTER),
+		CAPS_FLAGS(BGFX_CAPS_DRAW_INDIRECT),
+		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_DEPTH),
+		CAPS_FLAGS(BGFX_CAPS_FRAGMENT_ORDERING),
+		CAPS_FLAGS(BGFX_CAPS_GRAPHICS_DEBUGGER),
+		CAPS_FLAGS(BGFX_CAPS_HDR10),
+		CAPS_FLAGS(BGFX_CAPS_HIDPI),
+		CAPS_FLAGS(BGFX_CAPS_INDEX32),
+		CAPS_FLAGS(BGFX_CAPS_INSTANCING),
+		CAPS_FLAGS(BGFX_CAPS_OCCLUSION_QUERY),
+		CAPS_FLAGS(BGFX_CAPS_RENDERER_MULTITHREADED),
+		CAPS_FLAGS(BGFX_CAPS_SWAP_CHAIN),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_2D_ARRAY),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_3D),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_BLIT),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_ALL),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_LEQUAL),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_CUBE_ARRAY),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_DIRECT_ACCESS),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_READ_BACK),
+		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_HALF),
+		CAPS_FLAGS(BGFX_CAPS_VERTEX_ATTRIB_UINT10),
+		CAPS_FLAGS(BGFX_CAPS_VERTEX_ID),
+#undef CAPS_FLAGS
+	};
+
+	static void dumpCaps()
+	{
+		BX_TRACE("");
+
+		if (0 < g_caps.numGPUs)
+		{
+			BX_TRACE("Detected GPUs (%d):", g_caps.numGPUs);
+			BX_TRACE("\t +----------------   Index");
+			BX_TRACE("\t |  +-------------   Device ID");
+			BX_TRACE("\t |  |    +--------   Vendor ID");
+			for (uint32_t ii = 0; ii < g_caps.numGPUs; ++ii)
+			{
+				const Caps::GPU& gpu = g_caps.gpu[ii];
+				BX_UNUSED(gpu);
+
+				BX_TRACE("\t %d: %04x %04x"
+					, ii
+					, gpu.deviceId
+					, gpu.vendorId
+					);
+			}
+
+			BX_TRACE("");
+		}
+
+		RendererType::Enum renderers[RendererType::Count];
+		uint8_t num = getSupportedRenderers(BX_COUNTOF(renderers), renderers);
+
+		BX_TRACE("Supported renderer backends (%d):", num);
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			BX_TRACE("\t - %s", getRendererName(renderers[ii]) );
+		}
+
+		BX_TRACE("");
+		BX_TRACE("Sort key masks:");
+		BX_TRACE("\t   View     %016" PRIx64, kSortKeyViewMask);
+		BX_TRACE("\t   Draw bit %016" PRIx64, kSortKeyDrawBit);
+
+		BX_TRACE("");
+		BX_TRACE("\tD  Type     %016" PRIx64, kSortKeyDrawTypeMask);
+
+		BX_TRACE("");
+		BX_TRACE("\tD0 Trans    %016" PRIx64, kSortKeyDraw0TransMask);
+		BX_TRACE("\tD0 Program  %016" PRIx64, kSortKeyDraw0ProgramMask);
+		BX_TRACE("\tD0 Depth    %016" PRIx64, kSortKeyDraw0DepthMask);
+
+		BX_TRACE("");
+		BX_TRACE("\tD1 Depth    %016" PRIx64, kSortKeyDraw1DepthMask);
+		BX_TRACE("\tD1 Trans    %016" PRIx64, kSortKeyDraw1TransMask);
+		BX_TRACE("\tD1 Program  %016" PRIx64, kSortKeyDraw1ProgramMask);
+
+		BX_TRACE("");
+		BX_TRACE("\tD2 Seq      %016" PRIx64, kSortKeyDraw2SeqMask);
+		BX_TRACE("\tD2 Trans    %016" PRIx64, kSortKeyDraw2TransMask);
+		BX_TRACE("\tD2 Program  %016" PRIx64, kSortKeyDraw2ProgramMask);
+
+		BX_TRACE("");
+		BX_TRACE("\t C Seq      %016" PRIx64, kSortKeyComputeSeqMask);
+		BX_TRACE("\t C Program  %016" PRIx64, kSortKeyComputeProgramMask);
+
+		BX_TRACE("");
+		BX_TRACE("Supported capabilities (renderer %s, vendor 0x%04x, device 0x%04x):"
+				, s_ctx->m_renderCtx->getRendererName()
+				, g_caps.vendorId
+				, g_caps.deviceId
+				);
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_capsFlags); ++ii)
+		{
+			if (0 != (g_caps.supported & s_capsFlags[ii].m_flag) )
+			{
+				BX_TRACE("\t%s", s_capsFlags[ii].m_str);
+			}
+		}
+
+		BX_TRACE("");
+		BX_TRACE("Limits:");
+#define LIMITS(_x) BX_TRACE("\t%-24s %d", #_x, g_caps.limits._x)
+		LIMITS(maxDrawCalls);
+		LIMITS(maxBlits);
+		LIMITS(maxTextureSize);
+		LIMITS(maxTextureLayers);
+		LIMITS(maxViews);
+		LIMITS(maxFrameBuffers);
+		LIMITS(maxFBAttachments);
+		LIMITS(maxPrograms);
+		LIMITS(maxShaders);
+		LIMITS(maxTextures);
+		LIMITS(maxTextureSamplers);
+		LIMITS(maxComputeBindings);
+		LIMITS(maxVertexLayouts);
+		LIMITS(maxVertexStreams);
+		LIMITS(maxIndexBuffers);
+		LIMITS(maxVertexBuffers);
+		LIMITS(maxDynamicIndexBuffers);
+		LIMITS(maxDynamicVertexBuffers);
+		LIMITS(maxUniforms);
+		LIMITS(maxOcclusionQueries);
+		LIMITS(maxEncoders);
+		LIMITS(transientVbSize);
+		LIMITS(transientIbSize);
+		LIMITS(maxTransforms);
+#undef LIMITS
+
+		BX_TRACE("");
+		BX_TRACE("Supported texture formats:");
+		BX_TRACE("\t +----------------   2D: x = supported / * = emulated");
+		BX_TRACE("\t |+---------------   2D: sRGB format");
+		BX_TRACE("\t ||+--------------   3D: x = supported / * = emulated");
+		BX_TRACE("\t |||+-------------   3D: sRGB format");
+		BX_TRACE("\t ||||+------------ Cube: x = supported / * = emulated");
+		BX_TRACE("\t |||||+----------- Cube: sRGB format");
+		BX_TRACE("\t ||||||+---------- vertex format");
+		BX_TRACE("\t |||||||+--------- image");
+		BX_TRACE("\t ||||||||+-------- framebuffer");
+		BX_TRACE("\t |||||||||+------- MSAA framebuffer");
+		BX_TRACE("\t ||||||||||+------ MSAA texture");
+		BX_TRACE("\t |||||||||||+----- Auto-generated mips");
+		BX_TRACE("\t ||||||||||||  +-- name");
+		for (uint32_t ii = 0; ii < TextureFormat::Count; ++ii)
+		{
+			if (TextureFormat::Unknown != ii
+			&&  TextureFormat::UnknownDepth != ii)
+			{
+				uint16_t flags = g_caps.formats[ii];
+				BX_TRACE("\t[%c%c%c%c%c%c%c%c%c%c%c%c] %s"
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED ? '*' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_2D_SRGB          ? 'l' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D               ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED ? '*' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_3D_SRGB          ? 'l' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE             ? 'x' : flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED ? '*' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB        ? 'l' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_VERTEX           ? 'v' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_IMAGE            ? 'i' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER      ? 'f' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA ? '+' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_MSAA             ? 'm' : ' '
+					, flags&BGFX_CAPS_FORMAT_TEXTURE_MIP_AUTOGEN      ? 'M' : ' '
+					, getName(TextureFormat::Enum(ii) )
+					);
+				BX_UNUSED(flags);
+			}
+		}
+
+		BX_TRACE("");
+		BX_TRACE("NDC depth [%d, 1], origin %s left."
+			, g_caps.homogeneousDepth ? -1 : 0
+			, g_caps.originBottomLeft ? "bottom" : "top"
+			);
 
 		BX_TRACE("");
 	}
 
-	TextureFormat::Enum getViableTextureFormat(const bimg::ImageContainer& _imageContainer)
+	TextureFormat::Enum getViableTextureFormat(const bimg::ImageContainer& _imageContainer)
+	{
+		const uint32_t formatCaps = g_caps.formats[_imageContainer.m_format];
+		bool convert = 0 == formatCaps;
+
+		if (_imageContainer.m_cubeMap)
+		{
+			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE)
+					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED)
+					;
+		}
+		else if (_imageContainer.m_depth > 1)
+		{
+			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D)
+					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED)
+					;
+		}
+		else
+		{
+			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D)
+					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED)
+					;
+		}
+
+		if (convert)
+		{
+			return TextureFormat::BGRA8;
+		}
+
+		return TextureFormat::Enum(_imageContainer.m_format);
+	}
+
+	const char* getName(TextureFormat::Enum _fmt)
+	{
+		return bimg::getName(bimg::TextureFormat::Enum(_fmt));
+	}
+
+	const char* getName(UniformHandle _handle)
+	{
+		return s_ctx->m_uniformRef[_handle.idx].m_name.getPtr();
+	}
+
+	static const char* s_topologyName[] =
+	{
+		"Triangles",
+		"TriStrip",
+		"Lines",
+		"LineStrip",
+		"Points",
+	};
+	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_topologyName) );
+
+	const char* getName(Topology::Enum _topology)
+	{
+		return s_topologyName[bx::min(_topology, Topology::PointList)];
+	}
+
+	const char* getShaderTypeName(uint32_t _magic)
+	{
+		if (isShaderType(_magic, 'C') )
+		{
+			return "Compute";
+		}
+		else if (isShaderType(_magic, 'F') )
+		{
+			return "Fragment";
+		}
+		else if (isShaderType(_magic, 'V') )
+		{
+			return "Vertex";
+		}
+
+		BX_CHECK(false, "Invalid shader type!");
+
+		return NULL;
+	}
+
+	static TextureFormat::Enum s_emulatedFormats[] =
+	{
+		TextureFormat::BC1,
+		TextureFormat::BC2,
+		TextureFormat::BC3,
+		TextureFormat::BC4,
+		TextureFormat::BC5,
+		TextureFormat::ETC1,
+		TextureFormat::ETC2,
+		TextureFormat::ETC2A,
+		TextureFormat::ETC2A1,
+		TextureFormat::PTC12,
+		TextureFormat::PTC14,
+		TextureFormat::PTC12A,
+		TextureFormat::PTC14A,
+		TextureFormat::PTC22,
+		TextureFormat::PTC24,
+		TextureFormat::ATC,
+		TextureFormat::ATCE,
+		TextureFormat::ATCI,
+		TextureFormat::ASTC4x4,
+		TextureFormat::ASTC5x5,
+		TextureFormat::ASTC6x6,
+		TextureFormat::ASTC8x5,
+		TextureFormat::ASTC8x6,
+		TextureFormat::ASTC10x5,
+		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
+		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
+	};
+
+	bool Context::init(const Init& _init)
+	{
+		BX_CHECK(!m_rendererInitialized, "Already initialized?");
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - API Thread");
+
+#if BGFX_CONFIG_SIMD_AVX2
+		s_simdAvx2 = cpuHasAvx2();
+		BX_TRACE("AVX2 transform kernels: %s", s_simdAvx2 ? "enabled" : "disabled");
+#endif // BGFX_CONFIG_SIMD_AVX2
+
+		m_init = _init;
+		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
+
+		if (g_platformData.ndt          == NULL
+		&&  g_platformData.nwh          == NULL
+		&&  g_platformData.context      == NULL
+		&&  g_platformData.backBuffer   == NULL
+		&&  g_platformData.backBufferDS == NULL)
+		{
+			bx::memCopy(&g_platformData, &m_init.platformData, sizeof(PlatformData) );
+		}
+		else
+		{
+			bx::memCopy(&m_init.platformData, &g_platformData, sizeof(PlatformData) );
+		}
+
+		m_exit    = false;
+		m_flipped = true;
+		m_frames  = 0;
+		m_debug   = BGFX_DEBUG_NONE;
+		m_transientVbMaxUsed = 0;
+		m_transientIbMaxUsed = 0;
+		m_transformsMaxUsed    = 0;
+		m_rectsMaxUsed         = 0;
+		m_uniformBufferMaxUsed = 0;
+		m_cmdBufferMaxUsed     = 0;
+		m_frameTimeLast = bx::getHPCounter();
+
+#if BGFX_CONFIG_MULTITHREADED
+		if (s_renderFrameCalled)
+		{
+			// When bgfx::renderFrame is called before init render thread
+			// should not be created.
+			BX_TRACE("Application called bgfx::renderFrame directly, not creating render thread.");
+			m_singleThreaded = true
+				&& ~BGFX_API_THREAD_MAGIC == s_threadIndex
+				;
+		}
+		else
+		{
+			BX_TRACE("Creating rendering thread.");
+			m_thread.init(renderThread, this, 0, "bgfx - renderer backend thread");
+			m_singleThreaded = false;
+		}
+#else
+		BX_TRACE("Multithreaded renderer is disabled.");
+		m_singleThreaded = true;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		BX_TRACE("Running in %s-threaded mode", m_singleThreaded ? "single" : "multi");
+
+		// Running ahead of render thread doesn't make sense when frames are
+		// rendered from API thread.
+		m_numFrames = BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
+			? (m_singleThreaded ? 2 : _init.limits.numFrames)
+			: 1
+			;
+		m_submitIdx   = 0;
+		m_renderIdx   = 0;
+		m_renderedIdx = 0;
+		m_submit = &m_frame[0];
+		m_render = &m_frame[0];
+
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			m_frame[ii].create();
+		}
+
+		m_transformBuffer = (Matrix4*)BX_ALIGNED_ALLOC(g_allocator, BGFX_CONFIG_MAX_PERSISTENT_TRANSFORMS*sizeof(Matrix4), 16);
+		m_transformBufferAllocator.add(0, BGFX_CONFIG_MAX_PERSISTENT_TRANSFORMS*sizeof(Matrix4) );
+		m_transformBufferUsed = 0;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT; ++ii)
+		{
+			m_transformBufferDirtyBegin[ii] = UINT32_MAX;
+			m_transformBufferDirtyEnd[ii]   = 0;
+		}
+
+		BX_TRACE("Frames in flight: %d", m_numFrames);
+
+		s_threadIndex = BGFX_API_THREAD_MAGIC;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_viewRemap); ++ii)
+		{
+			m_viewRemap[ii] = ViewId(ii);
+		}
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			resetView(ViewId(ii) );
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_clearColor); ++ii)
+		{
+			m_clearColor[ii][0] = 0.0f;
+			m_clearColor[ii][1] = 0.0f;
+			m_clearColor[ii][2] = 0.0f;
+			m_clearColor[ii][3] = 1.0f;
+		}
+
+		m_vertexLayoutRef.init();
+
+		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
+		cmdbuf.write(_init);
+
+		// Each frame in flight past the first two is a free slot the API
+		// thread can submit into without waiting for render thread.
+		for (uint32_t ii = 2; ii < m_numFrames; ++ii)
+		{
+			renderSemPost();
+		}
+
+		frameNoRenderWait();
+
+		m_encoder      = (EncoderImpl*)BX_ALLOC(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders);
+		m_encoderStats = (EncoderStats*)BX_ALLOC(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
+		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
+		{
+			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
+		}
+
+		m_numEncoders = 1;
+#if BGFX_CONFIG_MULTITHREADED
+		m_encoderActive = 0;
+		m_encoderEpoch  = s_encoderEpoch;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_encoder[0].begin(m_submit, 0);
+		m_encoder0 = reinterpret_cast<Encoder*>(&m_encoder[0]);
+
+		// Make sure renderer init is called from render thread.
+		// g_caps is initialized and available after this point.
+		frame();
+
+		if (!m_rendererInitialized)
+		{
+			getCommandBuffer(CommandBuffer::RendererShutdownEnd);
+			frame();
+
+			// Wait for all queued frames except the last one, next frame
+			// call waits for the last one.
+			for (uint32_t ii = 2; ii < m_numFrames; ++ii)
+			{
+				renderSemWait();
+			}
+
+			frame();
+			m_vertexLayoutRef.shutdown(m_layoutHandle);
+
+			for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+			{
+				m_frame[ii].destroy();
+			}
+
+			CommandBuffer::destroyBlockPool();
+
+			return false;
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
+		{
+			const uint32_t fmt = s_emulatedFormats[ii];
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+		}
+
+		for (uint32_t ii = 0; ii < TextureFormat::UnknownDepth; ++ii)
+		{
+			bool convertable = bimg::imageConvert(bimg::TextureFormat::BGRA8, bimg::TextureFormat::Enum(ii) );
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+		}
+
+		g_caps.rendererType = m_renderCtx->getRendererType();
+		initAttribTypeSizeTable(g_caps.rendererType);
+
+		g_caps.supported |= 0
+			| (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) && !m_singleThreaded ? BGFX_CAPS_RENDERER_MULTITHREADED : 0)
+			| (isGraphicsDebuggerPresent() ? BGFX_CAPS_GRAPHICS_DEBUGGER : 0)
+			;
+
+		dumpCaps();
+
+		m_textVideoMemBlitter.init();
+		m_clearQuad.init();
+
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
+			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+			frame();
+		}
+
+		g_internalData.caps = getCaps();
+
+		return true;
+	}
+
+	void Context::shutdown()
 	{
-		const uint32_t formatCaps = g_caps.formats[_imageContainer.m_format];
-		bool convert = 0 == formatCaps;
+		m_frameTraceWriter.stop();
+		m_frameTraceReader.close();
 
-		if (_imageContainer.m_cubeMap)
+		textureAsyncShutdown();
+
+		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
+		frame();
+
+		destroyTransientVertexBuffer(m_submit->m_transientVb);
+		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		destroyTransientBufferPages(m_submit);
+		m_textVideoMemBlitter.shutdown();
+		m_clearQuad.shutdown();
+		frame();
+
+		for (uint32_t ii = 1; ii < m_numFrames; ++ii)
 		{
-			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE)
-					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED)
-					;
+			destroyTransientVertexBuffer(m_submit->m_transientVb);
+			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			destroyTransientBufferPages(m_submit);
+			frame();
 		}
-		else if (_imageContainer.m_depth > 1)
+
+		frame(); // If any VertexLayouts needs to be destroyed.
+
+		getCommandBuffer(CommandBuffer::RendererShutdownEnd);
+		frame();
+
+		m_encoder[0].end(true);
+
+#if BGFX_CONFIG_MULTITHREADED
+		s_encoderEpoch = m_encoderEpoch + 1;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 		{
-			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D)
-					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED)
-					;
+			m_encoder[ii].~EncoderImpl();
 		}
-		else
+		BX_FREE(g_allocator, m_encoder);
+		BX_FREE(g_allocator, m_encoderStats);
+
+		for (uint16_t ii = 0, num = m_drawBundleHandle.getNumHandles(); ii < num; ++ii)
 		{
-			convert |= 0 == (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D)
-					&& 0 != (formatCaps & BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED)
-					;
+			m_drawBundle[m_drawBundleHandle.getHandleAt(ii)].destroy();
+		}
+
+		BX_CHECK(m_layoutHandle.getNumHandles() == m_vertexLayoutRef.m_layoutMap.getNumElements()
+				, "VertexLayoutRef mismatch, num handles %d, handles in hash map %d."
+				, m_layoutHandle.getNumHandles()
+				, m_vertexLayoutRef.m_layoutMap.getNumElements()
+				);
+
+		m_vertexLayoutRef.shutdown(m_layoutHandle);
+		m_frameTraceWriter.shutdown();
+
+#if BGFX_CONFIG_MULTITHREADED
+		// Render thread shutdown sequence.
+		for (uint32_t ii = 1; ii < m_numFrames; ++ii)
+		{
+			renderSemWait(); // Wait for all frames in flight.
+		}
+
+		apiSemPost();   // OK to set context to NULL.
+		// s_ctx is NULL here.
+		renderSemWait(); // In RenderFrame::Exiting state.
+
+		if (m_thread.isRunning() )
+		{
+			m_thread.shutdown();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
+		s_ctx = NULL;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			clearViewUniforms(ViewId(ii) );
+		}
+
+		for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+		{
+			m_frame[ii].destroy();
+		}
+
+		m_transformBufferAllocator.reset();
+		BX_ALIGNED_FREE(g_allocator, m_transformBuffer, 16);
+		m_transformBuffer = NULL;
+
+		CommandBuffer::destroyBlockPool();
+		profilerShutdown();
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+		{
+#define CHECK_HANDLE_LEAK(_name, _handleAlloc)                                        \
+	BX_MACRO_BLOCK_BEGIN                                                              \
+		if (0 != _handleAlloc.getNumHandles() )                                       \
+		{                                                                             \
+			BX_TRACE("LEAK: %s %d (max: %d)"                                          \
+				, _name                                                               \
+				, _handleAlloc.getNumHandles()                                        \
+				, _handleAlloc.getMaxHandles()                                        \
+				);                                                                    \
+			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
+			{                                                                         \
+				BX_TRACE("\t%3d: %4d", ii, _handleAlloc.getHandleAt(ii) );            \
+			}                                                                         \
+		}                                                                             \
+	BX_MACRO_BLOCK_END
+
+#define CHECK_HANDLE_LEAK_NAME(_name, _handleAlloc, _type, _ref)                      \
+	BX_MACRO_BLOCK_BEGIN                                                              \
+		if (0 != _handleAlloc.getNumHandles() )                                       \
+		{                                                                             \
+			BX_TRACE("LEAK: %s %d (max: %d)"                                          \
+				, _name                                                               \
+				, _handleAlloc.getNumHandles()                                        \
+				, _handleAlloc.getMaxHandles()                                        \
+				);                                                                    \
+			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
+			{                                                                         \
+				uint16_t idx = _handleAlloc.getHandleAt(ii);                          \
+				const _type& ref = _ref[idx]; BX_UNUSED(ref);                         \
+				BX_TRACE("\t%3d: %4d %s"                                              \
+					, ii                                                              \
+					, idx                                                             \
+					, ref.m_name.getPtr()                                             \
+					);                                                                \
+			}                                                                         \
+		}                                                                             \
+	BX_MACRO_BLOCK_END
+
+#define CHECK_HANDLE_LEAK_RC_NAME(_name, _handleAlloc, _type, _ref)                   \
+	BX_MACRO_BLOCK_BEGIN                                                              \
+		if (0 != _handleAlloc.getNumHandles() )                                       \
+		{                                                                             \
+			BX_TRACE("LEAK: %s %d (max: %d)"                                          \
+				, _name                                                               \
+				, _handleAlloc.getNumHandles()                                        \
+				, _handleAlloc.getMaxHandles()                                        \
+				);                                                                    \
+			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
+			{                                                                         \
+				uint16_t idx = _handleAlloc.getHandleAt(ii);                          \
+				const _type& ref = _ref[idx]; BX_UNUSED(ref);                         \
+				BX_TRACE("\t%3d: %4d %s (count %d)"                                   \
+					, ii                                                              \
+					, idx                                                             \
+					, ref.m_name.getPtr()                                             \
+					, ref.m_refCount                                                  \
+					);                                                                \
+			}                                                                         \
+		}                                                                             \
+	BX_MACRO_BLOCK_END
+
+			CHECK_HANDLE_LEAK        ("DrawBundleHandle",          m_drawBundleHandle                                          );
+			CHECK_HANDLE_LEAK        ("DynamicIndexBufferHandle",  m_dynamicIndexBufferHandle                                  );
+			CHECK_HANDLE_LEAK        ("DynamicVertexBufferHandle", m_dynamicVertexBufferHandle                                 );
+			CHECK_HANDLE_LEAK_NAME   ("IndexBufferHandle",         m_indexBufferHandle,        IndexBuffer,    m_indexBuffers  );
+			CHECK_HANDLE_LEAK        ("VertexLayoutHandle",        m_layoutHandle                                              );
+			CHECK_HANDLE_LEAK_NAME   ("VertexBufferHandle",        m_vertexBufferHandle,       VertexBuffer,   m_vertexBuffers );
+			CHECK_HANDLE_LEAK_RC_NAME("ShaderHandle",              m_shaderHandle,             ShaderRef,      m_shaderRef     );
+			CHECK_HANDLE_LEAK        ("ProgramHandle",             m_programHandle                                             );
+			CHECK_HANDLE_LEAK_RC_NAME("TextureHandle",             m_textureHandle,            TextureRef,     m_textureRef    );
+			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
+			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
+			CHECK_HANDLE_LEAK        ("UniformBlockHandle",        m_uniformBlockHandle                                        );
+			CHECK_HANDLE_LEAK        ("TransformBufferHandle",     m_transformBufferHandle                                     );
+			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+#undef CHECK_HANDLE_LEAK
+#undef CHECK_HANDLE_LEAK_NAME
+		}
+	}
+
+	void Context::freeDynamicBuffers()
+	{
+		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
+		{
+			destroyDynamicIndexBufferInternal(m_freeDynamicIndexBufferHandle[ii]);
+		}
+		m_numFreeDynamicIndexBufferHandles = 0;
+
+		for (uint16_t ii = 0, num = m_numFreeDynamicVertexBufferHandles; ii < num; ++ii)
+		{
+			destroyDynamicVertexBufferInternal(m_freeDynamicVertexBufferHandle[ii]);
 		}
+		m_numFreeDynamicVertexBufferHandles = 0;
 
-		if (convert)
+		for (uint16_t ii = 0, num = m_numFreeOcclusionQueryHandles; ii < num; ++ii)
 		{
-			return TextureFormat::BGRA8;
+			m_occlusionQueryHandle.free(m_freeOcclusionQueryHandle[ii].idx);
 		}
-
-		return TextureFormat::Enum(_imageContainer.m_format);
+		m_numFreeOcclusionQueryHandles = 0;
 	}
 
-	const char* getName(TextureFormat::Enum _fmt)
+	static int32_t compareDynamicBufferUpdate(const void* _lhs, const void* _rhs)
 	{
-		return bimg::getName(bimg::TextureFormat::Enum(_fmt));
-	}
+		typedef Context::DynamicBufferUpdate DynamicBufferUpdate;
+		const DynamicBufferUpdate& lhs = *(const DynamicBufferUpdate*)_lhs;
+		const DynamicBufferUpdate& rhs = *(const DynamicBufferUpdate*)_rhs;
 
-	const char* getName(UniformHandle _handle)
-	{
-		return s_ctx->m_uniformRef[_handle.idx].m_name.getPtr();
+		if (lhs.m_handle != rhs.m_handle)
+		{
+			return lhs.m_handle < rhs.m_handle ? -1 : 1;
+		}
+
+		if (lhs.m_offset != rhs.m_offset)
+		{
+			return lhs.m_offset < rhs.m_offset ? -1 : 1;
+		}
+
+		return lhs.m_seq < rhs.m_seq ? -1 : 1;
 	}
 
-	static const char* s_topologyName[] =
+	static int32_t compareDynamicBufferUpdateSeq(const void* _lhs, const void* _rhs)
 	{
-		"Triangles",
-		"TriStrip",
-		"Lines",
-		"LineStrip",
-		"Points",
-	};
-	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_topologyName) );
+		typedef Context::DynamicBufferUpdate DynamicBufferUpdate;
+		const DynamicBufferUpdate& lhs = *(const DynamicBufferUpdate*)_lhs;
+		const DynamicBufferUpdate& rhs = *(const DynamicBufferUpdate*)_rhs;
 
-	const char* getName(Topology::Enum _topology)
-	{
-		return s_topologyName[bx::min(_topology, Topology::PointList)];
+		return lhs.m_seq < rhs.m_seq ? -1 : 1;
 	}
 
-	const char* getShaderTypeName(uint32_t _magic)
+	void Context::flushDynamicBufferUpdates(DynamicBufferUpdateArray& _updates, CommandBuffer::Enum _cmd)
 	{
-		if (isShaderType(_magic, 'C') )
-		{
-			return "Compute";
-		}
-		else if (isShaderType(_magic, 'F') )
-		{
-			return "Fragment";
-		}
-		else if (isShaderType(_magic, 'V') )
+		const uint32_t num = uint32_t(_updates.size() );
+		if (0 == num)
 		{
-			return "Vertex";
+			return;
 		}
 
-		BX_CHECK(false, "Invalid shader type!");
+		DynamicBufferUpdate* updates = &_updates[0];
+		bx::quickSort(updates, num, sizeof(DynamicBufferUpdate), compareDynamicBufferUpdate);
 
-		return NULL;
-	}
+		for (uint32_t ii = 0; ii < num;)
+		{
+			// Find run of overlapping or adjacent ranges in same buffer.
+			const uint16_t handle = updates[ii].m_handle;
+			const uint32_t begin  = updates[ii].m_offset;
+			uint32_t end = begin + updates[ii].m_size;
 
-	static TextureFormat::Enum s_emulatedFormats[] =
-	{
-		TextureFormat::BC1,
-		TextureFormat::BC2,
-		TextureFormat::BC3,
-		TextureFormat::BC4,
-		TextureFormat::BC5,
-		TextureFormat::ETC1,
-		TextureFormat::ETC2,
-		TextureFormat::ETC2A,
-		TextureFormat::ETC2A1,
-		TextureFormat::PTC12,
-		TextureFormat::PTC14,
-		TextureFormat::PTC12A,
-		TextureFormat::PTC14A,
-		TextureFormat::PTC22,
-		TextureFormat::PTC24,
-		TextureFormat::ATC,
-		TextureFormat::ATCE,
-		TextureFormat::ATCI,
-		TextureFormat::ASTC4x4,
-		TextureFormat::ASTC5x5,
-		TextureFormat::ASTC6x6,
-		TextureFormat::ASTC8x5,
-		TextureFormat::ASTC8x6,
-		TextureFormat::ASTC10x5,
-		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
-		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
-	};
+			uint32_t jj = ii + 1;
+			for (; jj < num && handle == updates[jj].m_handle && end >= updates[jj].m_offset; ++jj)
+			{
+				end = bx::max(end, updates[jj].m_offset + updates[jj].m_size);
+			}
 
-	bool Context::init(const Init& _init)
-	{
-		BX_CHECK(!m_rendererInitialized, "Already initialized?");
+			const Memory* mem = updates[ii].m_mem;
 
-		m_init = _init;
-		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
+			if (1 < jj - ii)
+			{
+				mem = alloc(end - begin);
 
-		if (g_platformData.ndt          == NULL
-		&&  g_platformData.nwh          == NULL
-		&&  g_platformData.context      == NULL
-		&&  g_platformData.backBuffer   == NULL
-		&&  g_platformData.backBufferDS == NULL)
-		{
-			bx::memCopy(&g_platformData, &m_init.platformData, sizeof(PlatformData) );
-		}
-		else
-		{
-			bx::memCopy(&m_init.platformData, &g_platformData, sizeof(PlatformData) );
-		}
+				// Copy in submission order, so later update wins where ranges
+				// overlap.
+				bx::quickSort(&updates[ii], jj - ii, sizeof(DynamicBufferUpdate), compareDynamicBufferUpdateSeq);
 
-		m_exit    = false;
-		m_flipped = true;
-		m_frames  = 0;
-		m_debug   = BGFX_DEBUG_NONE;
-		m_frameTimeLast = bx::getHPCounter();
+				for (uint32_t kk = ii; kk < jj; ++kk)
+				{
+					const DynamicBufferUpdate& update = updates[kk];
+					bx::memCopy(&mem->data[update.m_offset - begin], update.m_mem->data, update.m_size);
+					release(update.m_mem);
+				}
+			}
 
-		m_submit->create();
+			CommandBuffer& cmdbuf = getCommandBuffer(_cmd);
 
-#if BGFX_CONFIG_MULTITHREADED
-		m_render->create();
+			if (CommandBuffer::UpdateDynamicIndexBuffer == _cmd)
+			{
+				IndexBufferHandle ibh = { handle };
+				cmdbuf.write(ibh);
+			}
+			else
+			{
+				VertexBufferHandle vbh = { handle };
+				cmdbuf.write(vbh);
+			}
 
-		if (s_renderFrameCalled)
-		{
-			// When bgfx::renderFrame is called before init render thread
-			// should not be created.
-			BX_TRACE("Application called bgfx::renderFrame directly, not creating render thread.");
-			m_singleThreaded = true
-				&& ~BGFX_API_THREAD_MAGIC == s_threadIndex
-				;
-		}
-		else
-		{
-			BX_TRACE("Creating rendering thread.");
-			m_thread.init(renderThread, this, 0, "bgfx - renderer backend thread");
-			m_singleThreaded = false;
-		}
-#else
-		BX_TRACE("Multithreaded renderer is disabled.");
-		m_singleThreaded = true;
-#endif // BGFX_CONFIG_MULTITHREADED
+			cmdbuf.write(begin);
+			cmdbuf.write(end - begin);
+			cmdbuf.write(mem);
 
-		BX_TRACE("Running in %s-threaded mode", m_singleThreaded ? "single" : "multi");
+			ii = jj;
+		}
 
-		s_threadIndex = BGFX_API_THREAD_MAGIC;
+		_updates.clear();
+	}
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_viewRemap); ++ii)
-		{
-			m_viewRemap[ii] = ViewId(ii);
-		}
+	const Memory* Context::createTexturePlaceholder()
+	{
+		const Memory* texels = alloc(4);
+		bx::memSet(texels->data, 0, texels->size);
 
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
-		{
-			resetView(ViewId(ii) );
-		}
+		const Memory* mem = alloc(sizeof(uint32_t)+sizeof(TextureCreate) );
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_clearColor); ++ii)
-		{
-			m_clearColor[ii][0] = 0.0f;
-			m_clearColor[ii][1] = 0.0f;
-			m_clearColor[ii][2] = 0.0f;
-			m_clearColor[ii][3] = 1.0f;
-		}
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
 
-		m_vertexLayoutRef.init();
+		TextureCreate tc;
+		tc.m_width     = 1;
+		tc.m_height    = 1;
+		tc.m_depth     = 0;
+		tc.m_numLayers = 1;
+		tc.m_numMips   = 1;
+		tc.m_format    = TextureFormat::RGBA8;
+		tc.m_cubeMap   = false;
+		tc.m_mem       = texels;
+		bx::write(&writer, tc);
 
-		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
-		cmdbuf.write(_init);
+		return mem;
+	}
 
-		frameNoRenderWait();
+	void Context::textureAsyncParse(TextureAsyncJob& _job)
+	{
+		bimg::ImageContainer imageContainer;
+		_job.m_ok = bimg::imageParse(imageContainer, _job.m_mem->data, _job.m_mem->size);
 
-		m_encoderHandle = bx::createHandleAlloc(g_allocator, _init.limits.maxEncoders);
-		m_encoder       = (EncoderImpl*)BX_ALLOC(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders);
-		m_encoderStats  = (EncoderStats*)BX_ALLOC(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
-		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
+		if (_job.m_ok)
 		{
-			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
+			calcTextureSize(_job.m_info
+				, (uint16_t)imageContainer.m_width
+				, (uint16_t)imageContainer.m_height
+				, (uint16_t)imageContainer.m_depth
+				, imageContainer.m_cubeMap
+				, imageContainer.m_numMips > 1
+				, imageContainer.m_numLayers
+				, TextureFormat::Enum(imageContainer.m_format)
+				);
+			_job.m_numMips   = imageContainer.m_numMips;
+			_job.m_numLayers = imageContainer.m_numLayers;
 		}
+	}
 
-		uint16_t idx = m_encoderHandle->alloc();
-		BX_CHECK(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
-		m_encoder[0].begin(m_submit, 0);
-		m_encoder0 = reinterpret_cast<Encoder*>(&m_encoder[0]);
+	int32_t Context::textureAsyncThread(bx::Thread* /*_self*/, void* _userData)
+	{
+		Context* ctx = (Context*)_userData;
 
-		// Make sure renderer init is called from render thread.
-		// g_caps is initialized and available after this point.
-		frame();
+		TextureAsyncJobArray batch;
 
-		if (!m_rendererInitialized)
+		for (;;)
 		{
-			getCommandBuffer(CommandBuffer::RendererShutdownEnd);
-			frame();
-			frame();
-			m_vertexLayoutRef.shutdown(m_layoutHandle);
-			m_submit->destroy();
-#if BGFX_CONFIG_MULTITHREADED
-			m_render->destroy();
-#endif // BGFX_CONFIG_MULTITHREADED
-			return false;
-		}
+			ctx->m_textureAsyncSem.wait();
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
-		{
-			const uint32_t fmt = s_emulatedFormats[ii];
-			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
-			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
-			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
-		}
+			{
+				bx::MutexScope lock(ctx->m_textureAsyncLock);
 
-		for (uint32_t ii = 0; ii < TextureFormat::UnknownDepth; ++ii)
-		{
-			bool convertable = bimg::imageConvert(bimg::TextureFormat::BGRA8, bimg::TextureFormat::Enum(ii) );
-			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_2D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
-			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_3D  ) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
-			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & BGFX_CAPS_FORMAT_TEXTURE_CUBE) && convertable ? BGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
-		}
+				if (ctx->m_textureAsyncExit)
+				{
+					break;
+				}
 
-		g_caps.rendererType = m_renderCtx->getRendererType();
-		initAttribTypeSizeTable(g_caps.rendererType);
+				// Take all queued jobs at once, API thread is blocked only
+				// for duration of swap.
+				batch.swap(ctx->m_textureAsyncQueue);
+			}
 
-		g_caps.supported |= 0
-			| (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) && !m_singleThreaded ? BGFX_CAPS_RENDERER_MULTITHREADED : 0)
-			| (isGraphicsDebuggerPresent() ? BGFX_CAPS_GRAPHICS_DEBUGGER : 0)
-			;
+			if (batch.empty() )
+			{
+				continue;
+			}
 
-		dumpCaps();
+			for (TextureAsyncJobArray::iterator it = batch.begin(), itEnd = batch.end(); it != itEnd; ++it)
+			{
+				textureAsyncParse(*it);
+			}
 
-		m_textVideoMemBlitter.init();
-		m_clearQuad.init();
+			{
+				bx::MutexScope lock(ctx->m_textureAsyncLock);
 
-		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
-		frame();
+				for (TextureAsyncJobArray::const_iterator it = batch.begin(), itEnd = batch.end(); it != itEnd; ++it)
+				{
+					ctx->m_textureAsyncDone.push_back(*it);
+				}
+			}
 
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
-		{
-			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
-			frame();
+			batch.clear();
 		}
 
-		g_internalData.caps = getCaps();
-
-		return true;
+		return EXIT_SUCCESS;
 	}
 
-	void Context::shutdown()
+	void Context::textureAsyncSubmit(const TextureAsyncJob& _job)
 	{
-		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
-		frame();
+		bx::MutexScope lock(m_textureAsyncLock);
+		m_textureAsyncQueue.push_back(_job);
 
-		destroyTransientVertexBuffer(m_submit->m_transientVb);
-		destroyTransientIndexBuffer(m_submit->m_transientIb);
-		m_textVideoMemBlitter.shutdown();
-		m_clearQuad.shutdown();
-		frame();
+#if BGFX_CONFIG_MULTITHREADED
+		if (!m_textureAsyncThread.isRunning() )
+		{
+			m_textureAsyncExit = false;
+			m_textureAsyncThread.init(textureAsyncThread, this, 0, "bgfx - texture parse thread");
+		}
 
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		m_textureAsyncSem.post();
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	void Context::textureAsyncComplete()
+	{
+		TextureAsyncJobArray done;
 		{
-			destroyTransientVertexBuffer(m_submit->m_transientVb);
-			destroyTransientIndexBuffer(m_submit->m_transientIb);
-			frame();
+			bx::MutexScope lock(m_textureAsyncLock);
+
+			if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+			{
+				// Without worker thread, jobs are parsed here, on API thread.
+				for (TextureAsyncJobArray::iterator it = m_textureAsyncQueue.begin(), itEnd = m_textureAsyncQueue.end(); it != itEnd; ++it)
+				{
+					textureAsyncParse(*it);
+					m_textureAsyncDone.push_back(*it);
+				}
+
+				m_textureAsyncQueue.clear();
+			}
+
+			done.swap(m_textureAsyncDone);
 		}
 
-		frame(); // If any VertexLayouts needs to be destroyed.
+		for (TextureAsyncJobArray::const_iterator it = done.begin(), itEnd = done.end(); it != itEnd; ++it)
+		{
+			const TextureAsyncJob& job = *it;
+			TextureRef& ref = m_textureRef[job.m_handle.idx];
 
-		getCommandBuffer(CommandBuffer::RendererShutdownEnd);
-		frame();
+			// Texture was destroyed, or handle was reused, while image was
+			// being parsed.
+			if (ref.m_asyncSerial != job.m_serial)
+			{
+				release(job.m_mem);
+				continue;
+			}
 
-		m_encoder[0].end(true);
-		m_encoderHandle->free(0);
-		bx::destroyHandleAlloc(g_allocator, m_encoderHandle);
-		m_encoderHandle = NULL;
+			if (!job.m_ok)
+			{
+				BX_WARN(false, "createTextureAsync: Failed to parse texture %d, keeping placeholder.", job.m_handle.idx);
+				release(job.m_mem);
+				ref.m_asyncSerial = 0;
+				continue;
+			}
 
-		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
-		{
-			m_encoder[ii].~EncoderImpl();
-		}
-		BX_FREE(g_allocator, m_encoder);
-		BX_FREE(g_allocator, m_encoderStats);
+			// Replace placeholder in pre command buffer, so texture is valid
+			// for draw calls submitted in this frame.
+			CommandBuffer& cmdbuf = m_submit->m_cmdPre;
+			cmdbuf.write(uint8_t(CommandBuffer::DestroyTexture) );
+			cmdbuf.write(job.m_handle);
 
-		m_dynVertexBufferAllocator.compact();
-		m_dynIndexBufferAllocator.compact();
+			cmdbuf.write(uint8_t(CommandBuffer::CreateTexture) );
+			cmdbuf.write(job.m_handle);
+			cmdbuf.write(job.m_mem);
+			cmdbuf.write(job.m_flags);
+			cmdbuf.write(job.m_skip);
 
-		BX_CHECK(m_layoutHandle.getNumHandles() == m_vertexLayoutRef.m_layoutMap.getNumElements()
-				, "VertexLayoutRef mismatch, num handles %d, handles in hash map %d."
-				, m_layoutHandle.getNumHandles()
-				, m_vertexLayoutRef.m_layoutMap.getNumElements()
-				);
+			m_textureMemoryUsed -= int64_t(ref.m_storageSize);
 
-		m_vertexLayoutRef.shutdown(m_layoutHandle);
+			ref.m_ptr         = 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_DIRECT_ACCESS) ? (void*)UINTPTR_MAX : NULL;
+			ref.m_storageSize = job.m_info.storageSize;
+			ref.m_format      = uint8_t(job.m_info.format);
+			ref.m_numMips     = job.m_numMips;
+			ref.m_numLayers   = job.m_numLayers;
+			ref.m_immutable   = false;
+			ref.m_ready       = true;
+			ref.m_asyncSerial = 0;
 
+			m_textureMemoryUsed += int64_t(ref.m_storageSize);
+		}
+	}
+
+	void Context::textureAsyncShutdown()
+	{
 #if BGFX_CONFIG_MULTITHREADED
-		// Render thread shutdown sequence.
-		renderSemWait(); // Wait for previous frame.
-		apiSemPost();   // OK to set context to NULL.
-		// s_ctx is NULL here.
-		renderSemWait(); // In RenderFrame::Exiting state.
+		if (m_textureAsyncThread.isRunning() )
+		{
+			{
+				bx::MutexScope lock(m_textureAsyncLock);
+				m_textureAsyncExit = true;
+			}
 
-		if (m_thread.isRunning() )
+			m_textureAsyncSem.post();
+			m_textureAsyncThread.shutdown();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		for (TextureAsyncJobArray::const_iterator it = m_textureAsyncQueue.begin(), itEnd = m_textureAsyncQueue.end(); it != itEnd; ++it)
 		{
-			m_thread.shutdown();
+			release(it->m_mem);
 		}
+		m_textureAsyncQueue.clear();
 
-		m_render->destroy();
-#endif // BGFX_CONFIG_MULTITHREADED
+		for (TextureAsyncJobArray::const_iterator it = m_textureAsyncDone.begin(), itEnd = m_textureAsyncDone.end(); it != itEnd; ++it)
+		{
+			release(it->m_mem);
+		}
+		m_textureAsyncDone.clear();
+	}
 
-		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
-		s_ctx = NULL;
+	void Context::updateFrameStats(Frame* _frame)
+	{
+		// Cache usage is final once all encoders are done, and before command
+		// buffers are finished.
+		const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		const uint32_t transformsUsed = matrixCache.m_num - matrixCache.m_base + 1;
+		const uint32_t rectsUsed      = _frame->m_frameCache.m_rectCache.m_num;
+		const uint32_t cmdBufferUsed  = _frame->m_cmdPre.m_pos + _frame->m_cmdPost.m_pos;
 
-		m_submit->destroy();
+		m_transformsMaxUsed = bx::max(m_transformsMaxUsed, transformsUsed);
+		m_rectsMaxUsed      = bx::max(m_rectsMaxUsed,      rectsUsed);
+		m_cmdBufferMaxUsed  = bx::max(m_cmdBufferMaxUsed,  cmdBufferUsed);
 
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+		Stats& stats = _frame->m_perfStats;
+		stats.transformsUsed = int32_t(transformsUsed);
+		stats.rectsUsed      = int32_t(rectsUsed);
+		stats.cmdBufferUsed  = int32_t(cmdBufferUsed);
+	}
+
+	void Context::flushTransientBufferPages(Frame* _frame)
+	{
+		m_transientIbMaxUsed = bx::max(m_transientIbMaxUsed, _frame->getTransientIbUsed() );
+		m_transientVbMaxUsed = bx::max(m_transientVbMaxUsed, _frame->getTransientVbUsed() );
+
+		// Renderer uploads primary transient buffers directly, overflow pages
+		// are uploaded as dynamic buffer updates before frame is rendered.
+		for (uint16_t ii = 0, num = _frame->m_ibPage; ii < num; ++ii)
 		{
-#define CHECK_HANDLE_LEAK(_name, _handleAlloc)                                        \
-	BX_MACRO_BLOCK_BEGIN                                                              \
-		if (0 != _handleAlloc.getNumHandles() )                                       \
-		{                                                                             \
-			BX_TRACE("LEAK: %s %d (max: %d)"                                          \
-				, _name                                                               \
-				, _handleAlloc.getNumHandles()                                        \
-				, _handleAlloc.getMaxHandles()                                        \
-				);                                                                    \
-			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
-			{                                                                         \
-				BX_TRACE("\t%3d: %4d", ii, _handleAlloc.getHandleAt(ii) );            \
-			}                                                                         \
-		}                                                                             \
-	BX_MACRO_BLOCK_END
+			const uint32_t size = _frame->m_ibPageOffset[ii];
+			if (0 < size)
+			{
+				TransientIndexBuffer* tib = _frame->m_transientIbPage[ii];
+				_frame->m_ibPageLastUsed[ii] = m_frames;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
+				cmdbuf.write(tib->handle);
+				cmdbuf.write(uint32_t(0) );
+				cmdbuf.write(size);
+				cmdbuf.write(makeRef(tib->data, size) );
+			}
+		}
 
-#define CHECK_HANDLE_LEAK_NAME(_name, _handleAlloc, _type, _ref)                      \
-	BX_MACRO_BLOCK_BEGIN                                                              \
-		if (0 != _handleAlloc.getNumHandles() )                                       \
-		{                                                                             \
-			BX_TRACE("LEAK: %s %d (max: %d)"                                          \
-				, _name                                                               \
-				, _handleAlloc.getNumHandles()                                        \
-				, _handleAlloc.getMaxHandles()                                        \
-				);                                                                    \
-			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
-			{                                                                         \
-				uint16_t idx = _handleAlloc.getHandleAt(ii);                          \
-				const _type& ref = _ref[idx]; BX_UNUSED(ref);                         \
-				BX_TRACE("\t%3d: %4d %s"                                              \
-					, ii                                                              \
-					, idx                                                             \
-					, ref.m_name.getPtr()                                             \
-					);                                                                \
-			}                                                                         \
-		}                                                                             \
-	BX_MACRO_BLOCK_END
+		for (uint16_t ii = 0, num = _frame->m_vbPage; ii < num; ++ii)
+		{
+			const uint32_t size = _frame->m_vbPageOffset[ii];
+			if (0 < size)
+			{
+				TransientVertexBuffer* tvb = _frame->m_transientVbPage[ii];
+				_frame->m_vbPageLastUsed[ii] = m_frames;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
+				cmdbuf.write(tvb->handle);
+				cmdbuf.write(uint32_t(0) );
+				cmdbuf.write(size);
+				cmdbuf.write(makeRef(tvb->data, size) );
+			}
+		}
 
-#define CHECK_HANDLE_LEAK_RC_NAME(_name, _handleAlloc, _type, _ref)                   \
-	BX_MACRO_BLOCK_BEGIN                                                              \
-		if (0 != _handleAlloc.getNumHandles() )                                       \
-		{                                                                             \
-			BX_TRACE("LEAK: %s %d (max: %d)"                                          \
-				, _name                                                               \
-				, _handleAlloc.getNumHandles()                                        \
-				, _handleAlloc.getMaxHandles()                                        \
-				);                                                                    \
-			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
-			{                                                                         \
-				uint16_t idx = _handleAlloc.getHandleAt(ii);                          \
-				const _type& ref = _ref[idx]; BX_UNUSED(ref);                         \
-				BX_TRACE("\t%3d: %4d %s (count %d)"                                   \
-					, ii                                                              \
-					, idx                                                             \
-					, ref.m_name.getPtr()                                             \
-					, ref.m_refCount                                                  \
-					);                                                                \
-			}                                                                         \
-		}                                                                             \
-	BX_MACRO_BLOCK_END
+		// Shrink back by releasing trailing pages that were idle for a while.
+		while (_frame->m_numIbPages > _frame->m_ibPage
+		&&     m_frames - _frame->m_ibPageLastUsed[_frame->m_numIbPages-1] > BGFX_CONFIG_TRANSIENT_BUFFER_PAGE_IDLE_FRAMES)
+		{
+			--_frame->m_numIbPages;
+			destroyTransientIndexBuffer(_frame->m_transientIbPage[_frame->m_numIbPages]);
+		}
 
-			CHECK_HANDLE_LEAK        ("DynamicIndexBufferHandle",  m_dynamicIndexBufferHandle                                  );
-			CHECK_HANDLE_LEAK        ("DynamicVertexBufferHandle", m_dynamicVertexBufferHandle                                 );
-			CHECK_HANDLE_LEAK_NAME   ("IndexBufferHandle",         m_indexBufferHandle,        IndexBuffer,    m_indexBuffers  );
-			CHECK_HANDLE_LEAK        ("VertexLayoutHandle",        m_layoutHandle                                              );
-			CHECK_HANDLE_LEAK_NAME   ("VertexBufferHandle",        m_vertexBufferHandle,       VertexBuffer,   m_vertexBuffers );
-			CHECK_HANDLE_LEAK_RC_NAME("ShaderHandle",              m_shaderHandle,             ShaderRef,      m_shaderRef     );
-			CHECK_HANDLE_LEAK        ("ProgramHandle",             m_programHandle                                             );
-			CHECK_HANDLE_LEAK_RC_NAME("TextureHandle",             m_textureHandle,            TextureRef,     m_textureRef    );
-			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
-			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
-			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
-#undef CHECK_HANDLE_LEAK
-#undef CHECK_HANDLE_LEAK_NAME
+		while (_frame->m_numVbPages > _frame->m_vbPage
+		&&     m_frames - _frame->m_vbPageLastUsed[_frame->m_numVbPages-1] > BGFX_CONFIG_TRANSIENT_BUFFER_PAGE_IDLE_FRAMES)
+		{
+			--_frame->m_numVbPages;
+			destroyTransientVertexBuffer(_frame->m_transientVbPage[_frame->m_numVbPages]);
 		}
 	}
 
-	void Context::freeDynamicBuffers()
+	void Context::destroyTransientBufferPages(Frame* _frame)
 	{
-		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
+		for (uint16_t ii = 0, num = _frame->m_numIbPages; ii < num; ++ii)
 		{
-			destroyDynamicIndexBufferInternal(m_freeDynamicIndexBufferHandle[ii]);
+			destroyTransientIndexBuffer(_frame->m_transientIbPage[ii]);
 		}
-		m_numFreeDynamicIndexBufferHandles = 0;
 
-		for (uint16_t ii = 0, num = m_numFreeDynamicVertexBufferHandles; ii < num; ++ii)
+		for (uint16_t ii = 0, num = _frame->m_numVbPages; ii < num; ++ii)
 		{
-			destroyDynamicVertexBufferInternal(m_freeDynamicVertexBufferHandle[ii]);
+			destroyTransientVertexBuffer(_frame->m_transientVbPage[ii]);
 		}
-		m_numFreeDynamicVertexBufferHandles = 0;
 
-		for (uint16_t ii = 0, num = m_numFreeOcclusionQueryHandles; ii < num; ++ii)
-		{
-			m_occlusionQueryHandle.free(m_freeOcclusionQueryHandle[ii].idx);
-		}
-		m_numFreeOcclusionQueryHandles = 0;
+		_frame->m_numIbPages = 0;
+		_frame->m_numVbPages = 0;
 	}
 
 	void Context::freeAllHandles(Frame* _frame)
@@ -2106,6 +4421,27 @@ namespace bgfx
 		{
 			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
 		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeUniformBlock.getNumQueued(); ii < num; ++ii)
+		{
+			m_uniformBlockHandle.free(_frame->m_freeUniformBlock.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeDrawBundle.getNumQueued(); ii < num; ++ii)
+		{
+			const DrawBundleHandle handle = _frame->m_freeDrawBundle.get(ii);
+			m_drawBundle[handle.idx].destroy();
+			m_drawBundleHandle.free(handle.idx);
+		}
+
+		BGFX_MUTEX_SCOPE(m_transformBufferLock);
+
+		for (uint16_t ii = 0, num = _frame->m_freeTransformBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			TransformBufferHandle handle = _frame->m_freeTransformBuffer.get(ii);
+			m_transformBufferAllocator.free(uint64_t(m_transformBufferRef[handle.idx].m_offset)*sizeof(Matrix4) );
+			m_transformBufferHandle.free(handle.idx);
+		}
 	}
 
 	Encoder* Context::begin(bool _forThread)
@@ -2115,16 +4451,60 @@ namespace bgfx
 #if BGFX_CONFIG_MULTITHREADED
 		if (_forThread || BGFX_API_THREAD_MAGIC != s_threadIndex)
 		{
-			bx::MutexScope scopeLock(m_encoderApiLock);
+			// Encoder is counted as active before anything else is touched.
+			// While frame bias is set API thread is waiting for encoders or
+			// swapping frame, and encoder must not begin until it's done.
+			// Thread that already has an active encoder is exception, since
+			// frame can't get past wait before that encoder ends.
+			for (;;)
+			{
+				const int32_t numActive = bx::atomicFetchAndAdd<int32_t>(&m_encoderActive, 1);
+				if (numActive < kEncoderFrameBias)
+				{
+					break;
+				}
+
+				const uintptr_t tls = s_encoderIndex;
+				if (tls == encoderTls(uint32_t(tls & 0x7f), true) )
+				{
+					break;
+				}
+
+				encoderActiveRelease();
 
-			uint16_t idx = m_encoderHandle->alloc();
-			if (kInvalidHandle == idx)
+				bx::MutexScope scopeLock(m_encoderApiLock);
+			}
+
+			// Thread that already used an encoder during this frame gets the
+			// same encoder back, otherwise new one is taken from the pool.
+			const uintptr_t tls = s_encoderIndex;
+			const uint32_t  idx = uint32_t(tls & 0x7f);
+
+			if (0   != idx
+			&&  tls == encoderTls(idx, false) )
 			{
-				return NULL;
+				encoder = &m_encoder[idx];
+				encoder->resume();
+				s_encoderIndex = encoderTls(idx, true);
 			}
+			else
+			{
+				const uint32_t newIdx = bx::atomicFetchAndAdd<uint32_t>(&m_numEncoders, 1);
+				if (newIdx >= g_caps.limits.maxEncoders)
+				{
+					encoderActiveRelease();
+					return NULL;
+				}
 
-			encoder = &m_encoder[idx];
-			encoder->begin(m_submit, uint8_t(idx) );
+				encoder = &m_encoder[newIdx];
+				encoder->begin(m_submit, uint8_t(newIdx) );
+
+				// Don't replace encoder that's still active on this thread.
+				if (tls != encoderTls(idx, true) )
+				{
+					s_encoderIndex = encoderTls(newIdx, true);
+				}
+			}
 		}
 #else
 		BX_UNUSED(_forThread);
@@ -2140,7 +4520,14 @@ namespace bgfx
 		if (encoder != &m_encoder[0])
 		{
 			encoder->end(true);
-			m_encoderEndSem.post();
+
+			const uint32_t idx = uint32_t(encoder - m_encoder);
+			if (s_encoderIndex == encoderTls(idx, true) )
+			{
+				s_encoderIndex = encoderTls(idx, false);
+			}
+
+			encoderActiveRelease();
 		}
 #else
 		BX_UNUSED(_encoder);
@@ -2155,7 +4542,6 @@ namespace bgfx
 		bx::MutexScope resourceApiScope(m_resourceApiLock);
 
 		encoderApiWait();
-		bx::MutexScope encoderApiScope(m_encoderApiLock);
 #else
 		encoderApiWait();
 #endif // BGFX_CONFIG_MULTITHREADED
@@ -2166,6 +4552,7 @@ namespace bgfx
 		// wait for render thread to finish
 		renderSemWait();
 		frameNoRenderWait();
+		encoderApiDone();
 
 		m_encoder[0].begin(m_submit, 0);
 
@@ -2180,8 +4567,91 @@ namespace bgfx
 		apiSemPost();
 	}
 
+	void Context::flushTransformBuffers(Frame* _frame)
+	{
+		uint32_t& begin = m_transformBufferDirtyBegin[m_submitIdx];
+		uint32_t& end   = m_transformBufferDirtyEnd[m_submitIdx];
+
+		if (begin < end)
+		{
+			// Transform buffers created during this frame might not fit into
+			// persistent region yet, they are copied once region is resized.
+			MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+			const uint32_t last = bx::min(end, matrixCache.m_base-1);
+
+			if (begin < last)
+			{
+				bx::memCopy(&matrixCache.m_cache[1+begin], &m_transformBuffer[begin], (last-begin)*sizeof(Matrix4) );
+			}
+
+			begin = UINT32_MAX;
+			end   = 0;
+		}
+	}
+
+	void Context::resizeTransformBuffers(Frame* _frame)
+	{
+		// Persistent region of frame grows in steps to cover all allocated
+		// transform buffers. Whole region is copied again after it's resized,
+		// or after frame trace replay overwrote it.
+		MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		const uint32_t num = bx::min<uint32_t>(
+			  bx::strideAlign(m_transformBufferUsed, 1<<10)
+			, BGFX_CONFIG_MAX_PERSISTENT_TRANSFORMS
+			);
+
+		if (matrixCache.setPersistent(num)
+		||  matrixCache.m_stale)
+		{
+			matrixCache.m_stale = false;
+			m_transformBufferDirtyBegin[m_submitIdx] = 0;
+			m_transformBufferDirtyEnd[m_submitIdx]   = bx::max(m_transformBufferDirtyEnd[m_submitIdx], m_transformBufferUsed);
+		}
+	}
+
+	void Context::flushViewUniforms(Frame* _frame)
+	{
+		UniformBuffer* viewUniformBuffer = _frame->m_viewUniformBuffer;
+		viewUniformBuffer->reset();
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			View& view = _frame->m_view[ii];
+			const UniformBuffer* uniformBuffer = m_viewUniform[ii];
+
+			if (NULL != uniformBuffer
+			&&  !uniformBuffer->isEmpty() )
+			{
+				const uint32_t size = uniformBuffer->getPos();
+				UniformBuffer::update(&_frame->m_viewUniformBuffer, size, BX_ALIGN_16(size) + (16<<10) );
+				viewUniformBuffer = _frame->m_viewUniformBuffer;
+
+				view.m_uniformBegin = viewUniformBuffer->getPos();
+				viewUniformBuffer->write(uniformBuffer->getData(), size);
+				view.m_uniformEnd   = viewUniformBuffer->getPos();
+			}
+			else
+			{
+				view.m_uniformBegin = 0;
+				view.m_uniformEnd   = 0;
+			}
+		}
+	}
+
 	void Context::swap()
 	{
+		// Draw bundles don't hold references, they are validated again once
+		// handles destroyed in this frame are freed, before handles can be
+		// reused.
+		const bool validateDrawBundles = 0 != m_drawBundleHandle.getNumHandles()
+			&& (0 != m_numFreeDynamicIndexBufferHandles
+			||  0 != m_numFreeDynamicVertexBufferHandles
+			||  0 != m_submit->m_freeIndexBuffer.getNumQueued()
+			||  0 != m_submit->m_freeVertexBuffer.getNumQueued()
+			||  0 != m_submit->m_freeProgram.getNumQueued()
+			||  0 != m_submit->m_freeTexture.getNumQueued()
+			);
+
 		freeDynamicBuffers();
 		m_submit->m_resolution = m_init.resolution;
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
@@ -2190,6 +4660,8 @@ namespace bgfx
 
 		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
 		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
+		flushViewUniforms(m_submit);
+		flushTransformBuffers(m_submit);
 
 		if (m_colorPaletteDirty > 0)
 		{
@@ -2197,14 +4669,46 @@ namespace bgfx
 			bx::memCopy(m_submit->m_colorPalette, m_clearColor, sizeof(m_clearColor) );
 		}
 
+		flushDynamicBufferUpdates(m_dynIndexBufferUpdate,  CommandBuffer::UpdateDynamicIndexBuffer);
+		flushDynamicBufferUpdates(m_dynVertexBufferUpdate, CommandBuffer::UpdateDynamicVertexBuffer);
+		flushTransientBufferPages(m_submit);
+		textureAsyncComplete();
+
 		freeAllHandles(m_submit);
 		m_submit->resetFreeHandles();
 
+		if (validateDrawBundles)
+		{
+			for (uint16_t ii = 0, num = m_drawBundleHandle.getNumHandles(); ii < num; ++ii)
+			{
+				validateDrawBundle(m_drawBundle[m_drawBundleHandle.getHandleAt(ii)]);
+			}
+		}
+
+		updateFrameStats(m_submit);
 		m_submit->finish();
+		m_frameTraceWriter.frame(m_submit);
+
+		Frame* queued = m_submit;
+		m_submitIdx = (m_submitIdx + 1) % m_numFrames;
+		m_submit    = &m_frame[m_submitIdx];
 
-		bx::swap(m_render, m_submit);
+		// Propagate latest occlusion query results to frame that is about to
+		// be rendered, and to new submit frame where getResult reads them.
+		// With more than two frames in flight, new submit frame is not
+		// necessarily the one render thread finished last, and render thread
+		// can already be rendering next one while index is read here.
+		const uint32_t renderedIdx = bx::atomicFetchAndAdd<uint32_t>(&m_renderedIdx, 0);
+		const Frame* rendered = &m_frame[renderedIdx];
+		if (queued != rendered)
+		{
+			bx::memCopy(queued->m_occlusion, rendered->m_occlusion, sizeof(rendered->m_occlusion) );
+		}
 
-		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+		if (m_submit != rendered)
+		{
+			bx::memCopy(m_submit->m_occlusion, rendered->m_occlusion, sizeof(rendered->m_occlusion) );
+		}
 
 		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
 		||  m_singleThreaded)
@@ -2214,11 +4718,12 @@ namespace bgfx
 
 		m_frames++;
 		m_submit->start();
+		resizeTransformBuffers(m_submit);
 
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
 
 		m_submit->m_textVideoMem->resize(
-			  m_render->m_textVideoMem->m_small
+			  queued->m_textVideoMem->m_small
 			, m_init.resolution.width
 			, m_init.resolution.height
 			);
@@ -2291,6 +4796,9 @@ namespace bgfx
 
 		if (apiSemWait(_msecs) )
 		{
+			m_render    = &m_frame[m_renderIdx];
+			m_renderIdx = (m_renderIdx + 1) % m_numFrames;
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
 				rendererExecCommands(m_render->m_cmdPre);
@@ -2301,6 +4809,9 @@ namespace bgfx
 				BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
 				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
 				m_flipped = false;
+
+				m_render->m_perfStats.numUniformsSkipped = m_uniformShadow.m_numSkipped;
+				m_uniformShadow.m_numSkipped = 0;
 			}
 
 			{
@@ -2308,6 +4819,7 @@ namespace bgfx
 				rendererExecCommands(m_render->m_cmdPost);
 			}
 
+			bx::atomicExchange<uint32_t>(&m_renderedIdx, uint32_t(m_render - m_frame) );
 			renderSemPost();
 
 			if (m_flipAfterRender)
@@ -2327,8 +4839,72 @@ namespace bgfx
 			;
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	void UniformShadow::create(UniformHandle _handle, uint32_t _size)
+	{
+		// Uniform can be recreated with more elements, renderer reallocates its
+		// copy then, and value is not known anymore.
+		if (m_size[_handle.idx] < _size)
+		{
+			m_data[_handle.idx] = (uint8_t*)BX_REALLOC(g_allocator, m_data[_handle.idx], _size);
+			m_size[_handle.idx] = _size;
+		}
+
+		m_used[_handle.idx] = 0;
+	}
+
+	void UniformShadow::destroy(UniformHandle _handle)
+	{
+		BX_FREE(g_allocator, m_data[_handle.idx]);
+		m_data[_handle.idx] = NULL;
+		m_size[_handle.idx] = 0;
+		m_used[_handle.idx] = 0;
+	}
+
+	bool UniformShadow::update(uint16_t _loc, const void* _data, uint32_t _size)
+	{
+		if (_size > m_size[_loc])
+		{
+			return true;
+		}
+
+		uint8_t* data = m_data[_loc];
+
+		if (_size <= m_used[_loc]
+		&&  0 == bx::memCmp(data, _data, _size) )
+		{
+			++m_numSkipped;
+			return false;
+		}
+
+		bx::memCopy(data, _data, _size);
+		m_used[_loc] = bx::max(m_used[_loc], _size);
+
+		return true;
+	}
+
+	void UniformShadow::shutdown()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_data); ++ii)
+		{
+			BX_FREE(g_allocator, m_data[ii]);
+		}
+
+		bx::memSet(m_data, 0, sizeof(m_data) );
+		bx::memSet(m_size, 0, sizeof(m_size) );
+		bx::memSet(m_used, 0, sizeof(m_used) );
+		m_numSkipped = 0;
+	}
+
+	void rendererInvalidateUniform(UniformHandle _handle)
+	{
+		s_ctx->m_uniformShadow.invalidate(_handle);
+	}
+
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
 	{
+		UniformShadow& shadow = s_ctx->m_uniformShadow;
+		bool changed = false;
+
 		_uniformBuffer->reset(_begin);
 		while (_uniformBuffer->getPos() < _end)
 		{
@@ -2349,13 +4925,35 @@ namespace bgfx
 			const char* data = _uniformBuffer->read(size);
 			if (UniformType::Count > type)
 			{
-				if (copy)
+				if (!copy)
+				{
+					data = *(const char**)(data);
+				}
+
+				if (!BX_ENABLED(BGFX_CONFIG_UNIFORM_SHADOW)
+				||  shadow.update(loc, data, size) )
 				{
 					_renderCtx->updateUniform(loc, data, size);
+					changed = true;
 				}
-				else
+			}
+			else if (UniformBuffer::kBlockType == type)
+			{
+				// Renderers bind uniforms by shader register layout, packed
+				// values of block are passed to them per uniform.
+				const UniformBlock& block = s_ctx->m_uniformBlock[loc];
+				for (uint32_t ii = 0, num = block.m_num; ii < num; ++ii)
 				{
-					_renderCtx->updateUniform(loc, *(const char**)(data), size);
+					const UniformBlock::Entry& entry = block.m_entry[ii];
+
+					if (!BX_ENABLED(BGFX_CONFIG_UNIFORM_SHADOW)
+					||  shadow.update(entry.m_handle.idx, data, entry.m_size) )
+					{
+						_renderCtx->updateUniform(entry.m_handle.idx, data, entry.m_size);
+						changed = true;
+					}
+
+					data += entry.m_size;
 				}
 			}
 			else
@@ -2363,62 +4961,257 @@ namespace bgfx
 				_renderCtx->setMarker(data, uint16_t(size)-1);
 			}
 		}
+
+		return changed;
 	}
 
-	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
+	static int32_t compareTextureUpdateRow(const void* _lhs, const void* _rhs)
 	{
-		if (m_textureUpdateBatch.sort() )
-		{
-			const uint32_t pos = _cmdbuf.m_pos;
+		const TextureUpdateRegion& lhs = *(const TextureUpdateRegion*)_lhs;
+		const TextureUpdateRegion& rhs = *(const TextureUpdateRegion*)_rhs;
 
-			uint32_t currentKey = UINT32_MAX;
-
-			for (uint32_t ii = 0, num = m_textureUpdateBatch.m_num; ii < num; ++ii)
-			{
-				_cmdbuf.m_pos = m_textureUpdateBatch.m_values[ii];
+		if (lhs.m_z != rhs.m_z) { return lhs.m_z < rhs.m_z ? -1 : 1; }
+		if (lhs.m_rect.m_y != rhs.m_rect.m_y) { return lhs.m_rect.m_y < rhs.m_rect.m_y ? -1 : 1; }
+		if (lhs.m_rect.m_height != rhs.m_rect.m_height) { return lhs.m_rect.m_height < rhs.m_rect.m_height ? -1 : 1; }
+		if (lhs.m_rect.m_x != rhs.m_rect.m_x) { return lhs.m_rect.m_x < rhs.m_rect.m_x ? -1 : 1; }
 
-				TextureHandle handle;
-				_cmdbuf.read(handle);
+		return 0;
+	}
 
-				uint8_t side;
-				_cmdbuf.read(side);
+	static int32_t compareTextureUpdateColumn(const void* _lhs, const void* _rhs)
+	{
+		const TextureUpdateRegion& lhs = *(const TextureUpdateRegion*)_lhs;
+		const TextureUpdateRegion& rhs = *(const TextureUpdateRegion*)_rhs;
 
-				uint8_t mip;
-				_cmdbuf.read(mip);
+		if (lhs.m_z != rhs.m_z) { return lhs.m_z < rhs.m_z ? -1 : 1; }
+		if (lhs.m_rect.m_x != rhs.m_rect.m_x) { return lhs.m_rect.m_x < rhs.m_rect.m_x ? -1 : 1; }
+		if (lhs.m_rect.m_width != rhs.m_rect.m_width) { return lhs.m_rect.m_width < rhs.m_rect.m_width ? -1 : 1; }
+		if (lhs.m_rect.m_y != rhs.m_rect.m_y) { return lhs.m_rect.m_y < rhs.m_rect.m_y ? -1 : 1; }
 
-				Rect rect;
-				_cmdbuf.read(rect);
+		return 0;
+	}
 
-				uint16_t zz;
-				_cmdbuf.read(zz);
+	// Merges horizontally or vertically adjacent regions with matching edge.
+	// Returns number of regions left.
+	static uint32_t mergeTextureUpdateRegions(TextureUpdateRegion* _region, uint32_t _num, uint32_t _texelSize, bool _horizontal)
+	{
+		bx::quickSort(
+			  _region
+			, _num
+			, sizeof(TextureUpdateRegion)
+			, _horizontal ? compareTextureUpdateRow : compareTextureUpdateColumn
+			);
 
-				uint16_t depth;
-				_cmdbuf.read(depth);
+		uint32_t num = 0;
 
-				uint16_t pitch;
-				_cmdbuf.read(pitch);
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const TextureUpdateRegion& region = _region[ii];
 
-				const Memory* mem;
-				_cmdbuf.read(mem);
+			if (0 < num)
+			{
+				TextureUpdateRegion& last = _region[num-1];
 
-				uint32_t key = m_textureUpdateBatch.m_keys[ii];
-				if (key != currentKey)
+				if (_horizontal)
+				{
+					if (last.m_z             == region.m_z
+					&&  last.m_rect.m_y      == region.m_rect.m_y
+					&&  last.m_rect.m_height == region.m_rect.m_height
+					&&  last.m_rect.m_x + last.m_rect.m_width == region.m_rect.m_x
+					&&  (last.m_rect.m_width + region.m_rect.m_width)*_texelSize < UINT16_MAX)
+					{
+						last.m_rect.m_width += region.m_rect.m_width;
+						continue;
+					}
+				}
+				else
 				{
-					if (currentKey != UINT32_MAX)
+					if (last.m_z            == region.m_z
+					&&  last.m_rect.m_x     == region.m_rect.m_x
+					&&  last.m_rect.m_width == region.m_rect.m_width
+					&&  last.m_rect.m_y + last.m_rect.m_height == region.m_rect.m_y)
 					{
-						m_renderCtx->updateTextureEnd();
+						last.m_rect.m_height += region.m_rect.m_height;
+						continue;
 					}
-					currentKey = key;
-					m_renderCtx->updateTextureBegin(handle, side, mip);
 				}
+			}
+
+			_region[num++] = region;
+		}
+
+		return num;
+	}
+
+	void Context::updateTextureSources(TextureHandle _handle, uint8_t _side, uint8_t _mip, TextureFormat::Enum _format, uint32_t _num)
+	{
+		const uint32_t bpp       = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(_format) );
+		const uint32_t texelSize = bpp/8;
+
+		// Only uncompressed 2D updates that don't overlap can be packed and
+		// merged, otherwise order of updates matters. Region pitch is 16-bit
+		// and UINT16_MAX means tightly packed, so rows must be shorter.
+		bool pack = 1 < _num
+			&& 0 == bpp%8
+			&& 0 < texelSize
+			&& !bimg::isCompressed(bimg::TextureFormat::Enum(_format) )
+			;
+
+		for (uint32_t ii = 0; ii < _num && pack; ++ii)
+		{
+			const TextureUpdateSource& source = m_textureUpdateSource[ii];
+			pack &= 1 == source.m_depth;
+			pack &= source.m_rect.m_width*texelSize < UINT16_MAX;
+
+			TextureUpdateRegion& region = m_textureUpdateRegion[ii];
+			region.m_rect  = source.m_rect;
+			region.m_z     = source.m_z;
+			region.m_depth = 1;
+		}
+
+		if (pack)
+		{
+			// Sorted by slice and top edge, only rects that start above bottom
+			// edge of current rect can overlap it.
+			bx::quickSort(
+				  m_textureUpdateRegion
+				, _num
+				, sizeof(TextureUpdateRegion)
+				, compareTextureUpdateRow
+				);
+
+			for (uint32_t ii = 0; ii < _num && pack; ++ii)
+			{
+				const TextureUpdateRegion& region = m_textureUpdateRegion[ii];
+				const uint32_t bottom = region.m_rect.m_y + region.m_rect.m_height;
+
+				for (uint32_t jj = ii+1
+					; jj < _num
+					&& pack
+					&& region.m_z == m_textureUpdateRegion[jj].m_z
+					&& bottom > m_textureUpdateRegion[jj].m_rect.m_y
+					; ++jj
+					)
+				{
+					Rect rect;
+					rect.setIntersect(region.m_rect, m_textureUpdateRegion[jj].m_rect);
+					pack &= rect.isZeroArea();
+				}
+			}
+		}
+
+		if (!pack)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const TextureUpdateSource& source = m_textureUpdateSource[ii];
+				m_renderCtx->updateTexture(_handle, _side, _mip, source.m_rect, source.m_z, source.m_depth, source.m_pitch, source.m_mem);
+				release(source.m_mem);
+			}
+
+			return;
+		}
+
+		uint32_t numRegions = _num;
+		for (uint32_t prev = 0; prev != numRegions;)
+		{
+			prev       = numRegions;
+			numRegions = mergeTextureUpdateRegions(m_textureUpdateRegion, numRegions, texelSize, true);
+			numRegions = mergeTextureUpdateRegions(m_textureUpdateRegion, numRegions, texelSize, false);
+		}
+
+		// Region offsets must be multiple of texel size, and of 4 bytes.
+		const uint32_t align = texelSize*4;
+
+		uint32_t size = 0;
+		for (uint32_t ii = 0; ii < numRegions; ++ii)
+		{
+			TextureUpdateRegion& region = m_textureUpdateRegion[ii];
+			region.m_pitch  = uint16_t(region.m_rect.m_width*texelSize);
+			region.m_offset = size;
+			region.m_size   = region.m_pitch*region.m_rect.m_height;
+			size = bx::strideAlign(size + region.m_size, align);
+		}
+
+		const Memory* mem = alloc(size);
 
-				m_renderCtx->updateTexture(handle, side, mip, rect, zz, depth, pitch, mem);
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const TextureUpdateSource& source = m_textureUpdateSource[ii];
+			const Rect& rect = source.m_rect;
 
-				release(mem);
+			const TextureUpdateRegion* region = m_textureUpdateRegion;
+			for (uint32_t jj = 0; jj < numRegions; ++jj, ++region)
+			{
+				if (region->m_z == source.m_z
+				&&  region->m_rect.m_x <= rect.m_x
+				&&  region->m_rect.m_y <= rect.m_y
+				&&  region->m_rect.m_x + region->m_rect.m_width  >= rect.m_x + rect.m_width
+				&&  region->m_rect.m_y + region->m_rect.m_height >= rect.m_y + rect.m_height)
+				{
+					break;
+				}
 			}
 
-			if (currentKey != UINT32_MAX)
+			const uint32_t rowSize  = rect.m_width*texelSize;
+			const uint32_t srcPitch = UINT16_MAX == source.m_pitch ? rowSize : source.m_pitch;
+			BX_CHECK(srcPitch*(rect.m_height-1) + rowSize <= source.m_mem->size
+				, "Texture update memory is too small (size %d, expected %d)."
+				, source.m_mem->size
+				, srcPitch*(rect.m_height-1) + rowSize
+				);
+
+			uint8_t* dst = &mem->data[region->m_offset
+				+ (rect.m_y - region->m_rect.m_y)*region->m_pitch
+				+ (rect.m_x - region->m_rect.m_x)*texelSize
+				];
+			bx::memCopy(dst, region->m_pitch, source.m_mem->data, srcPitch, rowSize, rect.m_height);
+
+			release(source.m_mem);
+		}
+
+		m_renderCtx->updateTextureRegions(_handle, _side, _mip, m_textureUpdateRegion, numRegions, mem);
+
+		release(mem);
+	}
+
+	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
+	{
+		if (m_textureUpdateBatch.sort() )
+		{
+			const uint32_t pos = _cmdbuf.m_pos;
+
+			// Sort is stable, updates of same texture side and mip stay in
+			// submission order.
+			for (uint32_t ii = 0, num = m_textureUpdateBatch.m_num; ii < num;)
 			{
+				const uint32_t key = m_textureUpdateBatch.m_keys[ii];
+
+				TextureHandle handle;
+				uint8_t side;
+				uint8_t mip;
+				uint8_t format;
+				uint32_t numSources = 0;
+
+				for (; ii < num && key == m_textureUpdateBatch.m_keys[ii]; ++ii)
+				{
+					_cmdbuf.m_pos = m_textureUpdateBatch.m_values[ii];
+
+					_cmdbuf.read(handle);
+					_cmdbuf.read(side);
+					_cmdbuf.read(mip);
+					_cmdbuf.read(format);
+
+					TextureUpdateSource& source = m_textureUpdateSource[numSources++];
+					_cmdbuf.read(source.m_rect);
+					_cmdbuf.read(source.m_z);
+					_cmdbuf.read(source.m_depth);
+					_cmdbuf.read(source.m_pitch);
+					_cmdbuf.read(source.m_mem);
+				}
+
+				m_renderCtx->updateTextureBegin(handle, side, mip);
+				updateTextureSources(handle, side, mip, TextureFormat::Enum(format), numSources);
 				m_renderCtx->updateTextureEnd();
 			}
 
@@ -2681,6 +5474,8 @@ namespace bgfx
 					rendererDestroy(m_renderCtx);
 					m_renderCtx = NULL;
 
+					m_uniformShadow.shutdown();
+
 					m_exit = true;
 				}
 				BX_FALLTHROUGH;
@@ -2994,6 +5789,7 @@ namespace bgfx
 					uint8_t mip;
 					_cmdbuf.read(mip);
 
+					_cmdbuf.skip<uint8_t>();
 					_cmdbuf.skip<Rect>();
 					_cmdbuf.skip<uint16_t>();
 					_cmdbuf.skip<uint16_t>();
@@ -3132,6 +5928,26 @@ namespace bgfx
 					const char* name = (const char*)_cmdbuf.skip(len);
 
 					m_renderCtx->createUniform(handle, type, num, name);
+					m_uniformShadow.create(handle, g_uniformTypeSize[type]*num);
+				}
+				break;
+
+			case CommandBuffer::CreateUniformBlock:
+				{
+					BGFX_PROFILER_SCOPE("CreateUniformBlock", 0xff2040ff);
+
+					UniformBlockHandle handle;
+					_cmdbuf.read(handle);
+
+					UniformBlock& block = m_uniformBlock[handle.idx];
+					_cmdbuf.read(block.m_num);
+					_cmdbuf.read(block.m_entry, sizeof(UniformBlock::Entry)*block.m_num);
+
+					block.m_size = 0;
+					for (uint32_t ii = 0, num = block.m_num; ii < num; ++ii)
+					{
+						block.m_size += block.m_entry[ii].m_size;
+					}
 				}
 				break;
 
@@ -3143,6 +5959,18 @@ namespace bgfx
 					_cmdbuf.read(handle);
 
 					m_renderCtx->destroyUniform(handle);
+					m_uniformShadow.destroy(handle);
+				}
+				break;
+
+			case CommandBuffer::DestroyUniformBlock:
+				{
+					BGFX_PROFILER_SCOPE("DestroyUniformBlock", 0xff2040ff);
+
+					UniformBlockHandle handle;
+					_cmdbuf.read(handle);
+
+					m_uniformBlock[handle.idx].m_num = 0;
 				}
 				break;
 
@@ -3285,12 +6113,16 @@ namespace bgfx
 		, deviceId(0)
 		, debug(BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		, profile(BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
+		, mergeDraws(false)
 		, callback(NULL)
 		, allocator(NULL)
 	{
 		limits.maxEncoders     = BGFX_CONFIG_DEFAULT_MAX_ENCODERS;
 		limits.transientVbSize = BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE;
 		limits.transientIbSize = BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE;
+		limits.maxDrawCalls    = BGFX_CONFIG_MAX_DRAW_CALLS;
+		limits.maxTransforms   = BGFX_CONFIG_MAX_MATRIX_CACHE;
+		limits.numFrames       = BGFX_CONFIG_DEFAULT_FRAMES_IN_FLIGHT;
 	}
 
 	void Attachment::init(TextureHandle _handle, Access::Enum _access, uint16_t _layer, uint16_t _mip, uint8_t _resolve)
@@ -3317,6 +6149,27 @@ namespace bgfx
 			return false;
 		}
 
+		if (2                          > _init.limits.maxDrawCalls
+		||  BGFX_CONFIG_MAX_DRAW_CALLS < _init.limits.maxDrawCalls)
+		{
+			BX_TRACE("init.limits.maxDrawCalls must be between 2 and %d.", BGFX_CONFIG_MAX_DRAW_CALLS);
+			return false;
+		}
+
+		if (2 > _init.limits.maxTransforms)
+		{
+			BX_TRACE("init.limits.maxTransforms must be at least 2.");
+			return false;
+		}
+
+		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
+		&& (2                                > _init.limits.numFrames
+		||  BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT < _init.limits.numFrames) )
+		{
+			BX_TRACE("init.limits.numFrames must be between 2 and %d.", BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT);
+			return false;
+		}
+
 		struct ErrorState
 		{
 			enum Enum
@@ -3363,7 +6216,7 @@ namespace bgfx
 		}
 
 		bx::memSet(&g_caps, 0, sizeof(g_caps) );
-		g_caps.limits.maxDrawCalls            = BGFX_CONFIG_MAX_DRAW_CALLS;
+		g_caps.limits.maxDrawCalls            = _init.limits.maxDrawCalls;
 		g_caps.limits.maxBlits                = BGFX_CONFIG_MAX_BLIT_ITEMS;
 		g_caps.limits.maxTextureSize          = 0;
 		g_caps.limits.maxTextureLayers        = 1;
@@ -3386,6 +6239,7 @@ namespace bgfx
 		g_caps.limits.maxEncoders             = (0 != BGFX_CONFIG_MULTITHREADED) ? _init.limits.maxEncoders : 1;
 		g_caps.limits.transientVbSize         = _init.limits.transientVbSize;
 		g_caps.limits.transientIbSize         = _init.limits.transientIbSize;
+		g_caps.limits.maxTransforms           = _init.limits.maxTransforms;
 
 		g_caps.vendorId = _init.vendorId;
 		g_caps.deviceId = _init.deviceId;
@@ -3501,6 +6355,11 @@ namespace bgfx
 		BGFX_ENCODER(setCondition(_handle, _visible) );
 	}
 
+	void Encoder::setMaterial(uint16_t _material)
+	{
+		BGFX_ENCODER(setMaterial(_material) );
+	}
+
 	void Encoder::setStencil(uint32_t _fstencil, uint32_t _bstencil)
 	{
 		BGFX_ENCODER(setStencil(_fstencil, _bstencil) );
@@ -3521,6 +6380,12 @@ namespace bgfx
 		return BGFX_ENCODER(setTransform(_mtx, _num) );
 	}
 
+	uint32_t Encoder::setTransformPalette(const void* _mtx, uint16_t _num, const void* _parent)
+	{
+		BX_CHECK(NULL != _mtx && NULL != _parent, "_mtx and _parent can't be NULL");
+		return BGFX_ENCODER(setTransformPalette(_mtx, _num, _parent) );
+	}
+
 	uint32_t Encoder::allocTransform(Transform* _transform, uint16_t _num)
 	{
 		return BGFX_ENCODER(allocTransform(_transform, _num) );
@@ -3531,6 +6396,25 @@ namespace bgfx
 		BGFX_ENCODER(setTransform(_cache, _num) );
 	}
 
+	void Encoder::setTransform(TransformBufferHandle _handle, uint16_t _start, uint16_t _num)
+	{
+		// Transform buffers are created and updated on API thread, handle
+		// lookup and copy of matrices not in persistent region yet must not
+		// overlap with it.
+		BGFX_MUTEX_SCOPE(s_ctx->m_transformBufferLock);
+
+		BGFX_CHECK_HANDLE("setTransform", s_ctx->m_transformBufferHandle, _handle);
+		const TransformBufferRef& ref = s_ctx->m_transformBufferRef[_handle.idx];
+		BX_CHECK(uint32_t(_start) + _num <= ref.m_num
+			, "Transform buffer out of bounds %d (num: %d)."
+			, _start + _num
+			, ref.m_num
+			);
+		const uint16_t start = bx::min(_start, ref.m_num);
+		const uint16_t num   = bx::min<uint16_t>(_num, ref.m_num - start);
+		BGFX_ENCODER(setTransformBuffer(ref.m_offset + start, num, &s_ctx->m_transformBuffer[ref.m_offset + start]) );
+	}
+
 	void Encoder::setUniform(UniformHandle _handle, const void* _value, uint16_t _num)
 	{
 		BGFX_CHECK_HANDLE("setUniform", s_ctx->m_uniformHandle, _handle);
@@ -3540,6 +6424,13 @@ namespace bgfx
 		BGFX_ENCODER(setUniform(uniform.m_type, _handle, _value, UINT16_MAX != _num ? _num : uniform.m_num) );
 	}
 
+	void Encoder::setUniformBlock(UniformBlockHandle _handle, const void* _data)
+	{
+		BGFX_CHECK_HANDLE("setUniformBlock", s_ctx->m_uniformBlockHandle, _handle);
+		const UniformBlock& block = s_ctx->m_uniformBlockRef[_handle.idx];
+		BGFX_ENCODER(setUniformBlock(_handle, _data, block.m_size) );
+	}
+
 	void Encoder::setIndexBuffer(IndexBufferHandle _handle)
 	{
 		setIndexBuffer(_handle, 0, UINT32_MAX);
@@ -3560,7 +6451,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
-		BGFX_ENCODER(setIndexBuffer(dib, _firstIndex, _numIndices) );
+		BGFX_ENCODER(setIndexBuffer(_handle, dib, _firstIndex, _numIndices) );
 	}
 
 	void Encoder::setIndexBuffer(const TransientIndexBuffer* _tib)
@@ -3604,7 +6495,7 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_layoutHandle, _layoutHandle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
-		BGFX_ENCODER(setVertexBuffer(_stream, dvb, _startVertex, _numVertices, _layoutHandle) );
+		BGFX_ENCODER(setVertexBuffer(_stream, _handle, dvb, _startVertex, _numVertices, _layoutHandle) );
 	}
 
 	void Encoder::setVertexBuffer(uint8_t _stream, DynamicVertexBufferHandle _handle)
@@ -3712,6 +6603,29 @@ namespace bgfx
 		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState) );
 	}
 
+	void Encoder::submitBatch(ViewId _id, ProgramHandle _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState)
+	{
+		BGFX_CHECK_HANDLE_INVALID_OK("submitBatch", s_ctx->m_programHandle, _program);
+		BGFX_ENCODER(submitBatch(_id, _program, _num, _mtx, _startIndex, _numIndices, _depth, _preserveState) );
+	}
+
+	void Encoder::beginDrawBundle(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_HANDLE("beginDrawBundle", s_ctx->m_drawBundleHandle, _handle);
+		BGFX_ENCODER(beginDrawBundle(&s_ctx->m_drawBundle[_handle.idx]) );
+	}
+
+	void Encoder::endDrawBundle()
+	{
+		BGFX_ENCODER(endDrawBundle() );
+	}
+
+	void Encoder::submit(ViewId _id, DrawBundleHandle _handle, const void* _mtx, uint16_t _num)
+	{
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_drawBundleHandle, _handle);
+		BGFX_ENCODER(submit(_id, s_ctx->m_drawBundle[_handle.idx], _mtx, _num) );
+	}
+
 	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BX_CHECK(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
@@ -3802,7 +6716,14 @@ namespace bgfx
 			, bimg::getName(bimg::TextureFormat::Enum(src.m_format) )
 			, bimg::getName(bimg::TextureFormat::Enum(dst.m_format) )
 			);
-		BX_UNUSED(src, dst);
+
+		if (!src.m_ready
+		||  !dst.m_ready)
+		{
+			BX_WARN(false, "blit: Texture is still loading asynchronously, blit is ignored.");
+			return;
+		}
+
 		BGFX_ENCODER(blit(_id, _dst, _dstMip, _dstX, _dstY, _dstZ, _src, _srcMip, _srcX, _srcY, _srcZ, _width, _height, _depth) );
 	}
 
@@ -4283,6 +7204,17 @@ namespace bgfx
 		return s_ctx->createTexture(_mem, _flags, _skip, _info, BackbufferRatio::Count, false);
 	}
 
+	TextureHandle createTextureAsync(const Memory* _mem, uint64_t _flags, uint8_t _skip)
+	{
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->createTextureAsync(_mem, _flags, _skip);
+	}
+
+	bool isTextureReady(TextureHandle _handle)
+	{
+		return s_ctx->isTextureReady(_handle);
+	}
+
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height)
 	{
 		switch (_ratio)
@@ -4610,6 +7542,16 @@ namespace bgfx
 		s_ctx->destroyUniform(_handle);
 	}
 
+	UniformBlockHandle createUniformBlock(const UniformHandle* _uniforms, uint16_t _num)
+	{
+		return s_ctx->createUniformBlock(_uniforms, _num);
+	}
+
+	void destroy(UniformBlockHandle _handle)
+	{
+		s_ctx->destroyUniformBlock(_handle);
+	}
+
 	OcclusionQueryHandle createOcclusionQuery()
 	{
 		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
@@ -4628,6 +7570,32 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	DrawBundleHandle createDrawBundle()
+	{
+		return s_ctx->createDrawBundle();
+	}
+
+	void destroy(DrawBundleHandle _handle)
+	{
+		s_ctx->destroyDrawBundle(_handle);
+	}
+
+	TransformBufferHandle createTransformBuffer(uint16_t _num)
+	{
+		return s_ctx->createTransformBuffer(_num);
+	}
+
+	void updateTransformBuffer(TransformBufferHandle _handle, uint16_t _start, const void* _mtx, uint16_t _num)
+	{
+		BX_CHECK(NULL != _mtx, "_mtx can't be NULL");
+		s_ctx->updateTransformBuffer(_handle, _start, _mtx, _num);
+	}
+
+	void destroy(TransformBufferHandle _handle)
+	{
+		s_ctx->destroyTransformBuffer(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -4728,6 +7696,12 @@ namespace bgfx
 		s_ctx->setViewOrder(_id, _num, _order);
 	}
 
+	void setViewUniform(ViewId _id, UniformHandle _handle, const void* _value, uint16_t _num)
+	{
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		s_ctx->setViewUniform(_id, _handle, _value, _num);
+	}
+
 	void resetView(ViewId _id)
 	{
 		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
@@ -4752,6 +7726,12 @@ namespace bgfx
 		s_ctx->m_encoder0->setCondition(_handle, _visible);
 	}
 
+	void setMaterial(uint16_t _material)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->setMaterial(_material);
+	}
+
 	void setStencil(uint32_t _fstencil, uint32_t _bstencil)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -4776,6 +7756,12 @@ namespace bgfx
 		return s_ctx->m_encoder0->setTransform(_mtx, _num);
 	}
 
+	uint32_t setTransformPalette(const void* _mtx, uint16_t _num, const void* _parent)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->m_encoder0->setTransformPalette(_mtx, _num, _parent);
+	}
+
 	uint32_t allocTransform(Transform* _transform, uint16_t _num)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -4788,12 +7774,24 @@ namespace bgfx
 		s_ctx->m_encoder0->setTransform(_cache, _num);
 	}
 
+	void setTransform(TransformBufferHandle _handle, uint16_t _start, uint16_t _num)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->setTransform(_handle, _start, _num);
+	}
+
 	void setUniform(UniformHandle _handle, const void* _value, uint16_t _num)
 	{
 		BGFX_CHECK_API_THREAD();
 		s_ctx->m_encoder0->setUniform(_handle, _value, _num);
 	}
 
+	void setUniformBlock(UniformBlockHandle _handle, const void* _data)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->setUniformBlock(_handle, _data);
+	}
+
 	void setIndexBuffer(IndexBufferHandle _handle)
 	{
 		setIndexBuffer(_handle, 0, UINT32_MAX);
@@ -4944,6 +7942,30 @@ namespace bgfx
 		s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState);
 	}
 
+	void submitBatch(ViewId _id, ProgramHandle _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->submitBatch(_id, _program, _num, _mtx, _startIndex, _numIndices, _depth, _preserveState);
+	}
+
+	void beginDrawBundle(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->beginDrawBundle(_handle);
+	}
+
+	void endDrawBundle()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->endDrawBundle();
+	}
+
+	void submit(ViewId _id, DrawBundleHandle _handle, const void* _mtx, uint16_t _num)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->submit(_id, _handle, _mtx, _num);
+	}
+
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -5014,6 +8036,42 @@ namespace bgfx
 		BGFX_CHECK_API_THREAD();
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
+
+	bool startFrameTrace(const char* _filePath)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->startFrameTrace(_filePath);
+	}
+
+	void stopFrameTrace()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->stopFrameTrace();
+	}
+
+	uint32_t openFrameTrace(const char* _filePath)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->openFrameTrace(_filePath);
+	}
+
+	bool replayFrameTrace()
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->replayFrameTrace();
+	}
+
+	void closeFrameTrace()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->closeFrameTrace();
+	}
+
+	bool saveProfilerTrace(const char* _filePath)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->saveProfilerTrace(_filePath);
+	}
 } // namespace bgfx
 
 #if BX_PLATFORM_WINDOWS
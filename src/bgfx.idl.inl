@@ -442,6 +442,19 @@ BGFX_C_API bgfx_texture_handle_t bgfx_create_texture(const bgfx_memory_t* _mem,
 	return handle_ret.c;
 }
 
+BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_async(const bgfx_memory_t* _mem, uint64_t _flags, uint8_t _skip)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createTextureAsync((const bgfx::Memory*)_mem, _flags, _skip);
+	return handle_ret.c;
+}
+
+BGFX_C_API bool bgfx_is_texture_ready(bgfx_texture_handle_t _handle)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	return bgfx::isTextureReady(handle.cpp);
+}
+
 BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_2d(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags, const bgfx_memory_t* _mem)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle_ret;
@@ -587,6 +600,19 @@ BGFX_C_API void bgfx_destroy_uniform(bgfx_uniform_handle_t _handle)
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_uniform_block_handle_t bgfx_create_uniform_block(const bgfx_uniform_handle_t* _uniforms, uint16_t _num)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createUniformBlock((const bgfx::UniformHandle*)_uniforms, _num);
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_destroy_uniform_block(bgfx_uniform_block_handle_t _handle)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API bgfx_occlusion_query_handle_t bgfx_create_occlusion_query(void)
 {
 	union { bgfx_occlusion_query_handle_t c; bgfx::OcclusionQueryHandle cpp; } handle_ret;
@@ -606,6 +632,38 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_draw_bundle_handle_t bgfx_create_draw_bundle(void)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createDrawBundle();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_destroy_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
+BGFX_C_API bgfx_transform_buffer_handle_t bgfx_create_transform_buffer(uint16_t _num)
+{
+	union { bgfx_transform_buffer_handle_t c; bgfx::TransformBufferHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createTransformBuffer(_num);
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_update_transform_buffer(bgfx_transform_buffer_handle_t _handle, uint16_t _start, const void* _mtx, uint16_t _num)
+{
+	union { bgfx_transform_buffer_handle_t c; bgfx::TransformBufferHandle cpp; } handle = { _handle };
+	bgfx::updateTransformBuffer(handle.cpp, _start, _mtx, _num);
+}
+
+BGFX_C_API void bgfx_destroy_transform_buffer(bgfx_transform_buffer_handle_t _handle)
+{
+	union { bgfx_transform_buffer_handle_t c; bgfx::TransformBufferHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -667,6 +725,12 @@ BGFX_C_API void bgfx_set_view_order(bgfx_view_id_t _id, uint16_t _num, const bgf
 	bgfx::setViewOrder((bgfx::ViewId)_id, _num, (const bgfx::ViewId*)_order);
 }
 
+BGFX_C_API void bgfx_set_view_uniform(bgfx_view_id_t _id, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num)
+{
+	union { bgfx_uniform_handle_t c; bgfx::UniformHandle cpp; } handle = { _handle };
+	bgfx::setViewUniform((bgfx::ViewId)_id, handle.cpp, _value, _num);
+}
+
 BGFX_C_API bgfx_encoder_t* bgfx_encoder_begin(bool _forThread)
 {
 	return (bgfx_encoder_t*)bgfx::begin(_forThread);
@@ -696,6 +760,12 @@ BGFX_C_API void bgfx_encoder_set_condition(bgfx_encoder_t* _this, bgfx_occlusion
 	This->setCondition(handle.cpp, _visible);
 }
 
+BGFX_C_API void bgfx_encoder_set_material(bgfx_encoder_t* _this, uint16_t _material)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->setMaterial(_material);
+}
+
 BGFX_C_API void bgfx_encoder_set_stencil(bgfx_encoder_t* _this, uint32_t _fstencil, uint32_t _bstencil)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -720,12 +790,25 @@ BGFX_C_API uint32_t bgfx_encoder_set_transform(bgfx_encoder_t* _this, const void
 	return This->setTransform(_mtx, _num);
 }
 
+BGFX_C_API uint32_t bgfx_encoder_set_transform_palette(bgfx_encoder_t* _this, const void* _mtx, uint16_t _num, const void* _parent)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	return This->setTransformPalette(_mtx, _num, _parent);
+}
+
 BGFX_C_API void bgfx_encoder_set_transform_cached(bgfx_encoder_t* _this, uint32_t _cache, uint16_t _num)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
 	This->setTransform(_cache, _num);
 }
 
+BGFX_C_API void bgfx_encoder_set_transform_buffer(bgfx_encoder_t* _this, bgfx_transform_buffer_handle_t _handle, uint16_t _start, uint16_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_transform_buffer_handle_t c; bgfx::TransformBufferHandle cpp; } handle = { _handle };
+	This->setTransform(handle.cpp, _start, _num);
+}
+
 BGFX_C_API uint32_t bgfx_encoder_alloc_transform(bgfx_encoder_t* _this, bgfx_transform_t* _transform, uint16_t _num)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -739,6 +822,13 @@ BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_han
 	This->setUniform(handle.cpp, _value, _num);
 }
 
+BGFX_C_API void bgfx_encoder_set_uniform_block(bgfx_encoder_t* _this, bgfx_uniform_block_handle_t _handle, const void* _data)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	This->setUniformBlock(handle.cpp, _data);
+}
+
 BGFX_C_API void bgfx_encoder_set_index_buffer(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -851,6 +941,33 @@ BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id
 	This->submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _preserveState);
 }
 
+BGFX_C_API void bgfx_encoder_submit_batch(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	This->submitBatch((bgfx::ViewId)_id, program.cpp, _num, _mtx, _startIndex, _numIndices, _depth, _preserveState);
+}
+
+BGFX_C_API void bgfx_encoder_begin_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	This->beginDrawBundle(handle.cpp);
+}
+
+BGFX_C_API void bgfx_encoder_end_draw_bundle(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->endDrawBundle();
+}
+
+BGFX_C_API void bgfx_encoder_submit_draw_bundle(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle, const void* _mtx, uint16_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	This->submit((bgfx::ViewId)_id, handle.cpp, _mtx, _num);
+}
+
 BGFX_C_API void bgfx_encoder_set_compute_index_buffer(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -928,6 +1045,36 @@ BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, con
 	bgfx::requestScreenShot(handle.cpp, _filePath);
 }
 
+BGFX_C_API bool bgfx_start_frame_trace(const char* _filePath)
+{
+	return bgfx::startFrameTrace(_filePath);
+}
+
+BGFX_C_API void bgfx_stop_frame_trace(void)
+{
+	bgfx::stopFrameTrace();
+}
+
+BGFX_C_API uint32_t bgfx_open_frame_trace(const char* _filePath)
+{
+	return bgfx::openFrameTrace(_filePath);
+}
+
+BGFX_C_API bool bgfx_replay_frame_trace(void)
+{
+	return bgfx::replayFrameTrace();
+}
+
+BGFX_C_API void bgfx_close_frame_trace(void)
+{
+	bgfx::closeFrameTrace();
+}
+
+BGFX_C_API bool bgfx_save_profiler_trace(const char* _filePath)
+{
+	return bgfx::saveProfilerTrace(_filePath);
+}
+
 BGFX_C_API bgfx_render_frame_t bgfx_render_frame(int32_t _msecs)
 {
 	return (bgfx_render_frame_t)bgfx::renderFrame(_msecs);
@@ -972,6 +1119,11 @@ BGFX_C_API void bgfx_set_condition(bgfx_occlusion_query_handle_t _handle, bool _
 	bgfx::setCondition(handle.cpp, _visible);
 }
 
+BGFX_C_API void bgfx_set_material(uint16_t _material)
+{
+	bgfx::setMaterial(_material);
+}
+
 BGFX_C_API void bgfx_set_stencil(uint32_t _fstencil, uint32_t _bstencil)
 {
 	bgfx::setStencil(_fstencil, _bstencil);
@@ -992,11 +1144,22 @@ BGFX_C_API uint32_t bgfx_set_transform(const void* _mtx, uint16_t _num)
 	return bgfx::setTransform(_mtx, _num);
 }
 
+BGFX_C_API uint32_t bgfx_set_transform_palette(const void* _mtx, uint16_t _num, const void* _parent)
+{
+	return bgfx::setTransformPalette(_mtx, _num, _parent);
+}
+
 BGFX_C_API void bgfx_set_transform_cached(uint32_t _cache, uint16_t _num)
 {
 	bgfx::setTransform(_cache, _num);
 }
 
+BGFX_C_API void bgfx_set_transform_buffer(bgfx_transform_buffer_handle_t _handle, uint16_t _start, uint16_t _num)
+{
+	union { bgfx_transform_buffer_handle_t c; bgfx::TransformBufferHandle cpp; } handle = { _handle };
+	bgfx::setTransform(handle.cpp, _start, _num);
+}
+
 BGFX_C_API uint32_t bgfx_alloc_transform(bgfx_transform_t* _transform, uint16_t _num)
 {
 	return bgfx::allocTransform((bgfx::Transform*)_transform, _num);
@@ -1008,6 +1171,12 @@ BGFX_C_API void bgfx_set_uniform(bgfx_uniform_handle_t _handle, const void* _val
 	bgfx::setUniform(handle.cpp, _value, _num);
 }
 
+BGFX_C_API void bgfx_set_uniform_block(bgfx_uniform_block_handle_t _handle, const void* _data)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	bgfx::setUniformBlock(handle.cpp, _data);
+}
+
 BGFX_C_API void bgfx_set_index_buffer(bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1101,6 +1270,29 @@ BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _
 	bgfx::submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _preserveState);
 }
 
+BGFX_C_API void bgfx_submit_batch(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState)
+{
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	bgfx::submitBatch((bgfx::ViewId)_id, program.cpp, _num, _mtx, _startIndex, _numIndices, _depth, _preserveState);
+}
+
+BGFX_C_API void bgfx_begin_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::beginDrawBundle(handle.cpp);
+}
+
+BGFX_C_API void bgfx_end_draw_bundle(void)
+{
+	bgfx::endDrawBundle();
+}
+
+BGFX_C_API void bgfx_submit_draw_bundle(bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle, const void* _mtx, uint16_t _num)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::submit((bgfx::ViewId)_id, handle.cpp, _mtx, _num);
+}
+
 BGFX_C_API void bgfx_set_compute_index_buffer(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1269,6 +1461,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_is_texture_valid,
 			bgfx_calc_texture_size,
 			bgfx_create_texture,
+			bgfx_create_texture_async,
+			bgfx_is_texture_ready,
 			bgfx_create_texture_2d,
 			bgfx_create_texture_2d_scaled,
 			bgfx_create_texture_3d,
@@ -1291,9 +1485,16 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_uniform,
 			bgfx_get_uniform_info,
 			bgfx_destroy_uniform,
+			bgfx_create_uniform_block,
+			bgfx_destroy_uniform_block,
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_create_draw_bundle,
+			bgfx_destroy_draw_bundle,
+			bgfx_create_transform_buffer,
+			bgfx_update_transform_buffer,
+			bgfx_destroy_transform_buffer,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba8,
 			bgfx_set_view_name,
@@ -1306,18 +1507,23 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_set_view_frame_buffer,
 			bgfx_set_view_transform,
 			bgfx_set_view_order,
+			bgfx_set_view_uniform,
 			bgfx_encoder_begin,
 			bgfx_encoder_end,
 			bgfx_encoder_set_marker,
 			bgfx_encoder_set_state,
 			bgfx_encoder_set_condition,
+			bgfx_encoder_set_material,
 			bgfx_encoder_set_stencil,
 			bgfx_encoder_set_scissor,
 			bgfx_encoder_set_scissor_cached,
 			bgfx_encoder_set_transform,
+			bgfx_encoder_set_transform_palette,
 			bgfx_encoder_set_transform_cached,
+			bgfx_encoder_set_transform_buffer,
 			bgfx_encoder_alloc_transform,
 			bgfx_encoder_set_uniform,
+			bgfx_encoder_set_uniform_block,
 			bgfx_encoder_set_index_buffer,
 			bgfx_encoder_set_dynamic_index_buffer,
 			bgfx_encoder_set_transient_index_buffer,
@@ -1334,6 +1540,10 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_submit,
 			bgfx_encoder_submit_occlusion_query,
 			bgfx_encoder_submit_indirect,
+			bgfx_encoder_submit_batch,
+			bgfx_encoder_begin_draw_bundle,
+			bgfx_encoder_end_draw_bundle,
+			bgfx_encoder_submit_draw_bundle,
 			bgfx_encoder_set_compute_index_buffer,
 			bgfx_encoder_set_compute_vertex_buffer,
 			bgfx_encoder_set_compute_dynamic_index_buffer,
@@ -1345,6 +1555,12 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_discard,
 			bgfx_encoder_blit,
 			bgfx_request_screen_shot,
+			bgfx_start_frame_trace,
+			bgfx_stop_frame_trace,
+			bgfx_open_frame_trace,
+			bgfx_replay_frame_trace,
+			bgfx_close_frame_trace,
+			bgfx_save_profiler_trace,
 			bgfx_render_frame,
 			bgfx_set_platform_data,
 			bgfx_get_internal_data,
@@ -1353,13 +1569,17 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_set_marker,
 			bgfx_set_state,
 			bgfx_set_condition,
+			bgfx_set_material,
 			bgfx_set_stencil,
 			bgfx_set_scissor,
 			bgfx_set_scissor_cached,
 			bgfx_set_transform,
+			bgfx_set_transform_palette,
 			bgfx_set_transform_cached,
+			bgfx_set_transform_buffer,
 			bgfx_alloc_transform,
 			bgfx_set_uniform,
+			bgfx_set_uniform_block,
 			bgfx_set_index_buffer,
 			bgfx_set_dynamic_index_buffer,
 			bgfx_set_transient_index_buffer,
@@ -1376,6 +1596,10 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_submit,
 			bgfx_submit_occlusion_query,
 			bgfx_submit_indirect,
+			bgfx_submit_batch,
+			bgfx_begin_draw_bundle,
+			bgfx_end_draw_bundle,
+			bgfx_submit_draw_bundle,
 			bgfx_set_compute_index_buffer,
 			bgfx_set_compute_vertex_buffer,
 			bgfx_set_compute_dynamic_index_buffer,
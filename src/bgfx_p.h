@@ -52,15 +52,19 @@
 
 #if BGFX_CONFIG_PROFILER
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN(_name, _abgr)            g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_END()                          g_callback->profilerEnd()
-#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
+#	define BGFX_PROFILER_BEGIN(_name, _abgr)            bgfx::profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__), false)
+#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    bgfx::profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__), true)
+#	define BGFX_PROFILER_END()                          bgfx::profilerEnd()
+#	define BGFX_PROFILER_ASYNC_BEGIN(_name, _id)        bgfx::profilerAsync(true, _name, _id)
+#	define BGFX_PROFILER_ASYNC_END(_name, _id)          bgfx::profilerAsync(false, _name, _id)
+#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) bgfx::profilerSetThreadName(_name)
 #else
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    BX_NOOP()
 #	define BGFX_PROFILER_END()                          BX_NOOP()
+#	define BGFX_PROFILER_ASYNC_BEGIN(_name, _id)        BX_NOOP()
+#	define BGFX_PROFILER_ASYNC_END(_name, _id)          BX_NOOP()
 #	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
 #endif // BGFX_PROFILER_SCOPE
 
@@ -462,23 +466,46 @@ namespace bgfx
 		const Memory* m_mem;
 	};
 
-	extern const uint32_t g_uniformTypeSize[UniformType::Count+1];
+	// Texture update region, data is at offset in shared staging memory.
+	struct TextureUpdateRegion
+	{
+		Rect     m_rect;
+		uint16_t m_z;
+		uint16_t m_depth;
+		uint16_t m_pitch;
+		uint32_t m_offset;
+		uint32_t m_size;
+	};
+
+	extern const uint32_t g_uniformTypeSize[UniformType::Count+2];
 	extern CallbackI* g_callback;
 	extern bx::AllocatorI* g_allocator;
 	extern Caps g_caps;
 
 	typedef bx::StringT<&g_allocator> String;
 
+	// Profiler events are forwarded to CallbackI, and recorded by built-in
+	// profiler while BGFX_DEBUG_PROFILER is set. Async events are recorded
+	// only, they are used for spans that don't nest with other scopes on the
+	// same thread.
+	void profilerBegin(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line, bool _literal);
+	void profilerEnd();
+	void profilerAsync(bool _begin, const char* _name, uint8_t _id);
+	void profilerSetThreadName(const char* _name);
+	void profilerSetEnabled(bool _enabled);
+	bool profilerSave(const char* _filePath);
+	void profilerShutdown();
+
 	struct ProfilerScope
 	{
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
 		{
-			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			profilerBegin(_name, _abgr, _filePath, _line, true);
 		}
 
 		~ProfilerScope()
 		{
-			g_callback->profilerEnd();
+			profilerEnd();
 		}
 	};
 
@@ -770,7 +797,10 @@ namespace bgfx
 	public:
 		CommandBuffer()
 			: m_pos(0)
-			, m_size(BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE)
+			, m_size(UINT32_MAX)
+			, m_block(NULL)
+			, m_numBlocks(0)
+			, m_maxBlocks(0)
 		{
 			finish();
 		}
@@ -793,6 +823,7 @@ namespace bgfx
 			ResizeTexture,
 			CreateFrameBuffer,
 			CreateUniform,
+			CreateUniformBlock,
 			UpdateViewName,
 			InvalidateOcclusionQuery,
 			SetName,
@@ -808,20 +839,34 @@ namespace bgfx
 			DestroyTexture,
 			DestroyFrameBuffer,
 			DestroyUniform,
+			DestroyUniformBlock,
 			ReadTexture,
 			RequestScreenShot,
 		};
 
 		void write(const void* _data, uint32_t _size)
 		{
-			BX_CHECK(m_size == BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE, "Called write outside start/finish?");
-			BX_CHECK(m_pos + _size <= m_size
-				, "CommandBuffer::write error (pos: %d-%d, size: %d)."
-				, m_pos
-				, m_pos + _size
-				, m_size
+			BX_CHECK(m_size == UINT32_MAX, "Called write outside start/finish?");
+			BX_CHECK(_size <= BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
+				, "CommandBuffer::write error (size: %d, block size: %d)."
+				, _size
+				, BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
 				);
-			bx::memCopy(&m_buffer[m_pos], _data, _size);
+			nextBlock(_size);
+
+			const uint32_t idx = m_pos / BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			while (idx > m_numBlocks)
+			{
+				if (m_numBlocks == m_maxBlocks)
+				{
+					m_maxBlocks = bx::max<uint32_t>(m_maxBlocks*2, 4);
+					m_block = (uint8_t**)BX_REALLOC(g_allocator, m_block, m_maxBlocks*sizeof(uint8_t*) );
+				}
+
+				m_block[m_numBlocks++] = allocBlock();
+			}
+
+			bx::memCopy(getPtr(m_pos), _data, _size);
 			m_pos += _size;
 		}
 
@@ -834,13 +879,14 @@ namespace bgfx
 
 		void read(void* _data, uint32_t _size)
 		{
+			nextBlock(_size);
 			BX_CHECK(m_pos + _size <= m_size
 				, "CommandBuffer::read error (pos: %d-%d, size: %d)."
 				, m_pos
 				, m_pos + _size
 				, m_size
 				);
-			bx::memCopy(_data, &m_buffer[m_pos], _size);
+			bx::memCopy(_data, getPtr(m_pos), _size);
 			m_pos += _size;
 		}
 
@@ -853,13 +899,14 @@ namespace bgfx
 
 		const uint8_t* skip(uint32_t _size)
 		{
+			nextBlock(_size);
 			BX_CHECK(m_pos + _size <= m_size
 				, "CommandBuffer::skip error (pos: %d-%d, size: %d)."
 				, m_pos
 				, m_pos + _size
 				, m_size
 				);
-			const uint8_t* result = &m_buffer[m_pos];
+			const uint8_t* result = getPtr(m_pos);
 			m_pos += _size;
 			return result;
 		}
@@ -885,8 +932,10 @@ namespace bgfx
 
 		void start()
 		{
+			releaseBlocks();
+
 			m_pos = 0;
-			m_size = BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			m_size = UINT32_MAX;
 		}
 
 		void finish()
@@ -897,9 +946,59 @@ namespace bgfx
 			m_pos = 0;
 		}
 
+		void destroy()
+		{
+			releaseBlocks();
+
+			BX_FREE(g_allocator, m_block);
+			m_block     = NULL;
+			m_maxBlocks = 0;
+		}
+
+		// Returns all pooled blocks back to allocator.
+		static void destroyBlockPool();
+
 		uint32_t m_pos;
 		uint32_t m_size;
-		uint8_t m_buffer[BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE];
+
+	private:
+		// Data never straddles blocks. When it doesn't fit into the rest of
+		// current block, position moves to start of the next block. Reader
+		// applies the same rule, so positions stay stable between both.
+		void nextBlock(uint32_t _size)
+		{
+			const uint32_t offset = m_pos % BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			if (offset + _size > BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE)
+			{
+				m_pos += BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE - offset;
+			}
+		}
+
+		uint8_t* getPtr(uint32_t _pos)
+		{
+			const uint32_t idx    = _pos / BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			const uint32_t offset = _pos % BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			uint8_t* block = 0 == idx ? m_buffer : m_block[idx-1];
+			return &block[offset];
+		}
+
+		void releaseBlocks()
+		{
+			for (uint32_t ii = 0, num = m_numBlocks; ii < num; ++ii)
+			{
+				freeBlock(m_block[ii]);
+			}
+
+			m_numBlocks = 0;
+		}
+
+		static uint8_t* allocBlock();
+		static void freeBlock(uint8_t* _block);
+
+		uint8_t** m_block;
+		uint32_t  m_numBlocks;
+		uint32_t  m_maxBlocks;
+		uint8_t   m_buffer[BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE];
 	};
 
 //
@@ -928,7 +1027,10 @@ constexpr uint64_t kSortKeyDraw0TransMask      = uint64_t(0x3)<<kSortKeyDraw0Tra
 constexpr uint8_t  kSortKeyDraw0ProgramShift   = kSortKeyDraw0TransShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
 constexpr uint64_t kSortKeyDraw0ProgramMask    = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw0ProgramShift;
 
-constexpr uint8_t  kSortKeyDraw0DepthShift     = kSortKeyDraw0ProgramShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH;
+constexpr uint8_t  kSortKeyDraw0MaterialShift  = kSortKeyDraw0ProgramShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL;
+constexpr uint64_t kSortKeyDraw0MaterialMask   = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL)-1)<<kSortKeyDraw0MaterialShift;
+
+constexpr uint8_t  kSortKeyDraw0DepthShift     = kSortKeyDraw0MaterialShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH;
 constexpr uint64_t kSortKeyDraw0DepthMask      = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH)-1)<<kSortKeyDraw0DepthShift;
 
 //
@@ -941,6 +1043,9 @@ constexpr uint64_t kSortKeyDraw1TransMask      = uint64_t(0x3)<<kSortKeyDraw1Tra
 constexpr uint8_t  kSortKeyDraw1ProgramShift   = kSortKeyDraw1TransShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
 constexpr uint64_t kSortKeyDraw1ProgramMask    = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw1ProgramShift;
 
+constexpr uint8_t  kSortKeyDraw1MaterialShift  = kSortKeyDraw1ProgramShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL;
+constexpr uint64_t kSortKeyDraw1MaterialMask   = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL)-1)<<kSortKeyDraw1MaterialShift;
+
 //
 constexpr uint8_t  kSortKeyDraw2SeqShift       = kSortKeyDrawTypeBitShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
 constexpr uint64_t kSortKeyDraw2SeqMask        = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ)-1)<<kSortKeyDraw2SeqShift;
@@ -951,6 +1056,9 @@ constexpr uint64_t kSortKeyDraw2TransMask      = uint64_t(0x3)<<kSortKeyDraw2Tra
 constexpr uint8_t  kSortKeyDraw2ProgramShift   = kSortKeyDraw2TransShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM;
 constexpr uint64_t kSortKeyDraw2ProgramMask    = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyDraw2ProgramShift;
 
+constexpr uint8_t  kSortKeyDraw2MaterialShift  = kSortKeyDraw2ProgramShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL;
+constexpr uint64_t kSortKeyDraw2MaterialMask   = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL)-1)<<kSortKeyDraw2MaterialShift;
+
 //
 constexpr uint8_t  kSortKeyComputeSeqShift     = kSortKeyDrawBitShift - BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ;
 constexpr uint64_t kSortKeyComputeSeqMask      = ( (uint64_t(1)<<BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ)-1)<<kSortKeyComputeSeqShift;
@@ -959,6 +1067,12 @@ constexpr uint8_t  kSortKeyComputeProgramShift = kSortKeyComputeSeqShift - BGFX_
 constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRAMS-1)<<kSortKeyComputeProgramShift;
 
 	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_VIEWS <= (1<<kSortKeyViewNumBits) );
+	BX_STATIC_ASSERT(kSortKeyViewNumBits + 1 + kSortKeyDrawTypeNumBits + kSortKeyTransNumBits
+		+ BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
+		+ BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+		+ BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH
+		<= 64
+		); // Draw key must fit into 64 bits.
 	BX_STATIC_ASSERT( (BGFX_CONFIG_MAX_PROGRAMS & (BGFX_CONFIG_MAX_PROGRAMS-1) ) == 0); // Must be power of 2.
 	BX_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
 		| kSortKeyViewMask
@@ -966,6 +1080,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		| kSortKeyDrawTypeMask
 		| kSortKeyDraw0TransMask
 		| kSortKeyDraw0ProgramMask
+		| kSortKeyDraw0MaterialMask
 		| kSortKeyDraw0DepthMask
 		) == (0
 		^ kSortKeyViewMask
@@ -973,6 +1088,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		^ kSortKeyDrawTypeMask
 		^ kSortKeyDraw0TransMask
 		^ kSortKeyDraw0ProgramMask
+		^ kSortKeyDraw0MaterialMask
 		^ kSortKeyDraw0DepthMask
 		) );
 	BX_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
@@ -982,6 +1098,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		| kSortKeyDraw1DepthMask
 		| kSortKeyDraw1TransMask
 		| kSortKeyDraw1ProgramMask
+		| kSortKeyDraw1MaterialMask
 		) == (0
 		^ kSortKeyViewMask
 		^ kSortKeyDrawBit
@@ -989,6 +1106,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		^ kSortKeyDraw1DepthMask
 		^ kSortKeyDraw1TransMask
 		^ kSortKeyDraw1ProgramMask
+		^ kSortKeyDraw1MaterialMask
 		) );
 	BX_STATIC_ASSERT( (0 // Render key mask shouldn't overlap.
 		| kSortKeyViewMask
@@ -997,6 +1115,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		| kSortKeyDraw2SeqMask
 		| kSortKeyDraw2TransMask
 		| kSortKeyDraw2ProgramMask
+		| kSortKeyDraw2MaterialMask
 		) == (0
 		^ kSortKeyViewMask
 		^ kSortKeyDrawBit
@@ -1004,6 +1123,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		^ kSortKeyDraw2SeqMask
 		^ kSortKeyDraw2TransMask
 		^ kSortKeyDraw2ProgramMask
+		^ kSortKeyDraw2MaterialMask
 		) );
 	BX_STATIC_ASSERT( (0 // Compute key mask shouldn't overlap.
 		| kSortKeyViewMask
@@ -1025,22 +1145,25 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	// |  view-+|                                                       |
 	// |        +-draw                                                  |
 	// |----------------------------------------------------------------| Draw Key 0 - Sort by program
-	// |        |kkttpppppppppdddddddddddddddddddddddddddddddd          |
-	// |        |   ^        ^                               ^          |
-	// |        |   |        |                               |          |
-	// |        |   +-trans  +-program                 depth-+          |
+	// |        |kkttpppppppppmmmmmmmmdddddddddddddddddddddddddddddddd  |
+	// |        |   ^        ^       ^                               ^  |
+	// |        |   |        |       |                               |  |
+	// |        |   +-trans  |       +-material                depth-+  |
+	// |        |            +-program                                  |
 	// |        |                                                       |
 	// |----------------------------------------------------------------| Draw Key 1 - Sort by depth
-	// |        |kkddddddddddddddddddddddddddddddddttppppppppp          |
-	// |        |                                ^^ ^        ^          |
-	// |        |                                || +-trans  |          |
-	// |        |                          depth-+   program-+          |
+	// |        |kkddddddddddddddddddddddddddddddddttpppppppppmmmmmmmm  |
+	// |        |                                ^^ ^        ^       ^  |
+	// |        |                                || +-trans  |       |  |
+	// |        |                          depth-+   program-+       |  |
+	// |        |                                           material-+  |
 	// |        |                                                       |
 	// |----------------------------------------------------------------| Draw Key 2 - Sequential
-	// |        |kkssssssssssssssssssssttppppppppp                      |
-	// |        |                     ^ ^        ^                      |
-	// |        |                     | |        |                      |
-	// |        |                 seq-+ +-trans  +-program              |
+	// |        |kkssssssssssssssssssssttpppppppppmmmmmmmm              |
+	// |        |                     ^ ^        ^       ^              |
+	// |        |                     | |        |       |              |
+	// |        |                 seq-+ +-trans  |       +-material     |
+	// |        |                                +-program              |
 	// |        |                                                       |
 	// |----------------------------------------------------------------| Compute Key
 	// |        |ssssssssssssssssssssppppppppp                          |
@@ -1065,11 +1188,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			{
 			case SortProgram:
 				{
-					const uint64_t depth   = (uint64_t(m_depth      ) << kSortKeyDraw0DepthShift  ) & kSortKeyDraw0DepthMask;
-					const uint64_t program = (uint64_t(m_program.idx) << kSortKeyDraw0ProgramShift) & kSortKeyDraw0ProgramMask;
-					const uint64_t trans   = (uint64_t(m_trans      ) << kSortKeyDraw0TransShift  ) & kSortKeyDraw0TransMask;
-					const uint64_t view    = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
-					const uint64_t key     = view|kSortKeyDrawBit|kSortKeyDrawTypeProgram|trans|program|depth;
+					const uint64_t depth    = (uint64_t(m_depth      ) << kSortKeyDraw0DepthShift  ) & kSortKeyDraw0DepthMask;
+					const uint64_t material = (uint64_t(m_material   ) << kSortKeyDraw0MaterialShift) & kSortKeyDraw0MaterialMask;
+					const uint64_t program  = (uint64_t(m_program.idx) << kSortKeyDraw0ProgramShift) & kSortKeyDraw0ProgramMask;
+					const uint64_t trans    = (uint64_t(m_trans      ) << kSortKeyDraw0TransShift  ) & kSortKeyDraw0TransMask;
+					const uint64_t view     = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
+					const uint64_t key      = view|kSortKeyDrawBit|kSortKeyDrawTypeProgram|trans|program|material|depth;
 
 					return key;
 				}
@@ -1077,22 +1201,24 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 			case SortDepth:
 				{
-					const uint64_t depth   = (uint64_t(m_depth      ) << kSortKeyDraw1DepthShift  ) & kSortKeyDraw1DepthMask;
-					const uint64_t program = (uint64_t(m_program.idx) << kSortKeyDraw1ProgramShift) & kSortKeyDraw1ProgramMask;
-					const uint64_t trans   = (uint64_t(m_trans      ) << kSortKeyDraw1TransShift) & kSortKeyDraw1TransMask;
-					const uint64_t view    = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
-					const uint64_t key     = view|kSortKeyDrawBit|kSortKeyDrawTypeDepth|depth|trans|program;
+					const uint64_t depth    = (uint64_t(m_depth      ) << kSortKeyDraw1DepthShift  ) & kSortKeyDraw1DepthMask;
+					const uint64_t program  = (uint64_t(m_program.idx) << kSortKeyDraw1ProgramShift) & kSortKeyDraw1ProgramMask;
+					const uint64_t material = (uint64_t(m_material   ) << kSortKeyDraw1MaterialShift) & kSortKeyDraw1MaterialMask;
+					const uint64_t trans    = (uint64_t(m_trans      ) << kSortKeyDraw1TransShift) & kSortKeyDraw1TransMask;
+					const uint64_t view     = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
+					const uint64_t key      = view|kSortKeyDrawBit|kSortKeyDrawTypeDepth|depth|trans|program|material;
 					return key;
 				}
 				break;
 
 			case SortSequence:
 				{
-					const uint64_t seq     = (uint64_t(m_seq        ) << kSortKeyDraw2SeqShift    ) & kSortKeyDraw2SeqMask;
-					const uint64_t program = (uint64_t(m_program.idx) << kSortKeyDraw2ProgramShift) & kSortKeyDraw2ProgramMask;
-					const uint64_t trans   = (uint64_t(m_trans      ) << kSortKeyDraw2TransShift  ) & kSortKeyDraw2TransMask;
-					const uint64_t view    = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
-					const uint64_t key     = view|kSortKeyDrawBit|kSortKeyDrawTypeSequence|seq|trans|program;
+					const uint64_t seq      = (uint64_t(m_seq        ) << kSortKeyDraw2SeqShift    ) & kSortKeyDraw2SeqMask;
+					const uint64_t program  = (uint64_t(m_program.idx) << kSortKeyDraw2ProgramShift) & kSortKeyDraw2ProgramMask;
+					const uint64_t material = (uint64_t(m_material   ) << kSortKeyDraw2MaterialShift) & kSortKeyDraw2MaterialMask;
+					const uint64_t trans    = (uint64_t(m_trans      ) << kSortKeyDraw2TransShift  ) & kSortKeyDraw2TransMask;
+					const uint64_t view     = (uint64_t(m_view       ) << kSortKeyViewBitShift     ) & kSortKeyViewMask;
+					const uint64_t key      = view|kSortKeyDrawBit|kSortKeyDrawTypeSequence|seq|trans|program|material;
 
 					BX_CHECK(seq == (uint64_t(m_seq) << kSortKeyDraw2SeqShift)
 						, "SortKey error, sequence is truncated (m_seq: %d)."
@@ -1162,19 +1288,62 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return key;
 		}
 
+		static ProgramHandle decodeProgram(uint64_t _key)
+		{
+			uint8_t shift;
+			const uint64_t mask = getProgramMask(_key, shift);
+			ProgramHandle program = { uint16_t( (_key & mask) >> shift) };
+			return program;
+		}
+
+		static uint64_t remapProgram(uint64_t _key, ProgramHandle _program)
+		{
+			uint8_t shift;
+			const uint64_t mask    = getProgramMask(_key, shift);
+			const uint64_t program = (uint64_t(_program.idx) << shift) & mask;
+			const uint64_t key     = (_key & ~mask) | program;
+			return key;
+		}
+
+		static uint64_t getProgramMask(uint64_t _key, uint8_t& _shift)
+		{
+			if (_key & kSortKeyDrawBit)
+			{
+				const uint64_t type = _key & kSortKeyDrawTypeMask;
+				if (type == kSortKeyDrawTypeDepth)
+				{
+					_shift = kSortKeyDraw1ProgramShift;
+					return kSortKeyDraw1ProgramMask;
+				}
+				else if (type == kSortKeyDrawTypeSequence)
+				{
+					_shift = kSortKeyDraw2ProgramShift;
+					return kSortKeyDraw2ProgramMask;
+				}
+
+				_shift = kSortKeyDraw0ProgramShift;
+				return kSortKeyDraw0ProgramMask;
+			}
+
+			_shift = kSortKeyComputeProgramShift;
+			return kSortKeyComputeProgramMask;
+		}
+
 		void reset()
 		{
-			m_depth   = 0;
-			m_seq     = 0;
-			m_program = {0};
-			m_view    = 0;
-			m_trans   = 0;
+			m_depth    = 0;
+			m_seq      = 0;
+			m_program  = {0};
+			m_view     = 0;
+			m_material = 0;
+			m_trans    = 0;
 		}
 
 		uint32_t      m_depth;
 		uint32_t      m_seq;
 		ProgramHandle m_program;
 		ViewId        m_view;
+		uint16_t      m_material;
 		uint8_t       m_trans;
 	};
 #undef SORT_KEY_RENDER_DRAW
@@ -1231,25 +1400,70 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		}
 	};
 
+	/// Multiplies each matrix of palette by parent matrix, `_dst[ii] = _src[ii] * _parent`.
+	void mtxMulPalette(void* _dst, const void* _src, const void* _parent, uint32_t _num);
+
+	// Matrix 0 is identity, and it's followed by persistent transform buffer
+	// matrices, which are preserved on reset. Per frame transforms start at
+	// m_base. Persistent region is empty until transform buffers are created.
 	struct MatrixCache
 	{
 		MatrixCache()
-			: m_num(1)
+			: m_cache(NULL)
+			, m_num(1)
+			, m_max(0)
+			, m_base(1)
+			, m_stale(false)
 		{
+		}
+
+		void create(uint32_t _max)
+		{
+			m_max   = _max;
+			m_base  = 1;
+			m_cache = (Matrix4*)BX_ALIGNED_ALLOC(g_allocator, m_max*sizeof(Matrix4), 16);
 			m_cache[0].setIdentity();
+			m_num   = m_base;
+			m_stale = false;
+		}
+
+		// Grow persistent region. Frame must not be used by encoders or
+		// renderer while it's resized.
+		bool setPersistent(uint32_t _num)
+		{
+			const uint32_t num = m_base - 1;
+			if (_num <= num)
+			{
+				return false;
+			}
+
+			m_max   = m_max - num + _num;
+			m_cache = (Matrix4*)BX_ALIGNED_REALLOC(g_allocator, m_cache, m_max*sizeof(Matrix4), 16);
+			bx::memSet(&m_cache[m_base], 0, (_num-num)*sizeof(Matrix4) );
+			m_base  = 1 + _num;
+			m_num   = m_base;
+
+			return true;
+		}
+
+		void destroy()
+		{
+			BX_ALIGNED_FREE(g_allocator, m_cache, 16);
+			m_cache = NULL;
+			m_max   = 0;
 		}
 
 		void reset()
 		{
-			m_num = 1;
+			m_num = m_base;
 		}
 
 		uint32_t reserve(uint16_t* _num)
 		{
 			uint32_t num = *_num;
-			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_MATRIX_CACHE - 1);
-			BX_WARN(first+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-1-first);
+			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, m_max - 1);
+			BX_WARN(first+num < m_max, "Matrix cache overflow. %d (max: %d)", first+num, m_max);
+			num = bx::min(num, m_max-1-first);
 			*_num = (uint16_t)num;
 			return first;
 		}
@@ -1268,9 +1482,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_CHECK(_cacheIdx < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_CHECK(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_max
 				);
 			return m_cache[_cacheIdx].un.val;
 		}
@@ -1280,8 +1494,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return uint32_t( (const Matrix4*)_ptr - m_cache);
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		Matrix4* m_cache;
 		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_base;
+		bool     m_stale; // Persistent region was overwritten, and must be copied again.
 	};
 
 	struct RectCache
@@ -1331,6 +1548,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	class UniformBuffer
 	{
 	public:
+		// Opcode type of uniform block, past marker type. Location is uniform
+		// block index, and number is size of packed values in 16 byte units.
+		static const UniformType::Enum kBlockType = UniformType::Enum(UniformType::Count+1);
+
 		static UniformBuffer* create(uint32_t _size = 1<<20)
 		{
 			const uint32_t structSize = sizeof(UniformBuffer)-sizeof(UniformBuffer::m_buffer);
@@ -1424,6 +1645,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return m_pos;
 		}
 
+		const char* getData() const
+		{
+			return m_buffer;
+		}
+
 		void reset(uint32_t _pos = 0)
 		{
 			m_pos = _pos;
@@ -1437,7 +1663,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
 		void writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num = 1);
+		void writeUniformBlock(uint16_t _idx, const void* _data, uint32_t _size);
 		void writeMarker(const char* _marker);
+		void removeUniform(uint16_t _loc);
 
 	private:
 		UniformBuffer(uint32_t _size)
@@ -1551,9 +1779,49 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				bind.m_idx = kInvalidHandle;
 				bind.m_type = 0;
 				bind.m_samplerFlags = 0;
+				bind.m_format = 0;
+				bind.m_access = 0;
+				bind.m_mip = 0;
 			}
 		};
 
+		uint32_t hash() const
+		{
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+			{
+				const Binding& bind = m_bind[ii];
+				murmur.add(bind.m_samplerFlags);
+				murmur.add(bind.m_idx);
+				murmur.add(bind.m_type);
+				murmur.add(bind.m_format);
+				murmur.add(bind.m_access);
+				murmur.add(bind.m_mip);
+			}
+			return murmur.end();
+		}
+
+		bool isEqual(const RenderBind& _other) const
+		{
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+			{
+				const Binding& aa = m_bind[ii];
+				const Binding& bb = _other.m_bind[ii];
+				if (aa.m_samplerFlags != bb.m_samplerFlags
+				||  aa.m_idx          != bb.m_idx
+				||  aa.m_type         != bb.m_type
+				||  aa.m_format       != bb.m_format
+				||  aa.m_access       != bb.m_access
+				||  aa.m_mip          != bb.m_mip)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
 		Binding m_bind[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 	};
 
@@ -1739,6 +2007,25 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		int16_t           m_refCount;
 	};
 
+	struct TransformBufferRef
+	{
+		uint32_t m_offset;
+		uint16_t m_num;
+	};
+
+	struct UniformBlock
+	{
+		struct Entry
+		{
+			UniformHandle m_handle;
+			uint32_t      m_size;
+		};
+
+		Entry    m_entry[BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS];
+		uint32_t m_size;
+		uint16_t m_num;
+	};
+
 	struct TextureRef
 	{
 		void init(
@@ -1762,6 +2049,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_owned       = false;
 			m_immutable   = _immutable;
 			m_rt          = _rt;
+			m_ready       = true;
+			m_asyncSerial = 0;
 		}
 
 		String   m_name;
@@ -1775,6 +2064,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bool     m_owned;
 		bool     m_immutable;
 		bool     m_rt;
+		bool     m_ready;
+		uint32_t m_asyncSerial;
 	};
 
 	struct FrameBufferRef
@@ -1866,10 +2157,27 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		Matrix4 m_proj;
 		FrameBufferHandle m_fbh;
 		uint8_t m_mode;
+
+		// Range of view uniforms in Frame::m_viewUniformBuffer, it's set only
+		// for submitted frame. Renderers update them when view changes, and
+		// they are committed with the first draw, since view change resets
+		// current program.
+		uint32_t m_uniformBegin;
+		uint32_t m_uniformEnd;
 	};
 
 	struct FrameCache
 	{
+		void create()
+		{
+			m_matrixCache.create(g_caps.limits.maxTransforms);
+		}
+
+		void destroy()
+		{
+			m_matrixCache.destroy();
+		}
+
 		void reset()
 		{
 			m_matrixCache.reset();
@@ -1892,6 +2200,74 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		RectCache m_rectCache;
 	};
 
+	// Sorted run of render item keys produced by single encoder. Encoder sorts
+	// its own run when it's closed, and Frame::sort only merges runs. When
+	// encoder is resumed, only keys added since last close are sorted and
+	// merged into already sorted part.
+	struct SortRun
+	{
+		void create()
+		{
+			m_keys   = NULL;
+			m_values = NULL;
+			m_num    = 0;
+			m_max    = 0;
+			m_sorted = 0;
+			m_cpuTimeSort = 0;
+		}
+
+		void destroy()
+		{
+			BX_FREE(g_allocator, m_keys);
+			BX_FREE(g_allocator, m_values);
+			create();
+		}
+
+		void reset()
+		{
+			m_num    = 0;
+			m_sorted = 0;
+			m_cpuTimeSort = 0;
+		}
+
+		void add(uint64_t _key, RenderItemCount _value)
+		{
+			if (m_num == m_max)
+			{
+				grow();
+			}
+
+			m_keys[m_num]   = _key;
+			m_values[m_num] = _value;
+			++m_num;
+		}
+
+		void reserve(uint32_t _num)
+		{
+			if (m_num + _num > m_max)
+			{
+				grow(m_num + _num);
+			}
+		}
+
+		void grow(uint32_t _min = 0)
+		{
+			m_max    = bx::min<uint32_t>(bx::max<uint32_t>(bx::max<uint32_t>(m_max*2, _min), 256), g_caps.limits.maxDrawCalls);
+			m_keys   = (uint64_t*       )BX_REALLOC(g_allocator, m_keys,   m_max*sizeof(uint64_t) );
+			m_values = (RenderItemCount*)BX_REALLOC(g_allocator, m_values, m_max*sizeof(RenderItemCount) );
+		}
+
+		void sort(uint64_t* _tempKeys, RenderItemCount* _tempValues);
+
+		uint64_t*        m_keys;
+		RenderItemCount* m_values;
+		uint32_t         m_num;
+		uint32_t         m_max;
+		uint32_t         m_sorted;
+		uint32_t         m_viewOffset[BGFX_CONFIG_MAX_VIEWS+1];
+		int64_t          m_cpuTimeSort;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
@@ -1899,11 +2275,6 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			, m_waitRender(0)
 			, m_capture(false)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = BGFX_INVALID_HANDLE;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
 			m_perfStats.viewStats = m_viewStats;
@@ -1915,17 +2286,46 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void create()
 		{
+			{
+				const uint32_t num = g_caps.limits.maxDrawCalls;
+
+				m_sortKeys       = (uint64_t*       )BX_ALLOC(g_allocator, sizeof(uint64_t       )*(num+1) );
+				m_sortValues     = (RenderItemCount*)BX_ALLOC(g_allocator, sizeof(RenderItemCount)*(num+1) );
+				m_renderItem     = (RenderItem*     )BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderItem     )*(num+1), BX_CACHE_LINE_SIZE);
+				m_renderItemBind = (RenderItemCount*)BX_ALLOC(g_allocator, sizeof(RenderItemCount)*(num+1) );
+				m_renderBind     = (RenderBind*     )BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderBind     )*(num+1), BX_CACHE_LINE_SIZE);
+
+				SortKey term;
+				term.reset();
+				term.m_program = BGFX_INVALID_HANDLE;
+				m_sortKeys[num]   = term.encodeDraw(SortKey::SortProgram);
+				m_sortValues[num] = RenderItemCount(num);
+			}
+
+			m_frameCache.create();
+
+			m_iboffset   = 0;
+			m_vboffset   = 0;
+			m_ibPage     = 0;
+			m_vbPage     = 0;
+			m_numIbPages = 0;
+			m_numVbPages = 0;
+
 			{
 				const uint32_t num = g_caps.limits.maxEncoders;
 
 				m_uniformBuffer = (UniformBuffer**)BX_ALLOC(g_allocator, sizeof(UniformBuffer*)*num);
+				m_sortRun       = (SortRun*)BX_ALLOC(g_allocator, sizeof(SortRun)*num);
 
 				for (uint32_t ii = 0; ii < num; ++ii)
 				{
 					m_uniformBuffer[ii] = UniformBuffer::create();
+					m_sortRun[ii].create();
 				}
 			}
 
+			m_viewUniformBuffer = UniformBuffer::create(16<<10);
+
 			reset();
 			start();
 			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
@@ -1936,10 +2336,24 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 			{
 				UniformBuffer::destroy(m_uniformBuffer[ii]);
+				m_sortRun[ii].destroy();
 			}
 
 			BX_FREE(g_allocator, m_uniformBuffer);
+			BX_FREE(g_allocator, m_sortRun);
+			UniformBuffer::destroy(m_viewUniformBuffer);
+
+			m_frameCache.destroy();
+
+			BX_FREE(g_allocator, m_sortKeys);
+			BX_FREE(g_allocator, m_sortValues);
+			BX_ALIGNED_FREE(g_allocator, m_renderItem,     BX_CACHE_LINE_SIZE);
+			BX_FREE(g_allocator, m_renderItemBind);
+			BX_ALIGNED_FREE(g_allocator, m_renderBind, BX_CACHE_LINE_SIZE);
 			BX_DELETE(g_allocator, m_textVideoMem);
+
+			m_cmdPre.destroy();
+			m_cmdPost.destroy();
 		}
 
 		void reset()
@@ -1951,14 +2365,23 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void start()
 		{
-			m_perfStats.transientVbUsed = m_vboffset;
-			m_perfStats.transientIbUsed = m_iboffset;
+			m_perfStats.transientVbUsed = getTransientVbUsed();
+			m_perfStats.transientIbUsed = getTransientIbUsed();
 
 			m_frameCache.reset();
 			m_numRenderItems = 0;
+			m_numRenderBinds = 0;
 			m_numBlitItems   = 0;
+
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				m_sortRun[ii].reset();
+			}
+
 			m_iboffset = 0;
 			m_vboffset = 0;
+			m_ibPage   = 0;
+			m_vbPage   = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
 			m_capture = false;
@@ -1981,20 +2404,72 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void sort();
 
+		uint32_t mergeDraws();
+
+		const RenderBind& getRenderBind(uint32_t _itemIdx) const
+		{
+			return m_renderBind[m_renderItemBind[_itemIdx] ];
+		}
+
+		// Transient buffer page being filled. Page 0 is the primary transient
+		// buffer uploaded by renderer, pages past it are overflow pages.
+		TransientIndexBuffer* getTransientIb() const
+		{
+			return 0 == m_ibPage ? m_transientIb : m_transientIbPage[m_ibPage-1];
+		}
+
+		TransientVertexBuffer* getTransientVb() const
+		{
+			return 0 == m_vbPage ? m_transientVb : m_transientVbPage[m_vbPage-1];
+		}
+
+		uint32_t& getTransientIbOffset()
+		{
+			return 0 == m_ibPage ? m_iboffset : m_ibPageOffset[m_ibPage-1];
+		}
+
+		uint32_t& getTransientVbOffset()
+		{
+			return 0 == m_vbPage ? m_vboffset : m_vbPageOffset[m_vbPage-1];
+		}
+
+		uint32_t getTransientIbUsed() const
+		{
+			uint32_t used = m_iboffset;
+			for (uint32_t ii = 0; ii < m_ibPage; ++ii)
+			{
+				used += m_ibPageOffset[ii];
+			}
+
+			return used;
+		}
+
+		uint32_t getTransientVbUsed() const
+		{
+			uint32_t used = m_vboffset;
+			for (uint32_t ii = 0; ii < m_vbPage; ++ii)
+			{
+				used += m_vbPageOffset[ii];
+			}
+
+			return used;
+		}
+
 		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
 		{
-			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
+			uint32_t offset   = bx::strideAlign(getTransientIbOffset(), sizeof(uint16_t) );
 			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
+			iboffset = bx::min<uint32_t>(iboffset, getTransientIb()->size);
 			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
 			return num;
 		}
 
 		uint32_t allocTransientIndexBuffer(uint32_t& _num)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
+			uint32_t& iboffset = getTransientIbOffset();
+			uint32_t offset = bx::strideAlign(iboffset, sizeof(uint16_t) );
 			uint32_t num    = getAvailTransientIndexBuffer(_num);
-			m_iboffset = offset + num*sizeof(uint16_t);
+			iboffset = offset + num*sizeof(uint16_t);
 			_num = num;
 
 			return offset;
@@ -2002,18 +2477,19 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
+			uint32_t offset   = bx::strideAlign(getTransientVbOffset(), _stride);
 			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
+			vboffset = bx::min<uint32_t>(vboffset, getTransientVb()->size);
 			uint32_t num = (vboffset-offset)/_stride;
 			return num;
 		}
 
 		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
+			uint32_t& vboffset = getTransientVbOffset();
+			uint32_t offset = bx::strideAlign(vboffset, _stride);
 			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
+			vboffset = offset + num * _stride;
 			_num = num;
 
 			return offset;
@@ -2059,6 +2535,21 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return m_freeUniform.queue(_handle);
 		}
 
+		bool free(UniformBlockHandle _handle)
+		{
+			return m_freeUniformBlock.queue(_handle);
+		}
+
+		bool free(TransformBufferHandle _handle)
+		{
+			return m_freeTransformBuffer.queue(_handle);
+		}
+
+		bool free(DrawBundleHandle _handle)
+		{
+			return m_freeDrawBundle.queue(_handle);
+		}
+
 		void resetFreeHandles()
 		{
 			m_freeIndexBuffer.reset();
@@ -2069,6 +2560,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_freeTexture.reset();
 			m_freeFrameBuffer.reset();
 			m_freeUniform.reset();
+			m_freeUniformBlock.reset();
+			m_freeTransformBuffer.reset();
+			m_freeDrawBundle.reset();
 		}
 
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
@@ -2078,18 +2572,22 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		uint64_t*        m_sortKeys;
+		RenderItemCount* m_sortValues;
+		RenderItem*      m_renderItem;
+		RenderItemCount* m_renderItemBind;
+		RenderBind*      m_renderBind;
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 
 		FrameCache m_frameCache;
 		UniformBuffer** m_uniformBuffer;
+		UniformBuffer* m_viewUniformBuffer;
+		SortRun* m_sortRun;
 
 		uint32_t m_numRenderItems;
+		uint32_t m_numRenderBinds;
 		uint16_t m_numBlitItems;
 
 		uint32_t m_iboffset;
@@ -2097,6 +2595,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
+		TransientIndexBuffer*  m_transientIbPage[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		TransientVertexBuffer* m_transientVbPage[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		uint32_t m_ibPageOffset[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		uint32_t m_vbPageOffset[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		uint32_t m_ibPageLastUsed[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		uint32_t m_vbPageLastUsed[BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES];
+		uint16_t m_ibPage;
+		uint16_t m_vbPage;
+		uint16_t m_numIbPages;
+		uint16_t m_numVbPages;
+
 		Resolution m_resolution;
 		uint32_t m_debug;
 
@@ -2167,6 +2676,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		FreeHandle<TextureHandle,      BGFX_CONFIG_MAX_TEXTURES>       m_freeTexture;
 		FreeHandle<FrameBufferHandle,  BGFX_CONFIG_MAX_FRAME_BUFFERS>  m_freeFrameBuffer;
 		FreeHandle<UniformHandle,      BGFX_CONFIG_MAX_UNIFORMS>       m_freeUniform;
+		FreeHandle<UniformBlockHandle, BGFX_CONFIG_MAX_UNIFORM_BLOCKS> m_freeUniformBlock;
+		FreeHandle<TransformBufferHandle, BGFX_CONFIG_MAX_TRANSFORM_BUFFERS> m_freeTransformBuffer;
+		FreeHandle<DrawBundleHandle,   BGFX_CONFIG_MAX_DRAW_BUNDLES>   m_freeDrawBundle;
 
 		TextVideoMem* m_textVideoMem;
 
@@ -2179,43 +2691,279 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bool m_capture;
 	};
 
-	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
+	// Draw bundle is recorded once by encoder, and then replayed into views.
+	// It's owned by API side only, replay copies items into frame. Handles are
+	// validated on replay, and dynamic buffers are resolved again.
+	struct DrawBundle
 	{
-		EncoderImpl()
+		// Dynamic buffers used by item. Dynamic buffer can be moved to other
+		// buffer or offset when it's resized, so item stores dynamic buffer
+		// handle and its start at record time, and offsets are rebased on
+		// replay.
+		struct Dynamic
 		{
-			discard();
+			void clear()
+			{
+				m_mask = 0;
+			}
+
+			uint32_t m_startIndex;
+			uint32_t m_startVertex[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+			uint16_t m_indexBuffer;
+			uint16_t m_vertexBuffer[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+			uint8_t  m_mask; // Bit 0 is index buffer, bit 1+stream is vertex stream.
+		};
+
+		void create()
+		{
+			m_draw      = NULL;
+			m_bind      = NULL;
+			m_key       = NULL;
+			m_dynamic   = NULL;
+			m_bindIdx   = NULL;
+			m_valid     = NULL;
+			m_matrix    = NULL;
+			m_rect      = NULL;
+			m_max       = 0;
+			m_maxMatrix = 0;
+			m_maxRect   = 0;
+			m_uniformBuffer = UniformBuffer::create(128<<10);
+			reset();
 		}
 
-		void begin(Frame* _frame, uint8_t _idx)
+		void destroy()
 		{
-			m_frame = _frame;
+			BX_ALIGNED_FREE(g_allocator, m_draw,   BX_CACHE_LINE_SIZE);
+			BX_ALIGNED_FREE(g_allocator, m_bind,   BX_CACHE_LINE_SIZE);
+			BX_ALIGNED_FREE(g_allocator, m_matrix, 16);
+			BX_FREE(g_allocator, m_key);
+			BX_FREE(g_allocator, m_dynamic);
+			BX_FREE(g_allocator, m_bindIdx);
+			BX_FREE(g_allocator, m_valid);
+			BX_FREE(g_allocator, m_rect);
+			UniformBuffer::destroy(m_uniformBuffer);
+		}
 
-			m_cpuTimeBegin = bx::getHPCounter();
+		void reset()
+		{
+			m_num        = 0;
+			m_numBind    = 0;
+			m_numValid   = 0;
+			m_numMatrix  = 0;
+			m_numRect    = 0;
+			m_numDynamic = 0;
+			m_uniformBuffer->reset();
 
-			m_uniformIdx   = _idx;
-			m_uniformBegin = 0;
-			m_uniformEnd   = 0;
+			// Same as in MatrixCache, transform 0 is identity.
+			Matrix4 identity;
+			identity.setIdentity();
+			addTransform(&identity, 1);
+		}
 
-			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-			uniformBuffer->reset();
+		void add(const SortKey& _key, const RenderDraw& _draw, const RenderBind& _bind, const Dynamic& _dynamic)
+		{
+			if (m_num == m_max)
+			{
+				m_max     = bx::max<uint32_t>(m_max*2, 16);
+				m_draw    = (RenderDraw*)BX_ALIGNED_REALLOC(g_allocator, m_draw, m_max*sizeof(RenderDraw), BX_CACHE_LINE_SIZE);
+				m_bind    = (RenderBind*)BX_ALIGNED_REALLOC(g_allocator, m_bind, m_max*sizeof(RenderBind), BX_CACHE_LINE_SIZE);
+				m_key     = (SortKey*   )BX_REALLOC(g_allocator, m_key, m_max*sizeof(SortKey) );
+				m_dynamic = (Dynamic*   )BX_REALLOC(g_allocator, m_dynamic, m_max*sizeof(Dynamic) );
+				m_bindIdx = (uint32_t*  )BX_REALLOC(g_allocator, m_bindIdx, m_max*sizeof(uint32_t) );
+				m_valid   = (uint32_t*  )BX_REALLOC(g_allocator, m_valid,   m_max*sizeof(uint32_t) );
+			}
 
-			m_numSubmitted = 0;
-			m_numDropped   = 0;
+			m_draw[m_num]    = _draw;
+			m_bind[m_num]    = _bind;
+			m_key[m_num]     = _key;
+			m_dynamic[m_num] = _dynamic;
+			m_numDynamic += 0 != _dynamic.m_mask;
+			++m_num;
 		}
 
-		void end(bool _finalize)
+		// Deduplicates bindings once recording ends, replay copies unique
+		// bindings into frame bind table without hashing them again.
+		void finish()
 		{
-			if (_finalize)
+			uint32_t cache[BGFX_CONFIG_BIND_CACHE_SIZE];
+			bx::memSet(cache, 0xff, sizeof(cache) );
+
+			m_numBind = 0;
+			for (uint32_t ii = 0; ii < m_num; ++ii)
 			{
-				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-				uniformBuffer->finish();
+				const uint32_t hash = m_bind[ii].hash();
+				uint32_t& slot = cache[hash & (BGFX_CONFIG_BIND_CACHE_SIZE-1)];
 
-				m_cpuTimeEnd = bx::getHPCounter();
-			}
+				if (UINT32_MAX != slot
+				&&  m_bind[slot].isEqual(m_bind[ii]) )
+				{
+					m_bindIdx[ii] = slot;
+					continue;
+				}
 
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_OCCLUSION) )
-			{
-				m_occlusionQuerySet.clear();
+				m_bind[m_numBind] = m_bind[ii];
+				m_bindIdx[ii] = m_numBind;
+				slot = m_numBind++;
+			}
+		}
+
+		uint32_t reserveTransform(uint16_t* _num)
+		{
+			const uint32_t num = bx::min<uint32_t>(*_num, UINT16_MAX - m_numMatrix);
+			BX_WARN(num == *_num, "Draw bundle transform overflow. %d (max: %d)", m_numMatrix+*_num, UINT16_MAX);
+
+			if (m_numMatrix + num > m_maxMatrix)
+			{
+				m_maxMatrix = bx::min<uint32_t>(bx::max<uint32_t>(m_maxMatrix*2, m_numMatrix+num), UINT16_MAX);
+				m_matrix    = (Matrix4*)BX_ALIGNED_REALLOC(g_allocator, m_matrix, m_maxMatrix*sizeof(Matrix4), 16);
+			}
+
+			const uint32_t first = m_numMatrix;
+			m_numMatrix += num;
+			*_num = uint16_t(num);
+
+			return first;
+		}
+
+		uint32_t addTransform(const void* _mtx, uint16_t _num)
+		{
+			if (NULL == _mtx)
+			{
+				return 0;
+			}
+
+			const uint32_t first = reserveTransform(&_num);
+			bx::memCopy(&m_matrix[first], _mtx, _num*sizeof(Matrix4) );
+
+			return first;
+		}
+
+		uint16_t addScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+		{
+			// Replay can't add more than frame rect cache can hold.
+			BX_WARN(m_numRect < BGFX_CONFIG_MAX_RECT_CACHE
+				, "Draw bundle scissor overflow. %d (max: %d)"
+				, m_numRect
+				, BGFX_CONFIG_MAX_RECT_CACHE
+				);
+			if (m_numRect >= BGFX_CONFIG_MAX_RECT_CACHE)
+			{
+				return UINT16_MAX;
+			}
+
+			if (m_numRect == m_maxRect)
+			{
+				m_maxRect = uint16_t(bx::min<uint32_t>(bx::max<uint32_t>(m_maxRect*2, 16), BGFX_CONFIG_MAX_RECT_CACHE) );
+				m_rect    = (Rect*)BX_REALLOC(g_allocator, m_rect, m_maxRect*sizeof(Rect) );
+			}
+
+			m_rect[m_numRect] = Rect(_x, _y, _width, _height);
+			return m_numRect++;
+		}
+
+		RenderDraw* m_draw;
+		RenderBind* m_bind;
+		SortKey*    m_key;
+		Dynamic*    m_dynamic;
+		uint32_t*   m_bindIdx;
+		uint32_t*   m_valid;
+		Matrix4*    m_matrix;
+		Rect*       m_rect;
+		UniformBuffer* m_uniformBuffer;
+
+		uint32_t m_serial; // Zero once destroyed, until handle is freed at frame end.
+		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_numBind;
+		uint32_t m_numValid;
+		uint32_t m_numDynamic;
+		uint32_t m_numMatrix;
+		uint32_t m_maxMatrix;
+		uint16_t m_numRect;
+		uint16_t m_maxRect;
+	};
+
+	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
+	{
+		EncoderImpl()
+			: m_drawBundle(NULL)
+			, m_bindMask(UINT32_MAX)
+			, m_bindIdx(UINT32_MAX)
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_tempMax(0)
+		{
+			m_key.reset();
+			discard();
+		}
+
+		~EncoderImpl()
+		{
+			BX_FREE(g_allocator, m_tempKeys);
+			BX_FREE(g_allocator, m_tempValues);
+		}
+
+		void begin(Frame* _frame, uint8_t _idx)
+		{
+			m_frame = _frame;
+
+			m_cpuTimeBegin = bx::getHPCounter();
+			BGFX_PROFILER_ASYNC_BEGIN("bgfx/Encoder", _idx);
+
+			m_uniformIdx   = _idx;
+			m_uniformBegin = 0;
+			m_uniformEnd   = 0;
+			m_uniformPos   = 0;
+
+			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			uniformBuffer->reset();
+
+			m_numSubmitted = 0;
+			m_numDropped   = 0;
+
+			m_renderItemBegin = 0;
+			m_renderItemEnd   = 0;
+			m_renderItemBlock = BGFX_CONFIG_RENDER_ITEM_BLOCK_MIN_SIZE;
+
+			bx::memSet(m_bindCache, 0xff, sizeof(m_bindCache) );
+			m_bindIdx = UINT32_MAX;
+		}
+
+		// Continue encoding into the same frame after end. Uniforms, render
+		// item block and sort run written before end are preserved, draw
+		// state is discarded.
+		void resume()
+		{
+			BGFX_PROFILER_ASYNC_BEGIN("bgfx/Encoder", m_uniformIdx);
+
+			discard();
+
+			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			uniformBuffer->reset(m_uniformPos);
+
+			m_uniformBegin = m_uniformPos;
+			m_uniformEnd   = m_uniformPos;
+		}
+
+		void end(bool _finalize)
+		{
+			BX_CHECK(NULL == m_drawBundle, "Draw bundle recording must be ended before encoder.");
+
+			if (_finalize)
+			{
+				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+				m_uniformPos = uniformBuffer->getPos();
+				uniformBuffer->finish();
+
+				sortRun();
+
+				m_cpuTimeEnd = bx::getHPCounter();
+				BGFX_PROFILER_ASYNC_END("bgfx/Encoder", m_uniformIdx);
+			}
+
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG_OCCLUSION) )
+			{
+				m_occlusionQuerySet.clear();
 			}
 
 			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
@@ -2224,9 +2972,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			}
 		}
 
+		UniformBuffer** getUniformBuffer()
+		{
+			return NULL != m_drawBundle
+				? &m_drawBundle->m_uniformBuffer
+				: &m_frame->m_uniformBuffer[m_uniformIdx]
+				;
+		}
+
 		void setMarker(const char* _name)
 		{
-			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			UniformBuffer* uniformBuffer = *getUniformBuffer();
 			uniformBuffer->writeMarker(_name);
 		}
 
@@ -2242,11 +2998,18 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_uniformSet.insert(_handle.idx);
 			}
 
-			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
-			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			UniformBuffer::update(getUniformBuffer() );
+			UniformBuffer* uniformBuffer = *getUniformBuffer();
 			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
 		}
 
+		void setUniformBlock(UniformBlockHandle _handle, const void* _data, uint32_t _size)
+		{
+			UniformBuffer::update(getUniformBuffer() );
+			UniformBuffer* uniformBuffer = *getUniformBuffer();
+			uniformBuffer->writeUniformBlock(_handle.idx, _data, _size);
+		}
+
 		void setState(uint64_t _state, uint32_t _rgba)
 		{
 			uint8_t blend = ( (_state&BGFX_STATE_BLEND_MASK)>>BGFX_STATE_BLEND_SHIFT)&0xff;
@@ -2263,6 +3026,16 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_submitFlags   |= _visible ? BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE : 0;
 		}
 
+		void setMaterial(uint16_t _material)
+		{
+			BX_WARN(_material < (1<<BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL)
+				, "Material %d doesn't fit into sort key, it will be truncated to %d bits."
+				, _material
+				, BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+				);
+			m_key.m_material = _material;
+		}
+
 		void setStencil(uint32_t _fstencil, uint32_t _bstencil)
 		{
 			m_draw.m_stencil = packStencil(_fstencil, _bstencil);
@@ -2270,26 +3043,61 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
-			uint16_t scissor = (uint16_t)m_frame->m_frameCache.m_rectCache.add(_x, _y, _width, _height);
+			uint16_t scissor = NULL != m_drawBundle
+				? m_drawBundle->addScissor(_x, _y, _width, _height)
+				: (uint16_t)m_frame->m_frameCache.m_rectCache.add(_x, _y, _width, _height)
+				;
 			m_draw.m_scissor = scissor;
 			return scissor;
 		}
 
 		void setScissor(uint16_t _cache)
 		{
+			BX_CHECK(NULL == m_drawBundle || UINT16_MAX == _cache || _cache < m_drawBundle->m_numRect
+				, "Draw bundle scissor out of bounds index %d (max: %d)"
+				, _cache
+				, NULL == m_drawBundle ? 0 : m_drawBundle->m_numRect
+				);
 			m_draw.m_scissor = _cache;
 		}
 
 		uint32_t setTransform(const void* _mtx, uint16_t _num)
 		{
-			m_draw.m_startMatrix = m_frame->m_frameCache.m_matrixCache.add(_mtx, _num);
+			m_draw.m_startMatrix = NULL != m_drawBundle
+				? m_drawBundle->addTransform(_mtx, _num)
+				: m_frame->m_frameCache.m_matrixCache.add(_mtx, _num)
+				;
 			m_draw.m_numMatrices = _num;
 
 			return m_draw.m_startMatrix;
 		}
 
+		uint32_t setTransformPalette(const void* _mtx, uint16_t _num, const void* _parent)
+		{
+			uint32_t first;
+
+			if (NULL != m_drawBundle)
+			{
+				first = m_drawBundle->reserveTransform(&_num);
+				mtxMulPalette(&m_drawBundle->m_matrix[first], _mtx, _parent, _num);
+			}
+			else
+			{
+				MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+				first = matrixCache.reserve(&_num);
+				mtxMulPalette(matrixCache.toPtr(first), _mtx, _parent, _num);
+			}
+
+			m_draw.m_startMatrix = first;
+			m_draw.m_numMatrices = _num;
+
+			return first;
+		}
+
 		uint32_t allocTransform(Transform* _transform, uint16_t _num)
 		{
+			BX_CHECK(NULL == m_drawBundle, "Transform can't be allocated while recording draw bundle, use setTransform.");
+
 			uint32_t first   = m_frame->m_frameCache.m_matrixCache.reserve(&_num);
 			_transform->data = m_frame->m_frameCache.m_matrixCache.toPtr(first);
 			_transform->num  = _num;
@@ -2297,14 +3105,40 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return first;
 		}
 
+		void setTransformBuffer(uint32_t _offset, uint16_t _num, const Matrix4* _mtx)
+		{
+			BX_WARN(NULL == m_drawBundle, "Transform buffer can't be used while recording draw bundle, use setTransform.");
+			if (NULL != m_drawBundle)
+			{
+				return;
+			}
+
+			const MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+			if (1 + _offset + _num <= matrixCache.m_base)
+			{
+				m_draw.m_startMatrix = 1 + _offset;
+				m_draw.m_numMatrices = _num;
+			}
+			else
+			{
+				// Transform buffer created during this frame is not in
+				// persistent region of frame yet, current matrices are copied.
+				setTransform(_mtx, _num);
+			}
+		}
+
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
-			BX_CHECK(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			const uint32_t maxTransforms = NULL != m_drawBundle
+				? m_drawBundle->m_numMatrix+1
+				: m_frame->m_frameCache.m_matrixCache.m_max
+				;
+			BX_CHECK(_cache < maxTransforms, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, maxTransforms
 				);
 			m_draw.m_startMatrix = _cache;
-			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
+			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, maxTransforms-1) - _cache);
 		}
 
 		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2313,15 +3147,20 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_startIndex  = _firstIndex;
 			m_draw.m_numIndices  = _numIndices;
 			m_draw.m_indexBuffer = _handle;
+			m_dynamic.m_mask    &= ~1;
 		}
 
-		void setIndexBuffer(const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
+		void setIndexBuffer(DynamicIndexBufferHandle _handle, const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
 		{
 			BX_CHECK(UINT8_MAX != m_draw.m_streamMask, "");
 			const uint32_t indexSize = 0 == (_dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
 			m_draw.m_startIndex  = _dib.m_startIndex + _firstIndex;
 			m_draw.m_numIndices  = bx::min(_numIndices, _dib.m_size/indexSize);
 			m_draw.m_indexBuffer = _dib.m_handle;
+
+			m_dynamic.m_startIndex  = _dib.m_startIndex;
+			m_dynamic.m_indexBuffer = _handle.idx;
+			m_dynamic.m_mask       |= 1;
 		}
 
 		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2331,6 +3170,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_indexBuffer = _tib->handle;
 			m_draw.m_startIndex  = _tib->startIndex + _firstIndex;
 			m_draw.m_numIndices  = numIndices;
+			m_dynamic.m_mask    &= ~1;
 			m_discard = 0 == numIndices;
 		}
 
@@ -2344,6 +3184,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BX_CHECK(UINT8_MAX != m_draw.m_streamMask, "");
 			BX_CHECK(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
+			m_dynamic.m_mask &= ~(2<<_stream);
 			if (m_draw.setStreamBit(_stream, _handle) )
 			{
 				Stream& stream = m_draw.m_stream[_stream];
@@ -2356,6 +3197,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void setVertexBuffer(
 			  uint8_t _stream
+			, DynamicVertexBufferHandle _handle
 			, const DynamicVertexBuffer& _dvb
 			, uint32_t _startVertex
 			, uint32_t _numVertices
@@ -2364,6 +3206,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BX_CHECK(UINT8_MAX != m_draw.m_streamMask, "");
 			BX_CHECK(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
+			m_dynamic.m_mask &= ~(2<<_stream);
 			if (m_draw.setStreamBit(_stream, _dvb.m_handle) )
 			{
 				Stream& stream = m_draw.m_stream[_stream];
@@ -2373,6 +3216,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_numVertices[_stream] =
 					bx::min(bx::uint32_imax(0, _dvb.m_numVertices - _startVertex), _numVertices)
 					;
+
+				m_dynamic.m_startVertex[_stream]  = _dvb.m_startVertex;
+				m_dynamic.m_vertexBuffer[_stream] = _handle.idx;
+				m_dynamic.m_mask |= 2<<_stream;
 			}
 		}
 
@@ -2386,6 +3233,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BX_CHECK(UINT8_MAX != m_draw.m_streamMask, "");
 			BX_CHECK(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
+			m_dynamic.m_mask &= ~(2<<_stream);
 			if (m_draw.setStreamBit(_stream, _tvb->handle) )
 			{
 				Stream& stream = m_draw.m_stream[_stream];
@@ -2400,6 +3248,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BX_CHECK(0 == m_draw.m_streamMask, "Vertex buffer already set.");
 			m_draw.m_streamMask  = UINT8_MAX;
+			m_dynamic.m_mask    &= 1;
 			Stream& stream = m_draw.m_stream[0];
 			stream.m_startVertex        = 0;
 			stream.m_handle.idx         = kInvalidHandle;
@@ -2434,6 +3283,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		void setTexture(uint8_t _stage, UniformHandle _sampler, TextureHandle _handle, uint32_t _flags)
 		{
 			Binding& bind = m_bind.m_bind[_stage];
+			markBind(_stage);
 			bind.m_idx    = _handle.idx;
 			bind.m_type   = uint8_t(Binding::Texture);
 			bind.m_samplerFlags = (_flags&BGFX_SAMPLER_INTERNAL_DEFAULT)
@@ -2451,6 +3301,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 		{
 			Binding& bind = m_bind.m_bind[_stage];
+			markBind(_stage);
 			bind.m_idx    = _handle.idx;
 			bind.m_type   = uint8_t(Binding::IndexBuffer);
 			bind.m_format = 0;
@@ -2461,6 +3312,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		void setBuffer(uint8_t _stage, VertexBufferHandle _handle, Access::Enum _access)
 		{
 			Binding& bind = m_bind.m_bind[_stage];
+			markBind(_stage);
 			bind.m_idx    = _handle.idx;
 			bind.m_type   = uint8_t(Binding::VertexBuffer);
 			bind.m_format = 0;
@@ -2471,6 +3323,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		void setImage(uint8_t _stage, TextureHandle _handle, uint8_t _mip, Access::Enum _access, TextureFormat::Enum _format)
 		{
 			Binding& bind = m_bind.m_bind[_stage];
+			markBind(_stage);
 			bind.m_idx    = _handle.idx;
 			bind.m_type   = uint8_t(Binding::Image);
 			bind.m_format = uint8_t(_format);
@@ -2488,11 +3341,15 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_discard = false;
 			m_draw.clear();
 			m_compute.clear();
-			m_bind.clear();
+			clearBind();
+			m_dynamic.clear();
+			m_key.m_material = 0;
 		}
 
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState);
 
+		void submitBatch(ViewId _id, ProgramHandle _program, uint16_t _num, const void* _mtx, const uint32_t* _startIndex, const uint32_t* _numIndices, const uint32_t* _depth, bool _preserveState);
+
 		void submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState)
 		{
 			m_draw.m_startIndirect  = _start;
@@ -2514,19 +3371,191 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
 
+		void beginDrawBundle(DrawBundle* _drawBundle)
+		{
+			BX_CHECK(NULL == m_drawBundle, "Draw bundle recording is already in progress.");
+
+			discard();
+			_drawBundle->reset();
+			m_drawBundle       = _drawBundle;
+			m_drawBundleSerial = _drawBundle->m_serial;
+			m_uniformBegin = 0;
+			m_uniformEnd   = 0;
+		}
+
+		void endDrawBundle();
+
+		void record(ProgramHandle _program, uint32_t _depth, bool _preserveState);
+
+		void submit(ViewId _id, const DrawBundle& _drawBundle, const void* _mtx, uint16_t _num);
+
+		uint32_t getNumVertices() const
+		{
+			if (UINT8_MAX != m_draw.m_streamMask)
+			{
+				uint32_t numVertices = UINT32_MAX;
+				for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+					numVertices = bx::min(numVertices, m_numVertices[idx]);
+				}
+
+				return numVertices;
+			}
+
+			return m_numVertices[0];
+		}
+
+		uint32_t allocRenderItem()
+		{
+			if (m_renderItemBegin == m_renderItemEnd)
+			{
+				// First block is reserved on first submit and block size
+				// doubles with each reservation, so encoders submitting few
+				// draw calls don't hold on to large unused blocks.
+				const uint32_t blockSize    = m_renderItemBlock;
+				const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+				const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(
+					  &m_frame->m_numRenderItems
+					, blockSize
+					, maxDrawCalls
+					);
+
+				if (maxDrawCalls-1 <= first)
+				{
+					return UINT32_MAX;
+				}
+
+				m_renderItemBegin = first;
+				m_renderItemEnd   = bx::min<uint32_t>(first + blockSize, maxDrawCalls-1);
+				m_renderItemBlock = bx::min<uint32_t>(blockSize*2, BGFX_CONFIG_RENDER_ITEM_BLOCK_SIZE);
+			}
+
+			return m_renderItemBegin++;
+		}
+
+		uint32_t allocRenderItems(uint32_t _num, uint32_t* _first)
+		{
+			if (m_renderItemEnd - m_renderItemBegin >= _num)
+			{
+				*_first = m_renderItemBegin;
+				m_renderItemBegin += _num;
+				return _num;
+			}
+
+			// Doesn't fit into current block, reserve contiguous range directly
+			// from frame and keep what's left of the block for later submits.
+			const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+			const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(
+				  &m_frame->m_numRenderItems
+				, _num
+				, maxDrawCalls
+				);
+
+			if (maxDrawCalls-1 <= first)
+			{
+				return 0;
+			}
+
+			*_first = first;
+			return bx::min<uint32_t>(_num, maxDrawCalls-1-first);
+		}
+
+		RenderItemCount internBind(const RenderBind& _bind)
+		{
+			BX_STATIC_ASSERT(0 == (BGFX_CONFIG_BIND_CACHE_SIZE & (BGFX_CONFIG_BIND_CACHE_SIZE-1) ) );
+
+			// Draw calls sharing material are usually submitted back to back,
+			// small direct mapped cache catches most of repeated bindings
+			// without synchronizing with other encoders.
+			const uint32_t hash = _bind.hash();
+			BindCacheEntry& entry = m_bindCache[hash & (BGFX_CONFIG_BIND_CACHE_SIZE-1)];
+
+			if (hash == entry.m_hash
+			&&  UINT32_MAX != entry.m_idx
+			&&  m_frame->m_renderBind[entry.m_idx].isEqual(_bind) )
+			{
+				return RenderItemCount(entry.m_idx);
+			}
+
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numRenderBinds, 1);
+			BX_CHECK(idx < g_caps.limits.maxDrawCalls, "Bind table overflow. %d (max: %d)", idx, g_caps.limits.maxDrawCalls);
+			m_frame->m_renderBind[idx] = _bind;
+
+			entry.m_hash = hash;
+			entry.m_idx  = idx;
+
+			return RenderItemCount(idx);
+		}
+
+		// Interns current bindings. Index is cached until bindings change,
+		// so draws that don't touch bindings skip hashing altogether.
+		RenderItemCount internBind()
+		{
+			if (UINT32_MAX == m_bindIdx)
+			{
+				m_bindIdx = internBind(m_bind);
+			}
+
+			return RenderItemCount(m_bindIdx);
+		}
+
+		void markBind(uint8_t _stage)
+		{
+			BX_STATIC_ASSERT(BGFX_CONFIG_MAX_TEXTURE_SAMPLERS <= 32);
+			m_bindMask |= UINT32_C(1)<<_stage;
+			m_bindIdx   = UINT32_MAX;
+		}
+
+		void clearBind()
+		{
+			if (0 != m_bindMask)
+			{
+				m_bind.clear();
+				m_bindMask = 0;
+				m_bindIdx  = UINT32_MAX;
+			}
+		}
+
+		void sortRun();
+
 		Frame* m_frame;
 
 		SortKey m_key;
 
+		DrawBundle* m_drawBundle;
+		uint32_t    m_drawBundleSerial;
+		DrawBundle::Dynamic m_dynamic;
+
 		RenderDraw    m_draw;
 		RenderCompute m_compute;
 		RenderBind    m_bind;
+		uint32_t      m_bindMask;
+		uint32_t      m_bindIdx;
 
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
+		uint32_t m_renderItemBegin;
+		uint32_t m_renderItemEnd;
+		uint32_t m_renderItemBlock;
+
+		struct BindCacheEntry
+		{
+			uint32_t m_hash;
+			uint32_t m_idx;
+		};
+
+		BindCacheEntry m_bindCache[BGFX_CONFIG_BIND_CACHE_SIZE];
+
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
+		uint32_t m_uniformPos;
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
 		uint8_t  m_uniformIdx;
 		bool     m_discard;
@@ -2537,6 +3566,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		int64_t m_cpuTimeBegin;
 		int64_t m_cpuTimeEnd;
+
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_tempMax;
 	};
 
 	struct VertexLayoutRef
@@ -2636,129 +3669,83 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		VertexLayoutHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 	};
 
-	// First-fit non-local allocator.
+	// Segregated-fit (TLSF) non-local allocator. Free blocks are binned by
+	// size class (power of two, subdivided linearly), and found with two
+	// levels of bitmaps. Neighbour blocks within same buffer are coalesced
+	// on free.
 	class NonLocalAllocator
 	{
 	public:
 		static const uint64_t kInvalidBlock = UINT64_MAX;
 
-		NonLocalAllocator()
-		{
-		}
+		NonLocalAllocator();
+		~NonLocalAllocator();
 
-		~NonLocalAllocator()
-		{
-		}
+		void reset();
+		void add(uint64_t _ptr, uint32_t _size);
+		uint64_t remove();
+		uint64_t alloc(uint32_t _size);
+		void free(uint64_t _block);
 
-		void reset()
+		// Free blocks are already coalesced on free. Returns true when there
+		// are no used blocks left.
+		bool compact() const
 		{
-			m_free.clear();
-			m_used.clear();
+			return 0 == m_used.size();
 		}
 
-		void add(uint64_t _ptr, uint32_t _size)
+		uint32_t getFreeSize() const
 		{
-			m_free.push_back(Free(_ptr, _size) );
+			return m_freeSize;
 		}
 
-		uint64_t remove()
+		uint32_t getNumFreeBlocks() const
 		{
-			BX_CHECK(0 == m_used.size(), "");
-
-			if (0 < m_free.size() )
-			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
-			}
-
-			return 0;
+			return m_numFreeBlocks;
 		}
 
-		uint64_t alloc(uint32_t _size)
-		{
-			_size = bx::max(_size, 16u);
-
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
-			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
-
-					m_used.insert(stl::make_pair(ptr, _size) );
-
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
-
-					return ptr;
-				}
-			}
+		uint32_t getLargestFreeBlock() const;
 
-			// there is no block large enough.
-			return kInvalidBlock;
-		}
+	private:
+		static const uint32_t kInvalidIndex = UINT32_MAX;
+		static const uint32_t kMinBlockSize = 16;
+		static const uint32_t kSlLog2       = 4;
+		static const uint32_t kNumSl        = 1<<kSlLog2;
+		static const uint32_t kNumFl        = 32-kSlLog2+1;
 
-		void free(uint64_t _block)
+		struct Block
 		{
-			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
-			{
-				m_free.push_front(Free(it->first, it->second) );
-				m_used.erase(it);
-			}
-		}
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys;
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree;
+			uint32_t m_nextFree;
+			bool     m_free;
+		};
 
-		bool compact()
-		{
-			m_free.sort();
+		static void mapping(uint32_t _size, uint32_t& _fl, uint32_t& _sl);
 
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
-			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
-				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
-				}
-				else
-				{
-					it = next;
-					++next;
-				}
-			}
+		uint32_t allocBlock();
+		void freeBlock(uint32_t _idx);
+		void insertFree(uint32_t _idx);
+		void removeFree(uint32_t _idx);
+		uint32_t findFree(uint32_t _size) const;
 
-			return 0 == m_used.size();
-		}
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
 
-	private:
-		struct Free
-		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
-			{
-			}
+		typedef stl::vector<uint32_t> BlockIndexArray;
+		BlockIndexArray m_unusedBlock;
 
-			bool operator<(const Free& rhs) const
-			{
-				return m_ptr < rhs.m_ptr;
-			}
+		typedef stl::unordered_map<uint64_t, uint32_t> UsedMap;
+		UsedMap m_used;
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
-
-		typedef stl::list<Free> FreeList;
-		FreeList m_free;
-
-		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
-		UsedList m_used;
+		uint32_t m_head[kNumFl][kNumSl];
+		uint32_t m_slBitmap[kNumFl];
+		uint32_t m_flBitmap;
+		uint32_t m_freeSize;
+		uint32_t m_numFreeBlocks;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -2787,6 +3774,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		virtual void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) = 0;
 		virtual void updateTextureBegin(TextureHandle _handle, uint8_t _side, uint8_t _mip) = 0;
 		virtual void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) = 0;
+		virtual void updateTextureRegions(TextureHandle _handle, uint8_t _side, uint8_t _mip, const TextureUpdateRegion* _region, uint32_t _num, const Memory* _mem);
 		virtual void updateTextureEnd() = 0;
 		virtual void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) = 0;
 		virtual void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) = 0;
@@ -2813,7 +3801,155 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	{
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+	// Backends that can upload multiple regions from single staging buffer
+	// should override this.
+	inline void RendererContextI::updateTextureRegions(TextureHandle _handle, uint8_t _side, uint8_t _mip, const TextureUpdateRegion* _region, uint32_t _num, const Memory* _mem)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const TextureUpdateRegion& region = _region[ii];
+
+			Memory mem;
+			mem.data = &_mem->data[region.m_offset];
+			mem.size = region.m_size;
+
+			updateTexture(_handle, _side, _mip, region.m_rect, region.m_z, region.m_depth, region.m_pitch, &mem);
+		}
+	}
+
+	// Render thread copy of uniform values passed to renderer. Partial update
+	// (less elements than uniform has) changes only beginning of value, so only
+	// that many bytes are compared and copied.
+	struct UniformShadow
+	{
+		UniformShadow()
+			: m_numSkipped(0)
+		{
+			bx::memSet(m_data, 0, sizeof(m_data) );
+			bx::memSet(m_size, 0, sizeof(m_size) );
+			bx::memSet(m_used, 0, sizeof(m_used) );
+		}
+
+		void create(UniformHandle _handle, uint32_t _size);
+		void destroy(UniformHandle _handle);
+		bool update(uint16_t _loc, const void* _data, uint32_t _size);
+		void shutdown();
+
+		void invalidate(UniformHandle _handle)
+		{
+			m_used[_handle.idx] = 0;
+		}
+
+		uint8_t* m_data[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_size[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_used[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_numSkipped;
+	};
+
+	/// Returns true if any uniform value passed to renderer changed.
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+
+	/// Must be called when renderer changes uniform value directly, without
+	/// going through `rendererUpdateUniforms`.
+	void rendererInvalidateUniform(UniformHandle _handle);
+
+	struct FrameTraceResource
+	{
+		// Order in which retained resources are recreated when trace starts,
+		// resources are listed after resources they depend on.
+		enum Enum
+		{
+			VertexLayout,
+			Uniform,
+			UniformBlock,
+			Shader,
+			Program,
+			IndexBuffer,
+			VertexBuffer,
+			Texture,
+			FrameBuffer,
+
+			Count
+		};
+	};
+
+	class FrameTraceBuffer : public bx::WriterI
+	{
+	public:
+		FrameTraceBuffer();
+		virtual ~FrameTraceBuffer();
+
+		virtual int32_t write(const void* _data, int32_t _size, bx::Error* _err) override;
+
+		void reset()
+		{
+			m_size = 0;
+		}
+
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_max;
+	};
+
+	// Serializes submitted frames into trace file. See frametrace.cpp for
+	// description of trace format.
+	class FrameTraceWriter
+	{
+	public:
+		FrameTraceWriter();
+		~FrameTraceWriter();
+
+		bool start(const char* _filePath);
+		void stop();
+		void frame(Frame* _frame);
+		void shutdown();
+
+	private:
+		void writeChunk(uint32_t _tag, const FrameTraceBuffer& _chunk);
+		void encodeCommands(CommandBuffer& _cmdbuf);
+		void encodeFrame(const Frame* _frame);
+		void retain(FrameTraceResource::Enum _type, uint16_t _idx, uint8_t _op);
+
+		bx::FileWriterI*  m_writer;
+		FrameTraceBuffer  m_frame;
+		FrameTraceBuffer  m_command;
+		FrameTraceBuffer** m_retained[FrameTraceResource::Count];
+	};
+
+	struct Context;
+
+	// Replays frames from trace file into submit frame.
+	class FrameTraceReader
+	{
+	public:
+		FrameTraceReader();
+		~FrameTraceReader();
+
+		uint32_t open(Context* _ctx, const char* _filePath);
+		void close();
+		bool replay();
+
+	private:
+		bool replayFrame(bx::MemoryReader* _reader);
+		void decodeCommands(bx::MemoryReader* _reader, CommandBuffer& _cmdbuf);
+		uint16_t create(FrameTraceResource::Enum _type, uint16_t _idx, uint8_t _destroy);
+		uint16_t destroy(FrameTraceResource::Enum _type, uint16_t _idx);
+		bool remap(FrameTraceResource::Enum _type, uint16_t& _idx) const;
+		bool remapDraw(RenderDraw& _draw) const;
+		bool remapCompute(RenderCompute& _compute) const;
+		bool remapBind(RenderBind& _bind) const;
+		void destroyAll();
+
+		Context*  m_ctx;
+		uint8_t*  m_data;
+		uint32_t  m_size;
+		uint32_t  m_resources;
+		uint32_t* m_frameOffset;
+		uint32_t  m_numFrames;
+		uint32_t  m_frame;
+		uint16_t* m_remap[FrameTraceResource::Count];
+		uint8_t*  m_destroy[FrameTraceResource::Count];
+	};
 
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
@@ -2825,10 +3961,15 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	{
 		Context()
 			: m_render(&m_frame[0])
-			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			, m_submit(&m_frame[0])
+			, m_numFrames(1)
+			, m_submitIdx(0)
+			, m_renderIdx(0)
+			, m_renderedIdx(0)
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
+			, m_drawBundleSerial(0)
 			, m_colorPaletteDirty(0)
 			, m_frames(0)
 			, m_debug(BGFX_DEBUG_NONE)
@@ -2841,7 +3982,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_textureAsyncSerial(0)
+			, m_textureAsyncExit(false)
 		{
+			bx::memSet(m_viewUniform, 0, sizeof(m_viewUniform) );
 		}
 
 		~Context()
@@ -2915,6 +4059,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		BGFX_API_FUNC(void setDebug(uint32_t _debug) )
 		{
 			m_debug = _debug;
+			profilerSetEnabled(0 != (_debug & BGFX_DEBUG_PROFILER) );
+		}
+
+		BGFX_API_FUNC(bool saveProfilerTrace(const char* _filePath) )
+		{
+			return profilerSave(_filePath);
 		}
 
 		BGFX_API_FUNC(void dbgTextClear(uint8_t _attr, bool _small) )
@@ -2967,6 +4117,21 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			stats.textureMemoryUsed = m_textureMemoryUsed;
 			stats.rtMemoryUsed      = m_rtMemoryUsed;
 
+			stats.transientVbMaxUsed = int32_t(m_transientVbMaxUsed);
+			stats.transientIbMaxUsed = int32_t(m_transientIbMaxUsed);
+
+			stats.transformsMaxUsed    = int32_t(m_transformsMaxUsed);
+			stats.rectsMaxUsed         = int32_t(m_rectsMaxUsed);
+			stats.uniformBufferMaxUsed = int32_t(m_uniformBufferMaxUsed);
+			stats.cmdBufferMaxUsed     = int32_t(m_cmdBufferMaxUsed);
+
+			stats.dynamicVbFree        = int32_t(m_dynVertexBufferAllocator.getFreeSize() );
+			stats.dynamicVbLargestFree = int32_t(m_dynVertexBufferAllocator.getLargestFreeBlock() );
+			stats.dynamicVbFreeBlocks  = int32_t(m_dynVertexBufferAllocator.getNumFreeBlocks() );
+			stats.dynamicIbFree        = int32_t(m_dynIndexBufferAllocator.getFreeSize() );
+			stats.dynamicIbLargestFree = int32_t(m_dynIndexBufferAllocator.getLargestFreeBlock() );
+			stats.dynamicIbFreeBlocks  = int32_t(m_dynIndexBufferAllocator.getNumFreeBlocks() );
+
 			return &stats;
 		}
 
@@ -3139,7 +4304,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				nextSubmitFrame()->free(layoutHandle);
 			}
 
 			m_vertexBufferHandle.free(_handle.idx);
@@ -3263,7 +4428,6 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			&&  0 != (dib.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
-				m_dynIndexBufferAllocator.compact();
 
 				uint64_t ptr = allocDynamicIndexBuffer(_mem->size, dib.m_flags);
 				dib.m_handle.idx = uint16_t(ptr>>32);
@@ -3281,11 +4445,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				, size
 				, _mem->size
 				);
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
-			cmdbuf.write(dib.m_handle);
-			cmdbuf.write(offset);
-			cmdbuf.write(size);
-			cmdbuf.write(_mem);
+
+			// Updates are merged per buffer, and submitted when frame is swapped.
+			addDynamicBufferUpdate(m_dynIndexBufferUpdate, dib.m_handle.idx, offset, size, _mem);
 		}
 
 		BGFX_API_FUNC(void destroyDynamicIndexBuffer(DynamicIndexBufferHandle _handle) )
@@ -3310,7 +4472,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
 				if (m_dynIndexBufferAllocator.compact() )
 				{
-					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); 0 != ptr; ptr = m_dynIndexBufferAllocator.remove() )
+					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); NonLocalAllocator::kInvalidBlock != ptr; ptr = m_dynIndexBufferAllocator.remove() )
 					{
 						IndexBufferHandle handle = { uint16_t(ptr>>32) };
 						destroyIndexBuffer(handle);
@@ -3450,7 +4612,6 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			&&  0 != (dvb.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
-				m_dynVertexBufferAllocator.compact();
 
 				const uint32_t size = bx::strideAlign<16>(_mem->size, dvb.m_stride)+dvb.m_stride;
 				const uint64_t ptr  = allocDynamicVertexBuffer(size, dvb.m_flags);
@@ -3472,11 +4633,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				, _mem->size
 				);
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
-			cmdbuf.write(dvb.m_handle);
-			cmdbuf.write(offset);
-			cmdbuf.write(size);
-			cmdbuf.write(_mem);
+			// Updates are merged per buffer, and submitted when frame is swapped.
+			addDynamicBufferUpdate(m_dynVertexBufferUpdate, dvb.m_handle.idx, offset, size, _mem);
 		}
 
 		BGFX_API_FUNC(void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle) )
@@ -3497,7 +4655,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			{
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
 				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				nextSubmitFrame()->free(layoutHandle);
 			}
 
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
@@ -3511,7 +4669,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_dynVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
 				if (m_dynVertexBufferAllocator.compact() )
 				{
-					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); 0 != ptr; ptr = m_dynVertexBufferAllocator.remove() )
+					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); NonLocalAllocator::kInvalidBlock != ptr; ptr = m_dynVertexBufferAllocator.remove() )
 					{
 						VertexBufferHandle handle = { uint16_t(ptr>>32) };
 						destroyVertexBuffer(handle);
@@ -3526,14 +4684,142 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			return m_submit->getAvailTransientIndexBuffer(_num);
+			const uint32_t num = m_submit->getAvailTransientIndexBuffer(_num);
+			if (num < _num
+			&&  canGrowTransientIndexBuffer(_num*uint32_t(sizeof(uint16_t) ) ) )
+			{
+				return _num;
+			}
+
+			return num;
 		}
 
 		BGFX_API_FUNC(uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			return m_submit->getAvailTransientVertexBuffer(_num, _stride);
+			const uint32_t num = m_submit->getAvailTransientVertexBuffer(_num, _stride);
+			if (num < _num
+			&&  canGrowTransientVertexBuffer(_num*_stride) )
+			{
+				return _num;
+			}
+
+			return num;
+		}
+
+		// Returns true if growTransient*Buffer is able to provide page of
+		// requested size. Reusing retired page doesn't need new handle.
+		bool canGrowTransientIndexBuffer(uint32_t _size) const
+		{
+			const Frame* frame = m_submit;
+
+			const uint16_t page = frame->m_ibPage;
+			if (BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES == page)
+			{
+				return false;
+			}
+
+			if (page < frame->m_numIbPages
+			&&  frame->m_transientIbPage[page]->size >= _size)
+			{
+				return true;
+			}
+
+			return m_indexBufferHandle.getNumHandles() < m_indexBufferHandle.getMaxHandles();
+		}
+
+		bool canGrowTransientVertexBuffer(uint32_t _size) const
+		{
+			const Frame* frame = m_submit;
+
+			const uint16_t page = frame->m_vbPage;
+			if (BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES == page)
+			{
+				return false;
+			}
+
+			if (page < frame->m_numVbPages
+			&&  frame->m_transientVbPage[page]->size >= _size)
+			{
+				return true;
+			}
+
+			return m_vertexBufferHandle.getNumHandles() < m_vertexBufferHandle.getMaxHandles();
+		}
+
+		void growTransientIndexBuffer(uint32_t _size)
+		{
+			Frame* frame = m_submit;
+
+			const uint16_t page = frame->m_ibPage;
+			if (BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES == page)
+			{
+				BX_WARN(false, "Out of transient index buffer pages, draws will be truncated.");
+				return;
+			}
+
+			if (page == frame->m_numIbPages
+			||  frame->m_transientIbPage[page]->size < _size)
+			{
+				TransientIndexBuffer* tib = createTransientIndexBuffer(bx::max<uint32_t>(_size, g_caps.limits.transientIbSize) );
+				if (NULL == tib)
+				{
+					return;
+				}
+
+				if (page == frame->m_numIbPages)
+				{
+					++frame->m_numIbPages;
+				}
+				else
+				{
+					destroyTransientIndexBuffer(frame->m_transientIbPage[page]);
+				}
+
+				frame->m_transientIbPage[page] = tib;
+			}
+
+			frame->m_ibPageOffset[page]   = 0;
+			frame->m_ibPageLastUsed[page] = m_frames;
+			frame->m_ibPage = page+1;
+		}
+
+		void growTransientVertexBuffer(uint32_t _size)
+		{
+			Frame* frame = m_submit;
+
+			const uint16_t page = frame->m_vbPage;
+			if (BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES == page)
+			{
+				BX_WARN(false, "Out of transient vertex buffer pages, draws will be truncated.");
+				return;
+			}
+
+			if (page == frame->m_numVbPages
+			||  frame->m_transientVbPage[page]->size < _size)
+			{
+				TransientVertexBuffer* tvb = createTransientVertexBuffer(bx::max<uint32_t>(_size, g_caps.limits.transientVbSize) );
+				if (NULL == tvb)
+				{
+					return;
+				}
+
+				if (page == frame->m_numVbPages)
+				{
+					++frame->m_numVbPages;
+				}
+				else
+				{
+					destroyTransientVertexBuffer(frame->m_transientVbPage[page]);
+				}
+
+				frame->m_transientVbPage[page] = tvb;
+			}
+
+			frame->m_vbPageOffset[page]   = 0;
+			frame->m_vbPageLastUsed[page] = m_frames;
+			frame->m_vbPage = page+1;
 		}
 
 		TransientIndexBuffer* createTransientIndexBuffer(uint32_t _size)
@@ -3575,9 +4861,14 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
+			if (_num > m_submit->getAvailTransientIndexBuffer(_num) )
+			{
+				growTransientIndexBuffer(_num*uint32_t(sizeof(uint16_t) ) );
+			}
+
 			uint32_t offset = m_submit->allocTransientIndexBuffer(_num);
 
-			TransientIndexBuffer& tib = *m_submit->m_transientIb;
+			TransientIndexBuffer& tib = *m_submit->getTransientIb();
 
 			_tib->data       = &tib.data[offset];
 			_tib->size       = _num * 2;
@@ -3641,8 +4932,6 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
-
 			if (!isValid(layoutHandle) )
 			{
 				VertexLayoutHandle temp = { m_layoutHandle.alloc() };
@@ -3653,8 +4942,15 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_vertexLayoutRef.add(layoutHandle, _layout.m_hash);
 			}
 
+			if (_num > m_submit->getAvailTransientVertexBuffer(_num, _layout.m_stride) )
+			{
+				growTransientVertexBuffer(_num*_layout.m_stride);
+			}
+
 			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _layout.m_stride);
 
+			TransientVertexBuffer& dvb = *m_submit->getTransientVb();
+
 			_tvb->data = &dvb.data[offset];
 			_tvb->size = _num * _layout.m_stride;
 			_tvb->startVertex = bx::strideAlign(offset, _layout.m_stride)/_layout.m_stride;
@@ -3668,9 +4964,15 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
 			uint16_t stride = BX_ALIGN_16(_stride);
+
+			if (_num > m_submit->getAvailTransientVertexBuffer(_num, stride) )
+			{
+				growTransientVertexBuffer(_num*stride);
+			}
+
 			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+			TransientVertexBuffer& dvb = *m_submit->getTransientVb();
 			_idb->data   = &dvb.data[offset];
 			_idb->size   = _num * stride;
 			_idb->offset = offset;
@@ -4148,36 +5450,105 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 			TextureRef& ref = m_textureRef[handle.idx];
 			ref.init(
-				  _ratio
-				, _info->format
-				, _info->storageSize
-				, imageContainer.m_numMips
-				, imageContainer.m_numLayers
-				, 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_DIRECT_ACCESS)
-				, _immutable
-				, 0 != (_flags & BGFX_TEXTURE_RT_MASK)
+				  _ratio
+				, _info->format
+				, _info->storageSize
+				, imageContainer.m_numMips
+				, imageContainer.m_numLayers
+				, 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_DIRECT_ACCESS)
+				, _immutable
+				, 0 != (_flags & BGFX_TEXTURE_RT_MASK)
+				);
+
+			if (ref.m_rt)
+			{
+				m_rtMemoryUsed += int64_t(ref.m_storageSize);
+			}
+			else
+			{
+				m_textureMemoryUsed += int64_t(ref.m_storageSize);
+			}
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+			cmdbuf.write(handle);
+			cmdbuf.write(_mem);
+			cmdbuf.write(_flags);
+			cmdbuf.write(_skip);
+
+			setDebugName(convert(handle) );
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(TextureHandle createTextureAsync(const Memory* _mem, uint64_t _flags, uint8_t _skip) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			// Placeholder is replaced by destroying and recreating texture,
+			// frame buffers created from it would keep stale attachment.
+			if (0 != (_flags & BGFX_TEXTURE_RT_MASK) )
+			{
+				BX_WARN(false, "createTextureAsync: Render target textures can't be created asynchronously.");
+				release(_mem);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			TextureHandle handle = { m_textureHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate texture handle.");
+
+			if (!isValid(handle) )
+			{
+				release(_mem);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			TextureInfo placeholder;
+			calcTextureSize(placeholder, 1, 1, 1, false, false, 1, TextureFormat::RGBA8);
+
+			TextureRef& ref = m_textureRef[handle.idx];
+			ref.init(
+				  BackbufferRatio::Count
+				, placeholder.format
+				, placeholder.storageSize
+				, 1
+				, 1
+				, false
+				, true
+				, false
 				);
+			ref.m_ready       = false;
+			ref.m_asyncSerial = ++m_textureAsyncSerial;
 
-			if (ref.m_rt)
-			{
-				m_rtMemoryUsed += int64_t(ref.m_storageSize);
-			}
-			else
-			{
-				m_textureMemoryUsed += int64_t(ref.m_storageSize);
-			}
+			m_textureMemoryUsed += int64_t(ref.m_storageSize);
 
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
 			cmdbuf.write(handle);
-			cmdbuf.write(_mem);
-			cmdbuf.write(_flags);
-			cmdbuf.write(_skip);
+			cmdbuf.write(createTexturePlaceholder() );
+			cmdbuf.write(_flags & ~BGFX_TEXTURE_RT_MASK);
+			cmdbuf.write(uint8_t(0) );
 
 			setDebugName(convert(handle) );
 
+			TextureAsyncJob job;
+			job.m_mem    = _mem;
+			job.m_flags  = _flags;
+			job.m_serial = ref.m_asyncSerial;
+			job.m_handle = handle;
+			job.m_skip   = _skip;
+			job.m_ok     = false;
+			textureAsyncSubmit(job);
+
 			return handle;
 		}
 
+		BGFX_API_FUNC(bool isTextureReady(TextureHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_CHECK_HANDLE("isTextureReady", m_textureHandle, _handle);
+
+			return m_textureRef[_handle.idx].m_ready;
+		}
+
 		BGFX_API_FUNC(void setName(TextureHandle _handle, const bx::StringView& _name) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4232,7 +5603,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_frames + 2;
+
+			// Read is executed when current submit frame is rendered, which
+			// is guaranteed only after all frames in flight are submitted.
+			return m_frames + m_numFrames;
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
@@ -4281,6 +5655,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			if (0 == refs)
 			{
 				ref.m_name.clear();
+				ref.m_asyncSerial = 0;
 
 				if (ref.m_rt)
 				{
@@ -4327,6 +5702,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
 			cmdbuf.write(_mip);
+			cmdbuf.write(textureRef.m_format);
 			Rect rect;
 			rect.m_x = _x;
 			rect.m_y = _y;
@@ -4372,6 +5748,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				, g_caps.limits.maxFBAttachments
 				);
 
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const TextureHandle texHandle = _attachment[ii].handle;
+				if (isValid(texHandle)
+				&&  !m_textureRef[texHandle.idx].m_ready)
+				{
+					BX_WARN(false, "createFrameBuffer: Texture %d is still loading asynchronously.", texHandle.idx);
+					return BGFX_INVALID_HANDLE;
+				}
+			}
+
 			FrameBufferHandle handle = { m_frameBufferHandle.alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate frame buffer handle.");
 
@@ -4585,6 +5972,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 			BGFX_CHECK_HANDLE("destroyUniform", m_uniformHandle, _handle);
 
+			uniformDecRef(_handle);
+		}
+
+		void uniformDecRef(UniformHandle _handle)
+		{
 			UniformRef& uniform = m_uniformRef[_handle.idx];
 			BX_CHECK(uniform.m_refCount > 0, "Destroying already destroyed uniform %d.", _handle.idx);
 			int32_t refs = --uniform.m_refCount;
@@ -4597,11 +5989,105 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				uniform.m_name.clear();
 				m_uniformHashMap.removeByHandle(_handle.idx);
 
+				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+				{
+					if (NULL != m_viewUniform[ii])
+					{
+						m_viewUniform[ii]->removeUniform(_handle.idx);
+					}
+				}
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyUniform);
 				cmdbuf.write(_handle);
 			}
 		}
 
+		BGFX_API_FUNC(UniformBlockHandle createUniformBlock(const UniformHandle* _uniforms, uint16_t _num) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (0 == _num
+			||  BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS < _num)
+			{
+				BX_TRACE("Invalid number of uniforms in uniform block %d (max: %d)."
+					, _num
+					, BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS
+					);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			UniformBlock block;
+			block.m_num  = _num;
+			block.m_size = 0;
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const UniformHandle handle = _uniforms[ii];
+				BGFX_CHECK_HANDLE("createUniformBlock", m_uniformHandle, handle);
+
+				const UniformRef& uniform = m_uniformRef[handle.idx];
+				if (UniformType::Sampler == uniform.m_type)
+				{
+					BX_TRACE("Sampler uniform %s can't be part of uniform block.", uniform.m_name.getPtr() );
+					return BGFX_INVALID_HANDLE;
+				}
+
+				UniformBlock::Entry& entry = block.m_entry[ii];
+				entry.m_handle = handle;
+				entry.m_size   = g_uniformTypeSize[uniform.m_type]*uniform.m_num;
+				block.m_size  += entry.m_size;
+			}
+
+			const uint32_t maxSize = (CONSTANT_OPCODE_NUM_MASK>>CONSTANT_OPCODE_NUM_SHIFT)*16;
+			if (maxSize < block.m_size)
+			{
+				BX_TRACE("Uniform block is too large %d (max: %d).", block.m_size, maxSize);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			UniformBlockHandle handle = { m_uniformBlockHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate uniform block handle.");
+
+			if (isValid(handle) )
+			{
+				for (uint32_t ii = 0; ii < _num; ++ii)
+				{
+					++m_uniformRef[_uniforms[ii].idx].m_refCount;
+				}
+
+				bx::memCopy(&m_uniformBlockRef[handle.idx], &block, sizeof(UniformBlock) );
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniformBlock);
+				cmdbuf.write(handle);
+				cmdbuf.write(block.m_num);
+				cmdbuf.write(block.m_entry, sizeof(UniformBlock::Entry)*block.m_num);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyUniformBlock(UniformBlockHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyUniformBlock", m_uniformBlockHandle, _handle);
+
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_CHECK(ok, "Uniform block handle %d is already destroyed!", _handle.idx);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyUniformBlock);
+			cmdbuf.write(_handle);
+
+			UniformBlock& block = m_uniformBlockRef[_handle.idx];
+			for (uint32_t ii = 0, num = block.m_num; ii < num; ++ii)
+			{
+				uniformDecRef(block.m_entry[ii].m_handle);
+			}
+
+			block.m_num  = 0;
+			block.m_size = 0;
+		}
+
 		BGFX_API_FUNC(OcclusionQueryHandle createOcclusionQuery() )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4648,6 +6134,120 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		BGFX_API_FUNC(DrawBundleHandle createDrawBundle() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			DrawBundleHandle handle = { m_drawBundleHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate draw bundle handle.");
+
+			if (isValid(handle) )
+			{
+				DrawBundle& drawBundle = m_drawBundle[handle.idx];
+				drawBundle.create();
+				drawBundle.m_serial = ++m_drawBundleSerial;
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyDrawBundle(DrawBundleHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyDrawBundle", m_drawBundleHandle, _handle);
+
+			// Encoders might still record or replay bundle in this frame, it's
+			// destroyed when handle is freed at frame end.
+			m_drawBundle[_handle.idx].m_serial = 0;
+
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_CHECK(ok, "Draw bundle handle %d is already destroyed!", _handle.idx);
+		}
+
+		BGFX_API_FUNC(TransformBufferHandle createTransformBuffer(uint16_t _num) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_transformBufferLock);
+
+			_num = bx::max<uint16_t>(1, _num);
+
+			const uint64_t ptr = m_transformBufferAllocator.alloc(uint32_t(_num*sizeof(Matrix4) ) );
+			if (NonLocalAllocator::kInvalidBlock == ptr)
+			{
+				BX_TRACE("Failed to allocate %d persistent transforms (free: %d)."
+					, _num
+					, uint32_t(m_transformBufferAllocator.getFreeSize()/sizeof(Matrix4) )
+					);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			TransformBufferHandle handle = { m_transformBufferHandle.alloc() };
+			if (!isValid(handle) )
+			{
+				BX_TRACE("Failed to allocate transform buffer handle.");
+				m_transformBufferAllocator.free(ptr);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			TransformBufferRef& ref = m_transformBufferRef[handle.idx];
+			ref.m_offset = uint32_t(ptr/sizeof(Matrix4) );
+			ref.m_num    = _num;
+
+			m_transformBufferUsed = bx::max(m_transformBufferUsed, ref.m_offset+_num);
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				m_transformBuffer[ref.m_offset+ii].setIdentity();
+			}
+
+			setTransformBufferDirty(ref.m_offset, _num);
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void updateTransformBuffer(TransformBufferHandle _handle, uint16_t _start, const void* _mtx, uint16_t _num) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_MUTEX_SCOPE(m_transformBufferLock);
+
+			BGFX_CHECK_HANDLE("updateTransformBuffer", m_transformBufferHandle, _handle);
+
+			const TransformBufferRef& ref = m_transformBufferRef[_handle.idx];
+			BX_CHECK(uint32_t(_start) + _num <= ref.m_num
+				, "Transform buffer update out of bounds %d (num: %d)."
+				, _start + _num
+				, ref.m_num
+				);
+
+			const uint16_t start = bx::min(_start, ref.m_num);
+			const uint16_t num   = bx::min<uint16_t>(_num, ref.m_num - start);
+
+			bx::memCopy(&m_transformBuffer[ref.m_offset+start], _mtx, num*sizeof(Matrix4) );
+			setTransformBufferDirty(ref.m_offset+start, num);
+		}
+
+		BGFX_API_FUNC(void destroyTransformBuffer(TransformBufferHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyTransformBuffer", m_transformBufferHandle, _handle);
+
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_CHECK(ok, "Transform buffer handle %d is already destroyed!", _handle.idx);
+		}
+
+		// Persistent transforms are copied to matrix cache of each frame in
+		// flight when it's submitted, only dirty range is copied.
+		void setTransformBufferDirty(uint32_t _offset, uint32_t _num)
+		{
+			for (uint32_t ii = 0; ii < m_numFrames; ++ii)
+			{
+				m_transformBufferDirtyBegin[ii] = bx::min(m_transformBufferDirtyBegin[ii], _offset);
+				m_transformBufferDirtyEnd[ii]   = bx::max(m_transformBufferDirtyEnd[ii],   _offset+_num);
+			}
+		}
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4671,6 +6271,36 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			cmdbuf.write(_filePath, len);
 		}
 
+		BGFX_API_FUNC(bool startFrameTrace(const char* _filePath) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			return m_frameTraceWriter.start(_filePath);
+		}
+
+		BGFX_API_FUNC(void stopFrameTrace() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			m_frameTraceWriter.stop();
+		}
+
+		BGFX_API_FUNC(uint32_t openFrameTrace(const char* _filePath) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			return m_frameTraceReader.open(this, _filePath);
+		}
+
+		BGFX_API_FUNC(bool replayFrameTrace() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			return m_frameTraceReader.replay();
+		}
+
+		BGFX_API_FUNC(void closeFrameTrace() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			m_frameTraceReader.close();
+		}
+
 		BGFX_API_FUNC(void setPaletteColor(uint8_t _index, const float _rgba[4]) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4743,6 +6373,46 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		BGFX_API_FUNC(void resetView(ViewId _id) )
 		{
 			m_view[_id].reset();
+			clearViewUniforms(_id);
+		}
+
+		BGFX_API_FUNC(void setViewUniform(ViewId _id, UniformHandle _handle, const void* _value, uint16_t _num) )
+		{
+			BGFX_CHECK_HANDLE("setViewUniform", m_uniformHandle, _handle);
+
+			const UniformRef& uniform = m_uniformRef[_handle.idx];
+			BX_CHECK(0 < uniform.m_refCount, "Setting invalid uniform (handle %3d)!", _handle.idx);
+			BX_CHECK(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
+
+			UniformBuffer*& uniformBuffer = m_viewUniform[_id];
+
+			if (NULL != uniformBuffer)
+			{
+				uniformBuffer->removeUniform(_handle.idx);
+			}
+
+			if (NULL != _value)
+			{
+				const uint16_t num  = UINT16_MAX != _num ? _num : uniform.m_num;
+				const uint32_t size = sizeof(uint32_t) + g_uniformTypeSize[uniform.m_type]*num;
+
+				if (NULL == uniformBuffer)
+				{
+					uniformBuffer = UniformBuffer::create(bx::max<uint32_t>(size + 16, 1<<10) );
+				}
+
+				UniformBuffer::update(&uniformBuffer, size, BX_ALIGN_16(size) + (1<<10) );
+				uniformBuffer->writeUniform(uniform.m_type, _handle.idx, _value, num);
+			}
+		}
+
+		void clearViewUniforms(ViewId _id)
+		{
+			if (NULL != m_viewUniform[_id])
+			{
+				UniformBuffer::destroy(m_viewUniform[_id]);
+				m_viewUniform[_id] = NULL;
+			}
 		}
 
 		BGFX_API_FUNC(void setViewOrder(ViewId _id, uint16_t _num, const ViewId* _order) )
@@ -4773,8 +6443,72 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], 1);
 		}
 
+		Frame* nextSubmitFrame()
+		{
+			return &m_frame[(m_submitIdx + 1) % m_numFrames];
+		}
+
 		void dumpViewStats();
 		void freeDynamicBuffers();
+
+		struct TextureAsyncJob
+		{
+			const Memory* m_mem;
+			uint64_t      m_flags;
+			uint32_t      m_serial;
+			TextureHandle m_handle;
+			uint8_t       m_skip;
+			TextureInfo   m_info;
+			uint8_t       m_numMips;
+			uint16_t      m_numLayers;
+			bool          m_ok;
+		};
+
+		typedef stl::vector<TextureAsyncJob> TextureAsyncJobArray;
+
+		static const Memory* createTexturePlaceholder();
+		static void textureAsyncParse(TextureAsyncJob& _job);
+		static int32_t textureAsyncThread(bx::Thread* _self, void* _userData);
+		void textureAsyncSubmit(const TextureAsyncJob& _job);
+		void textureAsyncComplete();
+		void textureAsyncShutdown();
+
+		struct DynamicBufferUpdate
+		{
+			uint16_t      m_handle;
+			uint32_t      m_seq;
+			uint32_t      m_offset;
+			uint32_t      m_size;
+			const Memory* m_mem;
+		};
+
+		typedef stl::vector<DynamicBufferUpdate> DynamicBufferUpdateArray;
+
+		void addDynamicBufferUpdate(DynamicBufferUpdateArray& _updates, uint16_t _handle, uint32_t _offset, uint32_t _size, const Memory* _mem)
+		{
+			if (0 == _size)
+			{
+				release(_mem);
+				return;
+			}
+
+			DynamicBufferUpdate update;
+			update.m_handle = _handle;
+			update.m_seq    = uint32_t(_updates.size() );
+			update.m_offset = _offset;
+			update.m_size   = _size;
+			update.m_mem    = _mem;
+			_updates.push_back(update);
+		}
+
+		void flushDynamicBufferUpdates(DynamicBufferUpdateArray& _updates, CommandBuffer::Enum _cmd);
+
+		void flushTransientBufferPages(Frame* _frame);
+		void flushViewUniforms(Frame* _frame);
+		void flushTransformBuffers(Frame* _frame);
+		void resizeTransformBuffers(Frame* _frame);
+		void updateFrameStats(Frame* _frame);
+		void destroyTransientBufferPages(Frame* _frame);
 		void freeAllHandles(Frame* _frame);
 		void frameNoRenderWait();
 		void swap();
@@ -4782,7 +6516,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		// render thread
 		void flip();
 		RenderFrame::Enum renderFrame(int32_t _msecs = -1);
+		struct TextureUpdateSource
+		{
+			Rect          m_rect;
+			uint16_t      m_z;
+			uint16_t      m_depth;
+			uint16_t      m_pitch;
+			const Memory* m_mem;
+		};
+
 		void flushTextureUpdateBatch(CommandBuffer& _cmdbuf);
+		void updateTextureSources(TextureHandle _handle, uint8_t _side, uint8_t _mip, TextureFormat::Enum _format, uint32_t _num);
 		void rendererExecCommands(CommandBuffer& _cmdbuf);
 
 #if BGFX_CONFIG_MULTITHREADED
@@ -4806,7 +6550,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			bool ok = m_apiSem.wait(_msecs);
 			if (ok)
 			{
-				m_render->m_waitSubmit = bx::getHPCounter()-start;
+				m_frame[m_renderIdx].m_waitSubmit = bx::getHPCounter()-start;
 				m_submit->m_perfStats.waitSubmit = m_submit->m_waitSubmit;
 				return true;
 			}
@@ -4837,27 +6581,59 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void encoderApiWait()
 		{
-			uint16_t numEncoders = m_encoderHandle->getNumHandles();
+			// Encoder begin seeing frame bias blocks on this lock until frame
+			// is swapped.
+			m_encoderApiLock.lock();
 
-			for (uint16_t ii = 1; ii < numEncoders; ++ii)
+			// Bias active encoder count so that the last encoder ending while
+			// API thread waits here posts semaphore exactly once. Bias stays
+			// until encoderApiDone.
+			const int32_t numActive = bx::atomicFetchAndAdd<int32_t>(&m_encoderActive, kEncoderFrameBias);
+			if (0 != numActive)
 			{
 				m_encoderEndSem.wait();
 			}
 
-			for (uint16_t ii = 0; ii < numEncoders; ++ii)
+			updateEncoderStats(bx::min<uint32_t>(m_numEncoders, g_caps.limits.maxEncoders) );
+		}
+
+		void encoderApiDone()
+		{
+			// No encoder is active and begin can't get past frame bias, so
+			// encoder count and epoch can be reset. Encoder 0 is always owned
+			// by API thread. Bumping epoch releases encoders threads held on
+			// to during previous frame. Epoch 0 is skipped since it would
+			// match zero initialized thread-local encoder index.
+			m_numEncoders  = 1;
+			m_encoderEpoch = uint32_t( (m_encoderEpoch + 1) & kEncoderEpochMask);
+			m_encoderEpoch = 0 == m_encoderEpoch ? 1 : m_encoderEpoch;
+
+			bx::atomicFetchAndSub<int32_t>(&m_encoderActive, kEncoderFrameBias);
+			m_encoderApiLock.unlock();
+		}
+
+		void encoderActiveRelease()
+		{
+			if (kEncoderFrameBias+1 == bx::atomicFetchAndSub<int32_t>(&m_encoderActive, 1) )
 			{
-				uint16_t idx = m_encoderHandle->getHandleAt(ii);
-				m_encoderStats[ii].cpuTimeBegin = m_encoder[idx].m_cpuTimeBegin;
-				m_encoderStats[ii].cpuTimeEnd   = m_encoder[idx].m_cpuTimeEnd;
+				m_encoderEndSem.post();
 			}
+		}
 
-			m_submit->m_perfStats.numEncoders = uint8_t(numEncoders);
-
-			m_encoderHandle->reset();
-			uint16_t idx = m_encoderHandle->alloc();
-			BX_CHECK(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
+		uintptr_t encoderTls(uint32_t _idx, bool _active) const
+		{
+			return (uintptr_t(m_encoderEpoch) << 8)
+				| (_active ? 0x80 : 0)
+				| _idx
+				;
 		}
 
+		static const int32_t   kEncoderFrameBias = INT32_C(1)<<30;
+		static const uintptr_t kEncoderEpochMask = UINTPTR_MAX>>8;
+
+		int32_t  m_encoderActive;
+		uint32_t m_encoderEpoch;
+
 		bx::Semaphore m_renderSem;
 		bx::Semaphore m_apiSem;
 		bx::Semaphore m_encoderEndSem;
@@ -4885,24 +6661,53 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void encoderApiWait()
 		{
-			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
-			m_encoderStats[0].cpuTimeEnd   = m_encoder[0].m_cpuTimeEnd;
-			m_submit->m_perfStats.numEncoders = 1;
+			updateEncoderStats(1);
+		}
+
+		void encoderApiDone()
+		{
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		void updateEncoderStats(uint32_t _numEncoders)
+		{
+			Stats& stats = m_submit->m_perfStats;
+			stats.numEncoders       = uint8_t(_numEncoders);
+			stats.numDropped        = 0;
+			stats.uniformBufferUsed = 0;
+
+			for (uint32_t ii = 0; ii < _numEncoders; ++ii)
+			{
+				const EncoderImpl& encoder = m_encoder[ii];
+
+				EncoderStats& encoderStats = m_encoderStats[ii];
+				encoderStats.cpuTimeBegin      = encoder.m_cpuTimeBegin;
+				encoderStats.cpuTimeEnd        = encoder.m_cpuTimeEnd;
+				encoderStats.numSubmitted      = encoder.m_numSubmitted;
+				encoderStats.numDropped        = encoder.m_numDropped;
+				encoderStats.uniformBufferUsed = encoder.m_uniformPos;
+
+				stats.numDropped        += encoder.m_numDropped;
+				stats.uniformBufferUsed += int32_t(encoder.m_uniformPos);
+
+				m_uniformBufferMaxUsed = bx::max(m_uniformBufferMaxUsed, encoder.m_uniformPos);
+			}
+		}
+
 		EncoderStats* m_encoderStats;
 		Encoder*      m_encoder0;
 		EncoderImpl*  m_encoder;
 		uint32_t      m_numEncoders;
-		bx::HandleAlloc* m_encoderHandle;
 
-		Frame  m_frame[1+(BGFX_CONFIG_MULTITHREADED ? 1 : 0)];
+		Frame  m_frame[BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT];
 		Frame* m_render;
 		Frame* m_submit;
+		uint32_t m_numFrames;
+		uint32_t m_submitIdx;   // API thread, frame being submitted.
+		uint32_t m_renderIdx;   // Render thread, next frame to render.
+		uint32_t m_renderedIdx; // Render thread, last frame rendered.
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		uint32_t m_tempBlitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
@@ -4921,6 +6726,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS> m_dynamicIndexBufferHandle;
 		NonLocalAllocator m_dynVertexBufferAllocator;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS> m_dynamicVertexBufferHandle;
+		DynamicBufferUpdateArray m_dynIndexBufferUpdate;
+		DynamicBufferUpdateArray m_dynVertexBufferUpdate;
 
 		bx::HandleAllocT<BGFX_CONFIG_MAX_INDEX_BUFFERS> m_indexBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_LAYOUTS > m_layoutHandle;
@@ -4932,10 +6739,25 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_DRAW_BUNDLES> m_drawBundleHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORM_BLOCKS> m_uniformBlockHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_TRANSFORM_BUFFERS> m_transformBufferHandle;
+
+		DrawBundle m_drawBundle[BGFX_CONFIG_MAX_DRAW_BUNDLES];
+		uint32_t   m_drawBundleSerial;
+
+		NonLocalAllocator  m_transformBufferAllocator;
+		TransformBufferRef m_transformBufferRef[BGFX_CONFIG_MAX_TRANSFORM_BUFFERS];
+		Matrix4*           m_transformBuffer;
+		bx::Mutex          m_transformBufferLock;
+		uint32_t           m_transformBufferDirtyBegin[BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT];
+		uint32_t           m_transformBufferDirtyEnd[BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT];
+		uint32_t           m_transformBufferUsed;
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
 		UniformRef     m_uniformRef[BGFX_CONFIG_MAX_UNIFORMS];
+		UniformBlock   m_uniformBlockRef[BGFX_CONFIG_MAX_UNIFORM_BLOCKS];
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_SHADERS*2> ShaderHashMap;
 		ShaderHashMap m_shaderHashMap;
@@ -4952,6 +6774,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
 		uint32_t m_seq[BGFX_CONFIG_MAX_VIEWS];
 		View m_view[BGFX_CONFIG_MAX_VIEWS];
+		UniformBuffer* m_viewUniform[BGFX_CONFIG_MAX_VIEWS];
 
 		float m_clearColor[BGFX_CONFIG_MAX_COLOR_PALETTE][4];
 
@@ -4962,11 +6785,20 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		uint32_t m_frames;
 		uint32_t m_debug;
 
+		uint32_t m_transientVbMaxUsed;
+		uint32_t m_transformsMaxUsed;
+		uint32_t m_rectsMaxUsed;
+		uint32_t m_uniformBufferMaxUsed;
+		uint32_t m_cmdBufferMaxUsed;
+		uint32_t m_transientIbMaxUsed;
+
 		int64_t m_rtMemoryUsed;
 		int64_t m_textureMemoryUsed;
 
 		TextVideoMemBlitter m_textVideoMemBlitter;
 		ClearQuad m_clearQuad;
+		UniformShadow m_uniformShadow;
+		UniformBlock m_uniformBlock[BGFX_CONFIG_MAX_UNIFORM_BLOCKS];
 
 		RendererContextI* m_renderCtx;
 		RendererContextI* m_renderMain;
@@ -4976,10 +6808,24 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bool m_exit;
 		bool m_flipAfterRender;
 		bool m_singleThreaded;
+
+		TextureAsyncJobArray m_textureAsyncQueue;
+		TextureAsyncJobArray m_textureAsyncDone;
+		bx::Mutex     m_textureAsyncLock;
+		bx::Semaphore m_textureAsyncSem;
+		bx::Thread    m_textureAsyncThread;
+		uint32_t      m_textureAsyncSerial;
+		bool          m_textureAsyncExit;
 		bool m_flipped;
 
-		typedef UpdateBatchT<256> TextureUpdateBatch;
+		static const uint32_t kMaxTextureUpdates = 256;
+		typedef UpdateBatchT<kMaxTextureUpdates> TextureUpdateBatch;
 		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
+		TextureUpdateSource m_textureUpdateSource[kMaxTextureUpdates];
+		TextureUpdateRegion m_textureUpdateRegion[kMaxTextureUpdates];
+
+		FrameTraceWriter m_frameTraceWriter;
+		FrameTraceReader m_frameTraceReader;
 	};
 
 #undef BGFX_API_FUNC
@@ -196,6 +196,32 @@
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+/// Maximum number of render items encoder reserves at once. Encoders
+/// reserve blocks of render items to avoid contention on frame's render
+/// item counter.
+#ifndef BGFX_CONFIG_RENDER_ITEM_BLOCK_SIZE
+#	define BGFX_CONFIG_RENDER_ITEM_BLOCK_SIZE 256
+#endif // BGFX_CONFIG_RENDER_ITEM_BLOCK_SIZE
+
+/// Number of render items in first block encoder reserves. Each following
+/// block is twice as large, up to BGFX_CONFIG_RENDER_ITEM_BLOCK_SIZE, so
+/// that short lived encoders don't waste draw calls.
+#ifndef BGFX_CONFIG_RENDER_ITEM_BLOCK_MIN_SIZE
+#	define BGFX_CONFIG_RENDER_ITEM_BLOCK_MIN_SIZE 16
+#endif // BGFX_CONFIG_RENDER_ITEM_BLOCK_MIN_SIZE
+
+/// Number of entries in per encoder cache used to intern draw call bindings
+/// into frame's bind table. Must be power of 2.
+#ifndef BGFX_CONFIG_BIND_CACHE_SIZE
+#	define BGFX_CONFIG_BIND_CACHE_SIZE 64
+#endif // BGFX_CONFIG_BIND_CACHE_SIZE
+
+/// Keep render thread copy of uniform values passed to renderer, and skip
+/// uniform updates that don't change value.
+#ifndef BGFX_CONFIG_UNIFORM_SHADOW
+#	define BGFX_CONFIG_UNIFORM_SHADOW 1
+#endif // BGFX_CONFIG_UNIFORM_SHADOW
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
@@ -204,6 +230,16 @@
 #	define BGFX_CONFIG_MAX_MATRIX_CACHE (BGFX_CONFIG_MAX_DRAW_CALLS+1)
 #endif // BGFX_CONFIG_MAX_MATRIX_CACHE
 
+/// Number of matrices shared by all persistent transform buffers. They are
+/// stored in matrix cache of each frame, in addition to per frame matrices.
+#ifndef BGFX_CONFIG_MAX_PERSISTENT_TRANSFORMS
+#	define BGFX_CONFIG_MAX_PERSISTENT_TRANSFORMS (16<<10)
+#endif // BGFX_CONFIG_MAX_PERSISTENT_TRANSFORMS
+
+#ifndef BGFX_CONFIG_MAX_TRANSFORM_BUFFERS
+#	define BGFX_CONFIG_MAX_TRANSFORM_BUFFERS (1<<10)
+#endif // BGFX_CONFIG_MAX_TRANSFORM_BUFFERS
+
 #ifndef BGFX_CONFIG_MAX_RECT_CACHE
 #	define BGFX_CONFIG_MAX_RECT_CACHE (4<<10)
 #endif //  BGFX_CONFIG_MAX_RECT_CACHE
@@ -220,6 +256,12 @@
 #	define BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM 9
 #endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
 
+/// Number of bits of user material id stored in draw sort key. Draw calls
+/// with the same program are grouped by material.
+#ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+#	define BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL 8
+#endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_MATERIAL
+
 // Cannot be configured via compiler options.
 #define BGFX_CONFIG_MAX_PROGRAMS (1<<BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM)
 BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_PROGRAMS), "BGFX_CONFIG_MAX_PROGRAMS must be power of 2.");
@@ -291,10 +333,24 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_UNIFORMS 512
 #endif // BGFX_CONFIG_MAX_UNIFORMS
 
+#ifndef BGFX_CONFIG_MAX_UNIFORM_BLOCKS
+#	define BGFX_CONFIG_MAX_UNIFORM_BLOCKS 256
+#endif // BGFX_CONFIG_MAX_UNIFORM_BLOCKS
+
+#ifndef BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS
+#	define BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS 32
+#endif // BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS
+
 #ifndef BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+#ifndef BGFX_CONFIG_MAX_DRAW_BUNDLES
+#	define BGFX_CONFIG_MAX_DRAW_BUNDLES (1<<10)
+#endif // BGFX_CONFIG_MAX_DRAW_BUNDLES
+
+/// Size of command buffer block. Command buffers chain additional pooled
+/// blocks of this size on demand, it only limits size of single write.
 #ifndef BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
@@ -307,6 +363,18 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Maximum number of overflow pages transient vertex and index buffers can
+/// grow by within a frame, when primary transient buffer is exhausted.
+#ifndef BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES
+#	define BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES 8
+#endif // BGFX_CONFIG_MAX_TRANSIENT_BUFFER_PAGES
+
+/// Number of frames overflow transient buffer page can stay unused before
+/// it's destroyed.
+#ifndef BGFX_CONFIG_TRANSIENT_BUFFER_PAGE_IDLE_FRAMES
+#	define BGFX_CONFIG_TRANSIENT_BUFFER_PAGE_IDLE_FRAMES 120
+#endif // BGFX_CONFIG_TRANSIENT_BUFFER_PAGE_IDLE_FRAMES
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -321,6 +389,18 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_PROFILER 0
 #endif // BGFX_CONFIG_PROFILER
 
+/// Number of events built-in profiler keeps per thread. Events are recorded
+/// while `BGFX_DEBUG_PROFILER` debug flag is set, and they are exported with
+/// `bgfx::saveProfilerTrace`. Must be power of two.
+#ifndef BGFX_CONFIG_PROFILER_MAX_EVENTS
+#	define BGFX_CONFIG_PROFILER_MAX_EVENTS (16<<10)
+#endif // BGFX_CONFIG_PROFILER_MAX_EVENTS
+
+/// Maximum number of threads recorded by built-in profiler.
+#ifndef BGFX_CONFIG_PROFILER_MAX_THREADS
+#	define BGFX_CONFIG_PROFILER_MAX_THREADS 16
+#endif // BGFX_CONFIG_PROFILER_MAX_THREADS
+
 #ifndef BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
 #	define BGFX_CONFIG_RENDERDOC_LOG_FILEPATH "temp/bgfx"
 #endif // BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
@@ -341,8 +421,36 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+/// Maximum number of submitted frames that can be queued between API and
+/// render thread. API thread can run ahead of render thread by number of
+/// frames in flight minus one.
+#ifndef BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT
+#	define BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT ( (0 != BGFX_CONFIG_MULTITHREADED) ? 4 : 1)
+#endif // BGFX_CONFIG_MAX_FRAMES_IN_FLIGHT
+
+#ifndef BGFX_CONFIG_DEFAULT_FRAMES_IN_FLIGHT
+#	define BGFX_CONFIG_DEFAULT_FRAMES_IN_FLIGHT ( (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 1)
+#endif // BGFX_CONFIG_DEFAULT_FRAMES_IN_FLIGHT
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
 
+/// Build AVX2 kernels for transform conversion. They are used only when
+/// CPU and OS support AVX2, which is checked at init.
+#ifndef BGFX_CONFIG_SIMD_AVX2
+#	define BGFX_CONFIG_SIMD_AVX2 (0   \
+		|| (BX_CPU_X86                  \
+		&& !BX_PLATFORM_EMSCRIPTEN      \
+		&& (BX_COMPILER_GCC || BX_COMPILER_CLANG || BX_COMPILER_MSVC) ) \
+		? 1 : 0)
+#endif // BGFX_CONFIG_SIMD_AVX2
+
+/// Keep creation data of all live resources, so that frame trace started at
+/// any time can recreate resources created before it was started. When
+/// disabled, frame trace contains only resources created after it's started.
+#ifndef BGFX_CONFIG_FRAME_TRACE
+#	define BGFX_CONFIG_FRAME_TRACE 0
+#endif // BGFX_CONFIG_FRAME_TRACE
+
 #endif // BGFX_CONFIG_H_HEADER_GUARD
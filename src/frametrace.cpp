@@ -0,0 +1,2206 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+
+#include <bx/file.h>
+
+// Frame trace file starts with header, followed by chunks. Each chunk is
+// tag, size, and payload.
+//
+//   'RSRC' - Commands recreating resources that were alive when trace was
+//            started. Empty unless BGFX_CONFIG_FRAME_TRACE is enabled.
+//   'FRME' - One per submitted frame: pre commands, transient buffers,
+//            views, view remap, color palette, matrix and rect cache, binds,
+//            sort runs with render items and uniform streams, blit items,
+//            post commands.
+//
+// Commands are stored with memory inlined. Handles are stored as they were
+// at capture time and remapped to newly allocated handles at replay. Frame
+// structures are stored as raw memory, so trace can be replayed only by
+// build with the same structure layout, header is used to check that.
+
+namespace bgfx
+{
+	static const uint32_t kFrameTraceMagic    = BX_MAKEFOURCC('F', 'T', 'R', 0x1);
+	static const uint32_t kFrameTraceResource = BX_MAKEFOURCC('R', 'S', 'R', 'C');
+	static const uint32_t kFrameTraceFrame    = BX_MAKEFOURCC('F', 'R', 'M', 'E');
+
+	struct FrameTraceHeader
+	{
+		uint32_t m_magic;
+		uint32_t m_apiVersion;
+		uint32_t m_maxViews;
+		uint32_t m_maxColorPalette;
+		uint32_t m_viewSize;
+		uint32_t m_renderItemSize;
+		uint32_t m_renderItemCountSize;
+		uint32_t m_renderBindSize;
+		uint32_t m_blitItemSize;
+		uint32_t m_rendererType;
+	};
+
+	static void frameTraceHeaderInit(FrameTraceHeader& _header)
+	{
+		bx::memSet(&_header, 0, sizeof(_header) );
+		_header.m_magic               = kFrameTraceMagic;
+		_header.m_apiVersion          = BGFX_API_VERSION;
+		_header.m_maxViews            = BGFX_CONFIG_MAX_VIEWS;
+		_header.m_maxColorPalette     = BGFX_CONFIG_MAX_COLOR_PALETTE;
+		_header.m_viewSize            = sizeof(View);
+		_header.m_renderItemSize      = sizeof(RenderItem);
+		_header.m_renderItemCountSize = sizeof(RenderItemCount);
+		_header.m_renderBindSize      = sizeof(RenderBind);
+		_header.m_blitItemSize        = sizeof(BlitItem);
+		_header.m_rendererType        = g_caps.rendererType;
+	}
+
+	static const uint32_t s_maxResources[] =
+	{
+		BGFX_CONFIG_MAX_VERTEX_LAYOUTS,
+		BGFX_CONFIG_MAX_UNIFORMS,
+		BGFX_CONFIG_MAX_UNIFORM_BLOCKS,
+		BGFX_CONFIG_MAX_SHADERS,
+		BGFX_CONFIG_MAX_PROGRAMS,
+		BGFX_CONFIG_MAX_INDEX_BUFFERS,
+		BGFX_CONFIG_MAX_VERTEX_BUFFERS,
+		BGFX_CONFIG_MAX_TEXTURES,
+		BGFX_CONFIG_MAX_FRAME_BUFFERS,
+	};
+	BX_STATIC_ASSERT(BX_COUNTOF(s_maxResources) == FrameTraceResource::Count);
+
+	struct RetainOp
+	{
+		enum Enum
+		{
+			None,
+			Create,
+			Append,
+			Destroy,
+		};
+	};
+
+	static FrameTraceResource::Enum getDestroyResource(uint8_t _command)
+	{
+		switch (_command)
+		{
+		case CommandBuffer::DestroyVertexLayout:        return FrameTraceResource::VertexLayout;
+		case CommandBuffer::DestroyIndexBuffer:         return FrameTraceResource::IndexBuffer;
+		case CommandBuffer::DestroyVertexBuffer:        return FrameTraceResource::VertexBuffer;
+		case CommandBuffer::DestroyDynamicIndexBuffer:  return FrameTraceResource::IndexBuffer;
+		case CommandBuffer::DestroyDynamicVertexBuffer: return FrameTraceResource::VertexBuffer;
+		case CommandBuffer::DestroyShader:              return FrameTraceResource::Shader;
+		case CommandBuffer::DestroyProgram:             return FrameTraceResource::Program;
+		case CommandBuffer::DestroyTexture:             return FrameTraceResource::Texture;
+		case CommandBuffer::DestroyFrameBuffer:         return FrameTraceResource::FrameBuffer;
+		case CommandBuffer::DestroyUniform:             return FrameTraceResource::Uniform;
+		case CommandBuffer::DestroyUniformBlock:        return FrameTraceResource::UniformBlock;
+		default:
+			break;
+		}
+
+		return FrameTraceResource::Count;
+	}
+
+	static FrameTraceResource::Enum getNameResource(uint16_t _type)
+	{
+		switch (_type)
+		{
+		case Handle::IndexBuffer:  return FrameTraceResource::IndexBuffer;
+		case Handle::Shader:       return FrameTraceResource::Shader;
+		case Handle::Texture:      return FrameTraceResource::Texture;
+		case Handle::VertexBuffer: return FrameTraceResource::VertexBuffer;
+		default:
+			break;
+		}
+
+		return FrameTraceResource::Count;
+	}
+
+	static void writeMemory(bx::WriterI* _writer, const Memory* _mem)
+	{
+		bx::write(_writer, _mem->size);
+		bx::write(_writer, _mem->data, _mem->size);
+	}
+
+	static const Memory* readMemory(bx::ReaderI* _reader)
+	{
+		uint32_t size;
+		bx::read(_reader, size);
+		const Memory* mem = alloc(size);
+		bx::read(_reader, mem->data, size);
+		return mem;
+	}
+
+	static bool isTextureCreate(const Memory* _mem)
+	{
+		if (_mem->size < sizeof(uint32_t)+sizeof(TextureCreate) )
+		{
+			return false;
+		}
+
+		uint32_t magic;
+		bx::memCopy(&magic, _mem->data, sizeof(magic) );
+		return BGFX_CHUNK_MAGIC_TEX == magic;
+	}
+
+	static uint32_t getUniformStreamSize(const UniformBuffer* _uniformBuffer)
+	{
+		const uint8_t* data = (const uint8_t*)_uniformBuffer->getData();
+
+		uint32_t pos = 0;
+		for (;;)
+		{
+			uint32_t opcode;
+			bx::memCopy(&opcode, &data[pos], sizeof(opcode) );
+			pos += sizeof(opcode);
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			pos += 0 != copy
+				? g_uniformTypeSize[type]*num
+				: sizeof(UniformHandle)
+				;
+		}
+
+		return pos;
+	}
+
+	FrameTraceBuffer::FrameTraceBuffer()
+		: m_data(NULL)
+		, m_size(0)
+		, m_max(0)
+	{
+	}
+
+	FrameTraceBuffer::~FrameTraceBuffer()
+	{
+		BX_FREE(g_allocator, m_data);
+	}
+
+	int32_t FrameTraceBuffer::write(const void* _data, int32_t _size, bx::Error* _err)
+	{
+		BX_UNUSED(_err);
+
+		const uint32_t size = m_size + _size;
+		if (size > m_max)
+		{
+			m_max  = bx::max<uint32_t>(bx::max<uint32_t>(m_max*2, size), 4<<10);
+			m_data = (uint8_t*)BX_REALLOC(g_allocator, m_data, m_max);
+		}
+
+		bx::memCopy(&m_data[m_size], _data, _size);
+		m_size = size;
+
+		return _size;
+	}
+
+	FrameTraceWriter::FrameTraceWriter()
+		: m_writer(NULL)
+	{
+		bx::memSet(m_retained, 0, sizeof(m_retained) );
+	}
+
+	FrameTraceWriter::~FrameTraceWriter()
+	{
+		BX_CHECK(NULL == m_writer, "Frame trace must be stopped before destruction.");
+	}
+
+	bool FrameTraceWriter::start(const char* _filePath)
+	{
+		stop();
+
+		bx::FileWriter* writer = BX_NEW(g_allocator, bx::FileWriter);
+		if (!bx::open(writer, _filePath) )
+		{
+			BX_TRACE("Failed to open frame trace file: %s.", _filePath);
+			BX_DELETE(g_allocator, writer);
+			return false;
+		}
+
+		m_writer = writer;
+
+		FrameTraceHeader header;
+		frameTraceHeaderInit(header);
+		bx::write(m_writer, header);
+
+		m_frame.reset();
+
+		for (uint32_t type = 0; type < FrameTraceResource::Count; ++type)
+		{
+			if (NULL == m_retained[type])
+			{
+				continue;
+			}
+
+			for (uint32_t ii = 0, num = s_maxResources[type]; ii < num; ++ii)
+			{
+				const FrameTraceBuffer* record = m_retained[type][ii];
+				if (NULL != record)
+				{
+					bx::write(&m_frame, record->m_data, record->m_size);
+				}
+			}
+		}
+
+		const uint8_t end = CommandBuffer::End;
+		bx::write(&m_frame, end);
+		writeChunk(kFrameTraceResource, m_frame);
+
+		return true;
+	}
+
+	void FrameTraceWriter::stop()
+	{
+		if (NULL != m_writer)
+		{
+			bx::close(m_writer);
+			BX_DELETE(g_allocator, m_writer);
+			m_writer = NULL;
+		}
+	}
+
+	void FrameTraceWriter::frame(Frame* _frame)
+	{
+		if (NULL == m_writer
+		&&  !BX_ENABLED(BGFX_CONFIG_FRAME_TRACE) )
+		{
+			return;
+		}
+
+		BGFX_PROFILER_SCOPE("bgfx/Frame trace", 0xff2040ff);
+
+		const uint8_t end = CommandBuffer::End;
+
+		m_frame.reset();
+
+		encodeCommands(_frame->m_cmdPre);
+
+		if (NULL != m_writer)
+		{
+			bx::write(&m_frame, end);
+			encodeFrame(_frame);
+		}
+
+		encodeCommands(_frame->m_cmdPost);
+
+		if (NULL != m_writer)
+		{
+			bx::write(&m_frame, end);
+			writeChunk(kFrameTraceFrame, m_frame);
+		}
+	}
+
+	void FrameTraceWriter::shutdown()
+	{
+		stop();
+
+		for (uint32_t type = 0; type < FrameTraceResource::Count; ++type)
+		{
+			if (NULL == m_retained[type])
+			{
+				continue;
+			}
+
+			for (uint32_t ii = 0, num = s_maxResources[type]; ii < num; ++ii)
+			{
+				if (NULL != m_retained[type][ii])
+				{
+					BX_DELETE(g_allocator, m_retained[type][ii]);
+				}
+			}
+
+			BX_FREE(g_allocator, m_retained[type]);
+			m_retained[type] = NULL;
+		}
+	}
+
+	void FrameTraceWriter::writeChunk(uint32_t _tag, const FrameTraceBuffer& _chunk)
+	{
+		bx::write(m_writer, _tag);
+		bx::write(m_writer, _chunk.m_size);
+		bx::write(m_writer, _chunk.m_data, _chunk.m_size);
+	}
+
+	void FrameTraceWriter::encodeCommands(CommandBuffer& _cmdbuf)
+	{
+		_cmdbuf.reset();
+
+		for (;;)
+		{
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			if (CommandBuffer::End                 == command
+			||  CommandBuffer::RendererShutdownEnd == command)
+			{
+				break;
+			}
+
+			m_command.reset();
+			bx::write(&m_command, command);
+
+			FrameTraceResource::Enum type = FrameTraceResource::Count;
+			uint16_t idx = kInvalidHandle;
+			uint8_t  op  = RetainOp::None;
+
+			switch (command)
+			{
+			case CommandBuffer::RendererInit:
+				{
+					Init init;
+					_cmdbuf.read(init);
+				}
+				continue;
+
+			case CommandBuffer::RendererShutdownBegin:
+				continue;
+
+			case CommandBuffer::CreateVertexLayout:
+				{
+					VertexLayoutHandle handle;
+					_cmdbuf.read(handle);
+
+					VertexLayout layout;
+					_cmdbuf.read(layout);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, layout);
+
+					type = FrameTraceResource::VertexLayout;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					bx::write(&m_command, handle);
+					writeMemory(&m_command, mem);
+					bx::write(&m_command, flags);
+
+					type = FrameTraceResource::IndexBuffer;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					VertexLayoutHandle layoutHandle;
+					_cmdbuf.read(layoutHandle);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					bx::write(&m_command, handle);
+					writeMemory(&m_command, mem);
+					bx::write(&m_command, layoutHandle);
+					bx::write(&m_command, flags);
+
+					type = FrameTraceResource::VertexBuffer;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				{
+					uint16_t handle;
+					_cmdbuf.read(handle);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, size);
+					bx::write(&m_command, flags);
+
+					type = CommandBuffer::CreateDynamicIndexBuffer == command
+						? FrameTraceResource::IndexBuffer
+						: FrameTraceResource::VertexBuffer
+						;
+					idx  = handle;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					uint16_t handle;
+					_cmdbuf.read(handle);
+
+					uint32_t offset;
+					_cmdbuf.read(offset);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, offset);
+					bx::write(&m_command, size);
+					writeMemory(&m_command, mem);
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					ShaderHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					bx::write(&m_command, handle);
+					writeMemory(&m_command, mem);
+
+					type = FrameTraceResource::Shader;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				{
+					ProgramHandle handle;
+					_cmdbuf.read(handle);
+
+					ShaderHandle vsh;
+					_cmdbuf.read(vsh);
+
+					ShaderHandle fsh;
+					_cmdbuf.read(fsh);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, vsh);
+					bx::write(&m_command, fsh);
+
+					type = FrameTraceResource::Program;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint64_t flags;
+					_cmdbuf.read(flags);
+
+					uint8_t skip;
+					_cmdbuf.read(skip);
+
+					bx::write(&m_command, handle);
+					writeMemory(&m_command, mem);
+
+					// Texture create info points to texel memory, it's stored
+					// right after it.
+					if (isTextureCreate(mem) )
+					{
+						TextureCreate tc;
+						bx::memCopy(&tc, &mem->data[sizeof(uint32_t)], sizeof(tc) );
+
+						const uint8_t hasMem = NULL != tc.m_mem;
+						bx::write(&m_command, hasMem);
+
+						if (hasMem)
+						{
+							writeMemory(&m_command, tc.m_mem);
+						}
+					}
+
+					bx::write(&m_command, flags);
+					bx::write(&m_command, skip);
+
+					type = FrameTraceResource::Texture;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t side;
+					_cmdbuf.read(side);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+
+					uint8_t format;
+					_cmdbuf.read(format);
+
+					Rect rect;
+					_cmdbuf.read(rect);
+
+					uint16_t zz;
+					_cmdbuf.read(zz);
+
+					uint16_t depth;
+					_cmdbuf.read(depth);
+
+					uint16_t pitch;
+					_cmdbuf.read(pitch);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, side);
+					bx::write(&m_command, mip);
+					bx::write(&m_command, format);
+					bx::write(&m_command, rect);
+					bx::write(&m_command, zz);
+					bx::write(&m_command, depth);
+					bx::write(&m_command, pitch);
+					writeMemory(&m_command, mem);
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t width;
+					_cmdbuf.read(width);
+
+					uint16_t height;
+					_cmdbuf.read(height);
+
+					uint8_t numMips;
+					_cmdbuf.read(numMips);
+
+					uint16_t numLayers;
+					_cmdbuf.read(numLayers);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, width);
+					bx::write(&m_command, height);
+					bx::write(&m_command, numMips);
+					bx::write(&m_command, numLayers);
+
+					type = FrameTraceResource::Texture;
+					idx  = handle.idx;
+					op   = RetainOp::Append;
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					bool window;
+					_cmdbuf.read(window);
+
+					// Window frame buffers are not stored, native window handle
+					// is meaningless at replay. Views rendering into them are
+					// replayed into back buffer.
+					if (window)
+					{
+						void* nwh;
+						_cmdbuf.read(nwh);
+
+						uint16_t width;
+						_cmdbuf.read(width);
+
+						uint16_t height;
+						_cmdbuf.read(height);
+
+						TextureFormat::Enum format;
+						_cmdbuf.read(format);
+
+						TextureFormat::Enum depthFormat;
+						_cmdbuf.read(depthFormat);
+
+						continue;
+					}
+
+					uint8_t num;
+					_cmdbuf.read(num);
+
+					Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+					_cmdbuf.read(attachment, sizeof(Attachment) * num);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, num);
+					bx::write(&m_command, attachment, sizeof(Attachment) * num);
+
+					type = FrameTraceResource::FrameBuffer;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					UniformHandle handle;
+					_cmdbuf.read(handle);
+
+					UniformType::Enum uniformType;
+					_cmdbuf.read(uniformType);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					uint8_t len;
+					_cmdbuf.read(len);
+
+					const uint8_t* name = _cmdbuf.skip(len);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, uniformType);
+					bx::write(&m_command, num);
+					bx::write(&m_command, len);
+					bx::write(&m_command, name, len);
+
+					type = FrameTraceResource::Uniform;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::CreateUniformBlock:
+				{
+					UniformBlockHandle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					UniformBlock::Entry entry[BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS];
+					_cmdbuf.read(entry, sizeof(UniformBlock::Entry)*num);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, num);
+					bx::write(&m_command, entry, sizeof(UniformBlock::Entry)*num);
+
+					type = FrameTraceResource::UniformBlock;
+					idx  = handle.idx;
+					op   = RetainOp::Create;
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					ViewId id;
+					_cmdbuf.read(id);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					const uint8_t* name = _cmdbuf.skip(len);
+
+					bx::write(&m_command, id);
+					bx::write(&m_command, len);
+					bx::write(&m_command, name, len);
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					Handle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					const uint8_t* name = _cmdbuf.skip(len);
+
+					bx::write(&m_command, handle);
+					bx::write(&m_command, len);
+					bx::write(&m_command, name, len);
+
+					type = getNameResource(handle.type);
+					idx  = handle.idx;
+					op   = RetainOp::Append;
+				}
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+				{
+					OcclusionQueryHandle handle;
+					_cmdbuf.read(handle);
+				}
+				continue;
+
+			case CommandBuffer::ReadTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					void* data;
+					_cmdbuf.read(data);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+				}
+				continue;
+
+			case CommandBuffer::RequestScreenShot:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					_cmdbuf.skip(len);
+				}
+				continue;
+
+			default:
+				{
+					type = getDestroyResource(command);
+					BX_CHECK(FrameTraceResource::Count != type, "Invalid command: %d", command);
+
+					uint16_t handle;
+					_cmdbuf.read(handle);
+
+					bx::write(&m_command, handle);
+
+					idx = handle;
+					op  = RetainOp::Destroy;
+				}
+				break;
+			}
+
+			if (NULL != m_writer)
+			{
+				bx::write(&m_frame, m_command.m_data, m_command.m_size);
+			}
+
+			if (BX_ENABLED(BGFX_CONFIG_FRAME_TRACE)
+			&&  FrameTraceResource::Count != type)
+			{
+				retain(type, idx, op);
+			}
+		}
+	}
+
+	void FrameTraceWriter::encodeFrame(const Frame* _frame)
+	{
+		bx::WriterI* writer = &m_frame;
+
+		// Only part of primary transient buffers used by this frame is stored,
+		// overflow pages are uploaded by update commands stored with other
+		// commands.
+		{
+			const TransientIndexBuffer* tib = _frame->m_transientIb;
+			IndexBufferHandle handle = BGFX_INVALID_HANDLE;
+			uint32_t size = 0;
+
+			if (NULL != tib)
+			{
+				handle = tib->handle;
+				size   = _frame->m_iboffset;
+			}
+
+			bx::write(writer, handle);
+			bx::write(writer, size);
+			bx::write(writer, NULL != tib ? tib->data : NULL, size);
+		}
+
+		{
+			const TransientVertexBuffer* tvb = _frame->m_transientVb;
+			VertexBufferHandle handle = BGFX_INVALID_HANDLE;
+			uint32_t size = 0;
+
+			if (NULL != tvb)
+			{
+				handle = tvb->handle;
+				size   = _frame->m_vboffset;
+			}
+
+			bx::write(writer, handle);
+			bx::write(writer, size);
+			bx::write(writer, NULL != tvb ? tvb->data : NULL, size);
+		}
+
+		// Views up to the last one used. With custom view order all views
+		// are stored, since remapped view can be any.
+		const uint32_t maxEncoders = g_caps.limits.maxEncoders;
+
+		uint32_t numViews = 0;
+		for (uint32_t ii = 0; ii < maxEncoders; ++ii)
+		{
+			const SortRun& run = _frame->m_sortRun[ii];
+			if (0 < run.m_num)
+			{
+				numViews = bx::max<uint32_t>(numViews, SortKey::decodeView(run.m_keys[run.m_num-1])+1);
+			}
+		}
+
+		for (uint32_t ii = 0, num = _frame->m_numBlitItems; ii < num; ++ii)
+		{
+			numViews = bx::max<uint32_t>(numViews, (_frame->m_blitKeys[ii]>>24)+1);
+		}
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			if (ii != _frame->m_viewRemap[ii])
+			{
+				numViews = BGFX_CONFIG_MAX_VIEWS;
+				break;
+			}
+		}
+
+		bx::write(writer, uint16_t(numViews) );
+		bx::write(writer, _frame->m_view, numViews*sizeof(View) );
+		bx::write(writer, _frame->m_viewRemap, sizeof(_frame->m_viewRemap) );
+		bx::write(writer, _frame->m_colorPalette, sizeof(_frame->m_colorPalette) );
+
+		for (uint32_t ii = 0; ii < numViews; ++ii)
+		{
+			const View& view = _frame->m_view[ii];
+			const uint32_t size = view.m_uniformEnd - view.m_uniformBegin;
+			bx::write(writer, size);
+			bx::write(writer, &_frame->m_viewUniformBuffer->getData()[view.m_uniformBegin], size);
+		}
+
+		const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		bx::write(writer, matrixCache.m_num);
+		bx::write(writer, matrixCache.m_cache, matrixCache.m_num*sizeof(Matrix4) );
+
+		const RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		bx::write(writer, rectCache.m_num);
+		bx::write(writer, rectCache.m_cache, rectCache.m_num*sizeof(Rect) );
+
+		bx::write(writer, _frame->m_numRenderBinds);
+		bx::write(writer, _frame->m_renderBind, _frame->m_numRenderBinds*sizeof(RenderBind) );
+
+		// Render items are stored in sorted order of each run, unused items
+		// reserved by encoders are not stored.
+		uint16_t numRuns = 0;
+		for (uint32_t ii = 0; ii < maxEncoders; ++ii)
+		{
+			numRuns += 0 < _frame->m_sortRun[ii].m_num;
+		}
+
+		bx::write(writer, numRuns);
+
+		for (uint32_t ii = 0; ii < maxEncoders; ++ii)
+		{
+			const SortRun& run = _frame->m_sortRun[ii];
+			if (0 == run.m_num)
+			{
+				continue;
+			}
+
+			bx::write(writer, uint16_t(ii) );
+			bx::write(writer, run.m_num);
+			bx::write(writer, run.m_keys, run.m_num*sizeof(uint64_t) );
+
+			for (uint32_t jj = 0; jj < run.m_num; ++jj)
+			{
+				bx::write(writer, &_frame->m_renderItem[run.m_values[jj] ], sizeof(RenderItem) );
+			}
+
+			for (uint32_t jj = 0; jj < run.m_num; ++jj)
+			{
+				bx::write(writer, _frame->m_renderItemBind[run.m_values[jj] ]);
+			}
+
+			const UniformBuffer* uniformBuffer = _frame->m_uniformBuffer[ii];
+			const uint32_t size = getUniformStreamSize(uniformBuffer);
+			bx::write(writer, size);
+			bx::write(writer, uniformBuffer->getData(), size);
+		}
+
+		bx::write(writer, _frame->m_numBlitItems);
+		bx::write(writer, _frame->m_blitKeys, _frame->m_numBlitItems*sizeof(uint32_t) );
+		bx::write(writer, _frame->m_blitItem, _frame->m_numBlitItems*sizeof(BlitItem) );
+	}
+
+	void FrameTraceWriter::retain(FrameTraceResource::Enum _type, uint16_t _idx, uint8_t _op)
+	{
+		if (_idx >= s_maxResources[_type])
+		{
+			return;
+		}
+
+		if (NULL == m_retained[_type])
+		{
+			const uint32_t size = s_maxResources[_type]*sizeof(FrameTraceBuffer*);
+			m_retained[_type] = (FrameTraceBuffer**)BX_ALLOC(g_allocator, size);
+			bx::memSet(m_retained[_type], 0, size);
+		}
+
+		FrameTraceBuffer*& record = m_retained[_type][_idx];
+
+		switch (_op)
+		{
+		case RetainOp::Create:
+			if (NULL == record)
+			{
+				record = BX_NEW(g_allocator, FrameTraceBuffer);
+			}
+
+			record->reset();
+			BX_FALLTHROUGH;
+
+		case RetainOp::Append:
+			if (NULL != record)
+			{
+				bx::write(record, m_command.m_data, m_command.m_size);
+			}
+			break;
+
+		case RetainOp::Destroy:
+			if (NULL != record)
+			{
+				BX_DELETE(g_allocator, record);
+				record = NULL;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	static uint16_t allocHandle(Context* _ctx, FrameTraceResource::Enum _type)
+	{
+		switch (_type)
+		{
+		case FrameTraceResource::VertexLayout: return _ctx->m_layoutHandle.alloc();
+		case FrameTraceResource::Uniform:      return _ctx->m_uniformHandle.alloc();
+		case FrameTraceResource::UniformBlock: return _ctx->m_uniformBlockHandle.alloc();
+		case FrameTraceResource::Shader:       return _ctx->m_shaderHandle.alloc();
+		case FrameTraceResource::Program:      return _ctx->m_programHandle.alloc();
+		case FrameTraceResource::IndexBuffer:  return _ctx->m_indexBufferHandle.alloc();
+		case FrameTraceResource::VertexBuffer: return _ctx->m_vertexBufferHandle.alloc();
+		case FrameTraceResource::Texture:      return _ctx->m_textureHandle.alloc();
+		case FrameTraceResource::FrameBuffer:  return _ctx->m_frameBufferHandle.alloc();
+		default:
+			break;
+		}
+
+		return kInvalidHandle;
+	}
+
+	// Handles are freed by submit frame at swap, same as handles of destroyed
+	// resources, so they are not reused while destroy command is in flight.
+	static void freeHandle(Context* _ctx, FrameTraceResource::Enum _type, uint16_t _idx)
+	{
+		Frame* frame = _ctx->m_submit;
+
+		switch (_type)
+		{
+		case FrameTraceResource::VertexLayout: { VertexLayoutHandle handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::Uniform:      { UniformHandle      handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::UniformBlock: { UniformBlockHandle handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::Shader:       { ShaderHandle       handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::Program:      { ProgramHandle      handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::IndexBuffer:  { IndexBufferHandle  handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::VertexBuffer: { VertexBufferHandle handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::Texture:      { TextureHandle      handle = { _idx }; frame->free(handle); } break;
+		case FrameTraceResource::FrameBuffer:  { FrameBufferHandle  handle = { _idx }; frame->free(handle); } break;
+		default:
+			break;
+		}
+	}
+
+	FrameTraceReader::FrameTraceReader()
+		: m_ctx(NULL)
+		, m_data(NULL)
+		, m_size(0)
+		, m_resources(0)
+		, m_frameOffset(NULL)
+		, m_numFrames(0)
+		, m_frame(0)
+	{
+		bx::memSet(m_remap,   0, sizeof(m_remap) );
+		bx::memSet(m_destroy, 0, sizeof(m_destroy) );
+	}
+
+	FrameTraceReader::~FrameTraceReader()
+	{
+		BX_CHECK(NULL == m_data, "Frame trace must be closed before destruction.");
+	}
+
+	uint32_t FrameTraceReader::open(Context* _ctx, const char* _filePath)
+	{
+		close();
+
+		bx::FileReader reader;
+		if (!bx::open(&reader, _filePath) )
+		{
+			BX_TRACE("Failed to open frame trace file: %s.", _filePath);
+			return 0;
+		}
+
+		const uint32_t size = uint32_t(bx::getSize(&reader) );
+		uint8_t* data = (uint8_t*)BX_ALLOC(g_allocator, size);
+		bx::read(&reader, data, size);
+		bx::close(&reader);
+
+		FrameTraceHeader expected;
+		frameTraceHeaderInit(expected);
+
+		FrameTraceHeader header;
+		bx::memSet(&header, 0, sizeof(header) );
+
+		if (size >= sizeof(header) )
+		{
+			bx::memCopy(&header, data, sizeof(header) );
+		}
+
+		// Trace captured with other renderer can be replayed, only layout of
+		// stored structures must match.
+		expected.m_rendererType = header.m_rendererType;
+
+		if (0 != bx::memCmp(&header, &expected, sizeof(header) ) )
+		{
+			BX_TRACE("Frame trace file %s is not compatible with this build.", _filePath);
+			BX_FREE(g_allocator, data);
+			return 0;
+		}
+
+		// Chunks past the end of file are ignored, trace might be cut short
+		// if application didn't stop it.
+		uint32_t numFrames = 0;
+		for (uint32_t pass = 0; pass < 2; ++pass)
+		{
+			numFrames = 0;
+
+			for (uint32_t pos = sizeof(header); pos + 2*sizeof(uint32_t) <= size;)
+			{
+				uint32_t tag;
+				bx::memCopy(&tag, &data[pos], sizeof(tag) );
+
+				uint32_t chunkSize;
+				bx::memCopy(&chunkSize, &data[pos+sizeof(tag)], sizeof(chunkSize) );
+
+				if (pos + 2*sizeof(uint32_t) + chunkSize > size)
+				{
+					break;
+				}
+
+				if (kFrameTraceResource == tag)
+				{
+					m_resources = pos;
+				}
+				else if (kFrameTraceFrame == tag)
+				{
+					if (NULL != m_frameOffset)
+					{
+						m_frameOffset[numFrames] = pos;
+					}
+
+					++numFrames;
+				}
+
+				pos += 2*sizeof(uint32_t) + chunkSize;
+			}
+
+			if (0 == pass)
+			{
+				m_frameOffset = (uint32_t*)BX_ALLOC(g_allocator, bx::max<uint32_t>(numFrames, 1)*sizeof(uint32_t) );
+			}
+		}
+
+		for (uint32_t type = 0; type < FrameTraceResource::Count; ++type)
+		{
+			const uint32_t num = s_maxResources[type];
+			m_remap[type]   = (uint16_t*)BX_ALLOC(g_allocator, num*sizeof(uint16_t) );
+			m_destroy[type] = (uint8_t* )BX_ALLOC(g_allocator, num*sizeof(uint8_t) );
+			bx::memSet(m_remap[type], 0xff, num*sizeof(uint16_t) );
+		}
+
+		m_ctx       = _ctx;
+		m_data      = data;
+		m_size      = size;
+		m_numFrames = numFrames;
+		m_frame     = 0;
+
+		return numFrames;
+	}
+
+	void FrameTraceReader::close()
+	{
+		if (NULL == m_data)
+		{
+			return;
+		}
+
+		destroyAll();
+
+		for (uint32_t type = 0; type < FrameTraceResource::Count; ++type)
+		{
+			BX_FREE(g_allocator, m_remap[type]);
+			BX_FREE(g_allocator, m_destroy[type]);
+			m_remap[type]   = NULL;
+			m_destroy[type] = NULL;
+		}
+
+		BX_FREE(g_allocator, m_frameOffset);
+		BX_FREE(g_allocator, m_data);
+
+		m_ctx         = NULL;
+		m_data        = NULL;
+		m_size        = 0;
+		m_resources   = 0;
+		m_frameOffset = NULL;
+		m_numFrames   = 0;
+		m_frame       = 0;
+	}
+
+	bool FrameTraceReader::replay()
+	{
+		if (NULL == m_data)
+		{
+			return false;
+		}
+
+		if (m_frame == m_numFrames)
+		{
+			destroyAll();
+			m_frame = 0;
+			return false;
+		}
+
+		BGFX_PROFILER_SCOPE("bgfx/Frame trace replay", 0xff2040ff);
+
+		if (0 == m_frame
+		&&  0 != m_resources)
+		{
+			uint32_t size;
+			bx::memCopy(&size, &m_data[m_resources+sizeof(uint32_t)], sizeof(size) );
+
+			bx::MemoryReader reader(&m_data[m_resources+2*sizeof(uint32_t)], size);
+			decodeCommands(&reader, m_ctx->m_submit->m_cmdPre);
+		}
+
+		const uint32_t offset = m_frameOffset[m_frame];
+
+		uint32_t size;
+		bx::memCopy(&size, &m_data[offset+sizeof(uint32_t)], sizeof(size) );
+
+		bx::MemoryReader reader(&m_data[offset+2*sizeof(uint32_t)], size);
+		if (!replayFrame(&reader) )
+		{
+			BX_TRACE("Frame trace frame %d references resources not present in trace, skipped.", m_frame);
+		}
+
+		++m_frame;
+
+		return true;
+	}
+
+	bool FrameTraceReader::replayFrame(bx::MemoryReader* _reader)
+	{
+		Context* ctx   = m_ctx;
+		Frame*   frame = ctx->m_submit;
+
+		decodeCommands(_reader, frame->m_cmdPre);
+
+		bool ok = true;
+
+		// Traced primary transient buffers are replaced with transient buffers
+		// of submit frame for the duration of this frame.
+		IndexBufferHandle tibHandle;
+		bx::read(_reader, tibHandle);
+
+		uint32_t tibSize;
+		bx::read(_reader, tibSize);
+
+		uint16_t tibRemap = kInvalidHandle;
+		if (tibSize <= frame->m_transientIb->size)
+		{
+			bx::read(_reader, frame->m_transientIb->data, tibSize);
+			frame->m_iboffset = tibSize;
+		}
+		else
+		{
+			bx::skip(_reader, tibSize);
+			ok = false;
+		}
+
+		if (isValid(tibHandle) )
+		{
+			tibRemap = m_remap[FrameTraceResource::IndexBuffer][tibHandle.idx];
+			m_remap[FrameTraceResource::IndexBuffer][tibHandle.idx] = frame->m_transientIb->handle.idx;
+		}
+
+		VertexBufferHandle tvbHandle;
+		bx::read(_reader, tvbHandle);
+
+		uint32_t tvbSize;
+		bx::read(_reader, tvbSize);
+
+		uint16_t tvbRemap = kInvalidHandle;
+		if (tvbSize <= frame->m_transientVb->size)
+		{
+			bx::read(_reader, frame->m_transientVb->data, tvbSize);
+			frame->m_vboffset = tvbSize;
+		}
+		else
+		{
+			bx::skip(_reader, tvbSize);
+			ok = false;
+		}
+
+		if (isValid(tvbHandle) )
+		{
+			tvbRemap = m_remap[FrameTraceResource::VertexBuffer][tvbHandle.idx];
+			m_remap[FrameTraceResource::VertexBuffer][tvbHandle.idx] = frame->m_transientVb->handle.idx;
+		}
+
+		// View state is set on context, it's copied into frame at swap.
+		uint16_t numViews;
+		bx::read(_reader, numViews);
+		bx::read(_reader, ctx->m_view, numViews*sizeof(View) );
+
+		for (uint32_t ii = 0; ii < numViews; ++ii)
+		{
+			FrameBufferHandle& fbh = ctx->m_view[ii].m_fbh;
+			if (isValid(fbh)
+			&&  !remap(FrameTraceResource::FrameBuffer, fbh.idx) )
+			{
+				fbh.idx = kInvalidHandle;
+			}
+		}
+
+		bx::read(_reader, ctx->m_viewRemap, sizeof(ctx->m_viewRemap) );
+		bx::read(_reader, ctx->m_clearColor, sizeof(ctx->m_clearColor) );
+		ctx->m_colorPaletteDirty = 2;
+
+		// View uniforms are set through context, so that they are copied into
+		// frame with the rest of view state.
+		for (uint32_t ii = 0; ii < numViews; ++ii)
+		{
+			uint32_t size;
+			bx::read(_reader, size);
+
+			const uint8_t* data = (const uint8_t*)_reader->getDataPtr();
+			bx::skip(_reader, size);
+
+			ctx->clearViewUniforms(ViewId(ii) );
+
+			for (uint32_t pos = 0; pos < size;)
+			{
+				uint32_t opcode;
+				bx::memCopy(&opcode, &data[pos], sizeof(opcode) );
+				pos += sizeof(opcode);
+
+				UniformType::Enum type;
+				uint16_t loc;
+				uint16_t num;
+				uint16_t copy;
+				UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+				UniformHandle handle = { loc };
+				if (remap(FrameTraceResource::Uniform, handle.idx) )
+				{
+					ctx->setViewUniform(ViewId(ii), handle, &data[pos], num);
+				}
+
+				pos += g_uniformTypeSize[type]*num;
+			}
+		}
+
+		MatrixCache& matrixCache = frame->m_frameCache.m_matrixCache;
+
+		uint32_t numMatrices;
+		bx::read(_reader, numMatrices);
+
+		if (numMatrices <= matrixCache.m_max)
+		{
+			bx::read(_reader, matrixCache.m_cache, numMatrices*sizeof(Matrix4) );
+			matrixCache.m_num   = numMatrices;
+			matrixCache.m_stale = true;
+		}
+		else
+		{
+			bx::skip(_reader, numMatrices*sizeof(Matrix4) );
+			ok = false;
+		}
+
+		RectCache& rectCache = frame->m_frameCache.m_rectCache;
+		bx::read(_reader, rectCache.m_num);
+		bx::read(_reader, rectCache.m_cache, rectCache.m_num*sizeof(Rect) );
+
+		const uint32_t maxDrawCalls = g_caps.limits.maxDrawCalls;
+		const uint32_t maxEncoders  = g_caps.limits.maxEncoders;
+
+		uint32_t numBinds;
+		bx::read(_reader, numBinds);
+
+		if (numBinds < maxDrawCalls)
+		{
+			bx::read(_reader, frame->m_renderBind, numBinds*sizeof(RenderBind) );
+			frame->m_numRenderBinds = numBinds;
+
+			for (uint32_t ii = 0; ii < numBinds; ++ii)
+			{
+				ok &= remapBind(frame->m_renderBind[ii]);
+			}
+		}
+		else
+		{
+			bx::skip(_reader, numBinds*sizeof(RenderBind) );
+			ok = false;
+		}
+
+		uint16_t numRuns;
+		bx::read(_reader, numRuns);
+
+		uint32_t numItems = 0;
+		for (uint32_t run = 0; run < numRuns; ++run)
+		{
+			uint16_t idx;
+			bx::read(_reader, idx);
+
+			uint32_t num;
+			bx::read(_reader, num);
+
+			if (!ok
+			||  idx >= maxEncoders
+			||  numItems + num >= maxDrawCalls)
+			{
+				bx::skip(_reader, num*(sizeof(uint64_t)+sizeof(RenderItem)+sizeof(RenderItemCount) ) );
+
+				uint32_t size;
+				bx::read(_reader, size);
+				bx::skip(_reader, size);
+
+				ok = false;
+				continue;
+			}
+
+			SortRun& sortRun = frame->m_sortRun[idx];
+			sortRun.reset();
+			sortRun.reserve(num);
+
+			bx::read(_reader, sortRun.m_keys, num*sizeof(uint64_t) );
+			bx::read(_reader, &frame->m_renderItem[numItems], num*sizeof(RenderItem) );
+			bx::read(_reader, &frame->m_renderItemBind[numItems], num*sizeof(RenderItemCount) );
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				uint64_t& key = sortRun.m_keys[ii];
+
+				// Program 0 is used by items submitted with invalid program.
+				ProgramHandle program = SortKey::decodeProgram(key);
+				if (remap(FrameTraceResource::Program, program.idx) )
+				{
+					key = SortKey::remapProgram(key, program);
+				}
+				else
+				{
+					ok &= 0 == program.idx;
+				}
+
+				RenderItem& item = frame->m_renderItem[numItems+ii];
+				ok &= 0 != (key & kSortKeyDrawBit)
+					? remapDraw(item.draw)
+					: remapCompute(item.compute)
+					;
+
+				sortRun.m_values[ii] = RenderItemCount(numItems+ii);
+			}
+
+			numItems += num;
+
+			// Remapped programs change order of keys.
+			sortRun.m_num = num;
+			sortRun.sort(frame->m_sortKeys, frame->m_sortValues);
+
+			uint32_t size;
+			bx::read(_reader, size);
+
+			const uint8_t* data = (const uint8_t*)_reader->getDataPtr();
+			bx::skip(_reader, size);
+
+			UniformBuffer::update(&frame->m_uniformBuffer[idx], size, size);
+			UniformBuffer* uniformBuffer = frame->m_uniformBuffer[idx];
+			uniformBuffer->reset();
+
+			for (uint32_t pos = 0; pos < size;)
+			{
+				uint32_t opcode;
+				bx::memCopy(&opcode, &data[pos], sizeof(opcode) );
+				pos += sizeof(opcode);
+
+				if (UniformType::End == opcode)
+				{
+					uniformBuffer->write(opcode);
+					break;
+				}
+
+				UniformType::Enum type;
+				uint16_t loc;
+				uint16_t num;
+				uint16_t copy;
+				UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+				if (UniformType::Count > type)
+				{
+					ok &= remap(FrameTraceResource::Uniform, loc);
+					opcode = UniformBuffer::encodeOpcode(type, loc, num, copy);
+				}
+				else if (UniformBuffer::kBlockType == type)
+				{
+					ok &= remap(FrameTraceResource::UniformBlock, loc);
+					opcode = UniformBuffer::encodeOpcode(type, loc, num, copy);
+				}
+
+				const uint32_t dataSize = g_uniformTypeSize[type]*num;
+				uniformBuffer->write(opcode);
+				uniformBuffer->write(&data[pos], dataSize);
+				pos += dataSize;
+			}
+		}
+
+		uint16_t numBlitItems;
+		bx::read(_reader, numBlitItems);
+		bx::read(_reader, frame->m_blitKeys, numBlitItems*sizeof(uint32_t) );
+		bx::read(_reader, frame->m_blitItem, numBlitItems*sizeof(BlitItem) );
+		frame->m_numBlitItems = numBlitItems;
+
+		for (uint32_t ii = 0; ii < numBlitItems; ++ii)
+		{
+			BlitItem& blit = frame->m_blitItem[ii];
+			ok &= remap(FrameTraceResource::Texture, blit.m_src.idx);
+			ok &= remap(FrameTraceResource::Texture, blit.m_dst.idx);
+		}
+
+		if (isValid(tibHandle) )
+		{
+			m_remap[FrameTraceResource::IndexBuffer][tibHandle.idx] = tibRemap;
+		}
+
+		if (isValid(tvbHandle) )
+		{
+			m_remap[FrameTraceResource::VertexBuffer][tvbHandle.idx] = tvbRemap;
+		}
+
+		if (ok)
+		{
+			frame->m_numRenderItems = numItems;
+		}
+		else
+		{
+			frame->m_frameCache.reset();
+			frame->m_numRenderItems = 0;
+			frame->m_numRenderBinds = 0;
+			frame->m_numBlitItems   = 0;
+			frame->m_iboffset       = 0;
+			frame->m_vboffset       = 0;
+
+			for (uint32_t ii = 0; ii < maxEncoders; ++ii)
+			{
+				frame->m_sortRun[ii].reset();
+				frame->m_uniformBuffer[ii]->reset();
+				frame->m_uniformBuffer[ii]->finish();
+			}
+		}
+
+		decodeCommands(_reader, frame->m_cmdPost);
+
+		return ok;
+	}
+
+	void FrameTraceReader::decodeCommands(bx::MemoryReader* _reader, CommandBuffer& _cmdbuf)
+	{
+		for (;;)
+		{
+			uint8_t command;
+			bx::read(_reader, command);
+
+			switch (command)
+			{
+			case CommandBuffer::End:
+				return;
+
+			case CommandBuffer::CreateVertexLayout:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					VertexLayout layout;
+					bx::read(_reader, layout);
+
+					VertexLayoutHandle handle = { create(FrameTraceResource::VertexLayout, idx, CommandBuffer::DestroyVertexLayout) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(layout);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					const Memory* mem = readMemory(_reader);
+
+					uint16_t flags;
+					bx::read(_reader, flags);
+
+					IndexBufferHandle handle = { create(FrameTraceResource::IndexBuffer, idx, CommandBuffer::DestroyIndexBuffer) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(mem);
+						_cmdbuf.write(flags);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					const Memory* mem = readMemory(_reader);
+
+					VertexLayoutHandle layoutHandle;
+					bx::read(_reader, layoutHandle);
+
+					uint16_t flags;
+					bx::read(_reader, flags);
+
+					if (isValid(layoutHandle)
+					&&  !remap(FrameTraceResource::VertexLayout, layoutHandle.idx) )
+					{
+						layoutHandle.idx = kInvalidHandle;
+					}
+
+					VertexBufferHandle handle = { create(FrameTraceResource::VertexBuffer, idx, CommandBuffer::DestroyVertexBuffer) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(mem);
+						_cmdbuf.write(layoutHandle);
+						_cmdbuf.write(flags);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					uint32_t size;
+					bx::read(_reader, size);
+
+					uint16_t flags;
+					bx::read(_reader, flags);
+
+					const uint16_t handle = CommandBuffer::CreateDynamicIndexBuffer == command
+						? create(FrameTraceResource::IndexBuffer,  idx, CommandBuffer::DestroyDynamicIndexBuffer)
+						: create(FrameTraceResource::VertexBuffer, idx, CommandBuffer::DestroyDynamicVertexBuffer)
+						;
+					if (kInvalidHandle != handle)
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(size);
+						_cmdbuf.write(flags);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					uint16_t handle;
+					bx::read(_reader, handle);
+
+					uint32_t offset;
+					bx::read(_reader, offset);
+
+					uint32_t size;
+					bx::read(_reader, size);
+
+					const Memory* mem = readMemory(_reader);
+
+					const FrameTraceResource::Enum type = CommandBuffer::UpdateDynamicIndexBuffer == command
+						? FrameTraceResource::IndexBuffer
+						: FrameTraceResource::VertexBuffer
+						;
+					if (remap(type, handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(offset);
+						_cmdbuf.write(size);
+						_cmdbuf.write(mem);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					const Memory* mem = readMemory(_reader);
+
+					ShaderHandle handle = { create(FrameTraceResource::Shader, idx, CommandBuffer::DestroyShader) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(mem);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					ShaderHandle vsh;
+					bx::read(_reader, vsh);
+
+					ShaderHandle fsh;
+					bx::read(_reader, fsh);
+
+					if (!remap(FrameTraceResource::Shader, vsh.idx) )
+					{
+						break;
+					}
+
+					if (isValid(fsh)
+					&&  !remap(FrameTraceResource::Shader, fsh.idx) )
+					{
+						break;
+					}
+
+					ProgramHandle handle = { create(FrameTraceResource::Program, idx, CommandBuffer::DestroyProgram) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(vsh);
+						_cmdbuf.write(fsh);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					const Memory* mem = readMemory(_reader);
+
+					if (isTextureCreate(mem) )
+					{
+						uint8_t hasMem;
+						bx::read(_reader, hasMem);
+
+						TextureCreate tc;
+						bx::memCopy(&tc, &mem->data[sizeof(uint32_t)], sizeof(tc) );
+						tc.m_mem = 0 != hasMem ? readMemory(_reader) : NULL;
+						bx::memCopy(&mem->data[sizeof(uint32_t)], &tc, sizeof(tc) );
+					}
+
+					uint64_t flags;
+					bx::read(_reader, flags);
+
+					uint8_t skip;
+					bx::read(_reader, skip);
+
+					TextureHandle handle = { create(FrameTraceResource::Texture, idx, CommandBuffer::DestroyTexture) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(mem);
+						_cmdbuf.write(flags);
+						_cmdbuf.write(skip);
+					}
+					else
+					{
+						if (isTextureCreate(mem) )
+						{
+							TextureCreate tc;
+							bx::memCopy(&tc, &mem->data[sizeof(uint32_t)], sizeof(tc) );
+
+							if (NULL != tc.m_mem)
+							{
+								release(tc.m_mem);
+							}
+						}
+
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle);
+
+					uint8_t side;
+					bx::read(_reader, side);
+
+					uint8_t mip;
+					bx::read(_reader, mip);
+
+					uint8_t format;
+					bx::read(_reader, format);
+
+					Rect rect;
+					bx::read(_reader, rect);
+
+					uint16_t zz;
+					bx::read(_reader, zz);
+
+					uint16_t depth;
+					bx::read(_reader, depth);
+
+					uint16_t pitch;
+					bx::read(_reader, pitch);
+
+					const Memory* mem = readMemory(_reader);
+
+					if (remap(FrameTraceResource::Texture, handle.idx) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(side);
+						_cmdbuf.write(mip);
+						_cmdbuf.write(format);
+						_cmdbuf.write(rect);
+						_cmdbuf.write(zz);
+						_cmdbuf.write(depth);
+						_cmdbuf.write(pitch);
+						_cmdbuf.write(mem);
+					}
+					else
+					{
+						release(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle);
+
+					uint16_t width;
+					bx::read(_reader, width);
+
+					uint16_t height;
+					bx::read(_reader, height);
+
+					uint8_t numMips;
+					bx::read(_reader, numMips);
+
+					uint16_t numLayers;
+					bx::read(_reader, numLayers);
+
+					if (remap(FrameTraceResource::Texture, handle.idx) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(width);
+						_cmdbuf.write(height);
+						_cmdbuf.write(numMips);
+						_cmdbuf.write(numLayers);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					uint8_t num;
+					bx::read(_reader, num);
+
+					Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+					bx::read(_reader, attachment, sizeof(Attachment) * num);
+
+					bool ok = true;
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						ok &= remap(FrameTraceResource::Texture, attachment[ii].handle.idx);
+					}
+
+					if (!ok)
+					{
+						break;
+					}
+
+					FrameBufferHandle handle = { create(FrameTraceResource::FrameBuffer, idx, CommandBuffer::DestroyFrameBuffer) };
+					if (isValid(handle) )
+					{
+						const bool window = false;
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(window);
+						_cmdbuf.write(num);
+						_cmdbuf.write(attachment, sizeof(Attachment) * num);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					UniformType::Enum type;
+					bx::read(_reader, type);
+
+					uint16_t num;
+					bx::read(_reader, num);
+
+					uint8_t len;
+					bx::read(_reader, len);
+
+					const void* name = _reader->getDataPtr();
+					bx::skip(_reader, len);
+
+					UniformHandle handle = { create(FrameTraceResource::Uniform, idx, CommandBuffer::DestroyUniform) };
+					if (isValid(handle) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(type);
+						_cmdbuf.write(num);
+						_cmdbuf.write(len);
+						_cmdbuf.write(name, len);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateUniformBlock:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					uint16_t num;
+					bx::read(_reader, num);
+
+					UniformBlock::Entry entry[BGFX_CONFIG_MAX_UNIFORM_BLOCK_UNIFORMS];
+					bx::read(_reader, entry, sizeof(UniformBlock::Entry)*num);
+
+					bool ok = true;
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						ok &= remap(FrameTraceResource::Uniform, entry[ii].m_handle.idx);
+					}
+
+					UniformBlockHandle handle = { create(FrameTraceResource::UniformBlock, idx, CommandBuffer::DestroyUniformBlock) };
+					if (isValid(handle) )
+					{
+						if (!ok)
+						{
+							num = 0;
+						}
+
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(num);
+						_cmdbuf.write(entry, sizeof(UniformBlock::Entry)*num);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					ViewId id;
+					bx::read(_reader, id);
+
+					uint16_t len;
+					bx::read(_reader, len);
+
+					const void* name = _reader->getDataPtr();
+					bx::skip(_reader, len);
+
+					_cmdbuf.write(command);
+					_cmdbuf.write(id);
+					_cmdbuf.write(len);
+					_cmdbuf.write(name, len);
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					Handle handle;
+					bx::read(_reader, handle);
+
+					uint16_t len;
+					bx::read(_reader, len);
+
+					const void* name = _reader->getDataPtr();
+					bx::skip(_reader, len);
+
+					const FrameTraceResource::Enum type = getNameResource(handle.type);
+					if (FrameTraceResource::Count != type
+					&&  remap(type, handle.idx) )
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+						_cmdbuf.write(len);
+						_cmdbuf.write(name, len);
+					}
+				}
+				break;
+
+			default:
+				{
+					const FrameTraceResource::Enum type = getDestroyResource(command);
+					if (FrameTraceResource::Count == type)
+					{
+						BX_CHECK(false, "Invalid frame trace command: %d", command);
+						return;
+					}
+
+					uint16_t idx;
+					bx::read(_reader, idx);
+
+					const uint16_t handle = destroy(type, idx);
+					if (kInvalidHandle != handle)
+					{
+						_cmdbuf.write(command);
+						_cmdbuf.write(handle);
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	uint16_t FrameTraceReader::create(FrameTraceResource::Enum _type, uint16_t _idx, uint8_t _destroy)
+	{
+		if (_idx >= s_maxResources[_type])
+		{
+			return kInvalidHandle;
+		}
+
+		// Resource can be created again with the same handle (uniform resize,
+		// or async texture), previous replayed handle is reused then.
+		uint16_t& remap = m_remap[_type][_idx];
+		if (kInvalidHandle == remap)
+		{
+			remap = allocHandle(m_ctx, _type);
+			BX_WARN(kInvalidHandle != remap, "Failed to allocate handle for replayed resource.");
+		}
+
+		m_destroy[_type][_idx] = _destroy;
+
+		return remap;
+	}
+
+	uint16_t FrameTraceReader::destroy(FrameTraceResource::Enum _type, uint16_t _idx)
+	{
+		if (_idx >= s_maxResources[_type])
+		{
+			return kInvalidHandle;
+		}
+
+		uint16_t& remap = m_remap[_type][_idx];
+		const uint16_t handle = remap;
+
+		if (kInvalidHandle != handle)
+		{
+			freeHandle(m_ctx, _type, handle);
+			remap = kInvalidHandle;
+		}
+
+		return handle;
+	}
+
+	bool FrameTraceReader::remap(FrameTraceResource::Enum _type, uint16_t& _idx) const
+	{
+		if (_idx >= s_maxResources[_type])
+		{
+			return false;
+		}
+
+		const uint16_t idx = m_remap[_type][_idx];
+		if (kInvalidHandle == idx)
+		{
+			return false;
+		}
+
+		_idx = idx;
+		return true;
+	}
+
+	bool FrameTraceReader::remapDraw(RenderDraw& _draw) const
+	{
+		bool ok = true;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
+		{
+			if (0 == (_draw.m_streamMask & (1<<ii) ) )
+			{
+				continue;
+			}
+
+			Stream& stream = _draw.m_stream[ii];
+			ok &= remap(FrameTraceResource::VertexBuffer, stream.m_handle.idx);
+
+			if (isValid(stream.m_layoutHandle) )
+			{
+				ok &= remap(FrameTraceResource::VertexLayout, stream.m_layoutHandle.idx);
+			}
+		}
+
+		if (isValid(_draw.m_indexBuffer) )
+		{
+			ok &= remap(FrameTraceResource::IndexBuffer, _draw.m_indexBuffer.idx);
+		}
+
+		if (isValid(_draw.m_instanceDataBuffer) )
+		{
+			ok &= remap(FrameTraceResource::VertexBuffer, _draw.m_instanceDataBuffer.idx);
+		}
+
+		if (isValid(_draw.m_indirectBuffer) )
+		{
+			ok &= remap(FrameTraceResource::VertexBuffer, _draw.m_indirectBuffer.idx);
+		}
+
+		// Occlusion queries are not replayed, conditional draws are always
+		// rendered.
+		_draw.m_occlusionQuery.idx = kInvalidHandle;
+		_draw.m_submitFlags &= ~BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE;
+
+		return ok;
+	}
+
+	bool FrameTraceReader::remapCompute(RenderCompute& _compute) const
+	{
+		if (isValid(_compute.m_indirectBuffer) )
+		{
+			return remap(FrameTraceResource::VertexBuffer, _compute.m_indirectBuffer.idx);
+		}
+
+		return true;
+	}
+
+	bool FrameTraceReader::remapBind(RenderBind& _bind) const
+	{
+		bool ok = true;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		{
+			Binding& bind = _bind.m_bind[ii];
+			if (kInvalidHandle == bind.m_idx)
+			{
+				continue;
+			}
+
+			switch (bind.m_type)
+			{
+			case Binding::Image:
+			case Binding::Texture:
+				ok &= remap(FrameTraceResource::Texture, bind.m_idx);
+				break;
+
+			case Binding::IndexBuffer:
+				ok &= remap(FrameTraceResource::IndexBuffer, bind.m_idx);
+				break;
+
+			case Binding::VertexBuffer:
+				ok &= remap(FrameTraceResource::VertexBuffer, bind.m_idx);
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		return ok;
+	}
+
+	void FrameTraceReader::destroyAll()
+	{
+		CommandBuffer& cmdbuf = m_ctx->m_submit->m_cmdPost;
+
+		for (uint32_t type = FrameTraceResource::Count; 0 < type; --type)
+		{
+			const FrameTraceResource::Enum resource = FrameTraceResource::Enum(type-1);
+
+			for (uint32_t ii = 0, num = s_maxResources[resource]; ii < num; ++ii)
+			{
+				const uint16_t handle = destroy(resource, uint16_t(ii) );
+				if (kInvalidHandle != handle)
+				{
+					cmdbuf.write(m_destroy[resource][ii]);
+					cmdbuf.write(handle);
+				}
+			}
+		}
+	}
+
+} // namespace bgfx
@@ -5377,7 +5377,7 @@ namespace bgfx { namespace d3d11
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->getRenderBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -5385,6 +5385,8 @@ namespace bgfx { namespace d3d11
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
+					rendererUpdateUniforms(this, _render->m_viewUniformBuffer, _render->m_view[view].m_uniformBegin, _render->m_view[view].m_uniformEnd);
+
 					if (item > 1)
 					{
 						profiler.end();
@@ -5450,8 +5452,7 @@ namespace bgfx { namespace d3d11
 					const RenderCompute& compute = renderItem.compute;
 
 					bool programChanged = false;
-					bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd;
-					rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
 
 					if (key.m_program.idx != currentProgram.idx)
 					{
@@ -5740,8 +5741,7 @@ namespace bgfx { namespace d3d11
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -1082,8 +1082,8 @@ namespace bgfx { namespace d3d12
 
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 				{
-					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
-						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+					m_scratchBuffer[ii].create(g_caps.limits.maxDrawCalls*1024
+						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + g_caps.limits.maxDrawCalls
 						);
 				}
 				m_samplerAllocator.create(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
@@ -5875,7 +5875,7 @@ namespace bgfx { namespace d3d12
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->getRenderBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -5891,6 +5891,8 @@ namespace bgfx { namespace d3d12
 					currentProgram         = BGFX_INVALID_HANDLE;
 					hasPredefined          = false;
 
+					rendererUpdateUniforms(this, _render->m_viewUniformBuffer, _render->m_view[view].m_uniformBegin, _render->m_view[view].m_uniformEnd);
+
 					if (item > 1)
 					{
 						profiler.end();
@@ -6092,12 +6094,10 @@ namespace bgfx { namespace d3d12
 						}
 					}
 
-					bool constantsChanged = false;
-					if (compute.m_uniformBegin < compute.m_uniformEnd
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+					if (constantsChanged
 					||  currentProgram.idx != key.m_program.idx)
 					{
-						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
-
 						currentProgram = key.m_program;
 						ProgramD3D12& program = m_program[currentProgram.idx];
 
@@ -6236,8 +6236,7 @@ namespace bgfx { namespace d3d12
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
 
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (0 != draw.m_streamMask)
 				{
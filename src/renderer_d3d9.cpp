@@ -3820,7 +3820,7 @@ namespace bgfx { namespace d3d9
 
 				const uint32_t itemIdx = _render->m_sortValues[item];
 				const RenderDraw& draw = _render->m_renderItem[itemIdx].draw;
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->getRenderBind(itemIdx);
 
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
@@ -3857,6 +3857,8 @@ namespace bgfx { namespace d3d9
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
+					rendererUpdateUniforms(this, _render->m_viewUniformBuffer, _render->m_view[view].m_uniformBegin, _render->m_view[view].m_uniformEnd);
+
 					if (item > 0)
 					{
 						profiler.end();
@@ -4129,8 +4131,7 @@ namespace bgfx { namespace d3d9
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
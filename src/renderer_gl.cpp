@@ -3820,6 +3820,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				float mrtClearDepth[4] = { g_caps.homogeneousDepth ? (_clear.m_depth * 2.0f - 1.0f) : _clear.m_depth };
 				updateUniform(m_clearQuadDepth.idx, mrtClearDepth, sizeof(float)*4);
+				rendererInvalidateUniform(m_clearQuadDepth);
 
 				float mrtClearColor[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS][4];
 
@@ -3848,6 +3849,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				}
 
 				updateUniform(m_clearQuadColor.idx, mrtClearColor[0], numMrt * sizeof(float) * 4);
+				rendererInvalidateUniform(m_clearQuadColor);
 
 				commit(*program.m_constantBuffer);
 
@@ -6457,6 +6459,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		RenderBind currentBind;
 		currentBind.clear();
+		uint32_t currentBindIdx = UINT32_MAX;
 
 		static ViewState viewState;
 		viewState.reset(_render);
@@ -6536,7 +6539,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->getRenderBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -6544,6 +6547,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
+					rendererUpdateUniforms(this, _render->m_viewUniformBuffer, _render->m_view[view].m_uniformBegin, _render->m_view[view].m_uniformEnd);
+
 					if (item > 1)
 					{
 						profiler.end();
@@ -6661,7 +6666,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 						if (0 != barrier)
 						{
-							bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd;
+							// Program is bound for every dispatch, so view uniforms
+							// must be committed too.
+							bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd
+								|| _render->m_view[view].m_uniformBegin < _render->m_view[view].m_uniformEnd
+								;
 							rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
 
 							if (constantsChanged
@@ -6741,6 +6750,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							currentState.clear();
 							currentState.m_scissor = !draw.m_scissor;
 							currentBind.clear();
+							currentBindIdx = UINT32_MAX;
 						}
 
 						continue;
@@ -6765,6 +6775,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					currentState.m_stencil    = newStencil;
 
 					currentBind.clear();
+					currentBindIdx = UINT32_MAX;
 				}
 
 				uint16_t scissor = draw.m_scissor;
@@ -7085,9 +7096,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 				bool bindAttribs = false;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -7115,7 +7125,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 					viewState.setPredefined<1>(this, view, program, _render, draw);
 
+					// Items sharing bind table entry have identical bindings.
+					const uint32_t bindIdx = _render->m_renderItemBind[itemIdx];
+					if (bindIdx != currentBindIdx
+					||  programChanged)
 					{
+						currentBindIdx = bindIdx;
+
 						for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 						{
 							const Binding& bind = renderBind.m_bind[stage];
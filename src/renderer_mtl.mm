@@ -3755,7 +3755,7 @@ namespace bgfx { namespace mtl
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->getRenderBind(itemIdx);
 				++item;
 
 				if (viewChanged
@@ -3764,6 +3764,8 @@ namespace bgfx { namespace mtl
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
+					rendererUpdateUniforms(this, _render->m_viewUniformBuffer, _render->m_view[view].m_uniformBegin, _render->m_view[view].m_uniformEnd);
+
 					if (item > 1)
 					{
 						profiler.end();
@@ -243,6 +243,10 @@ namespace bgfx { namespace noop
 			const int64_t timerFreq = bx::getHPFrequency();
 			const int64_t timeBegin = bx::getHPCounter();
 
+			// Nothing is rendered, but frame is still sorted so that sort and
+			// merge stats match other renderers.
+			_render->sort();
+
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
 			perfStats.cpuTimeEnd    = timeBegin;
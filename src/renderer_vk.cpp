@@ -2117,7 +2117,7 @@ VK_IMPORT_DEVICE
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 			{
 				BX_TRACE("Create scratch buffer %d", ii);
-				m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS * 128, 1024);
+				m_scratchBuffer[ii].create(g_caps.limits.maxDrawCalls * 128, 1024);
 			}
 
 			errorState = ErrorState::DescriptorCreated;
@@ -2423,6 +2423,11 @@ VK_IMPORT_DEVICE
 			m_textures[_handle.idx].update(m_commandPool, _side, _mip, _rect, _z, _depth, _pitch, _mem);
 		}
 
+		void updateTextureRegions(TextureHandle _handle, uint8_t _side, uint8_t _mip, const TextureUpdateRegion* _region, uint32_t _num, const Memory* _mem) override
+		{
+			m_textures[_handle.idx].update(_side, _mip, _region, _num, _mem);
+		}
+
 		void updateTextureEnd() override
 		{
 		}
@@ -5422,18 +5427,37 @@ VK_DESTROY
 	{
 		BX_UNUSED(_commandPool);
 
+		TextureUpdateRegion region;
+		region.m_rect   = _rect;
+		region.m_z      = _z;
+		region.m_depth  = _depth;
+		region.m_pitch  = _pitch;
+		region.m_offset = 0;
+		region.m_size   = (_pitch == UINT16_MAX ? _mem->size : _rect.m_height * _pitch * _depth);
+
+		update(_side, _mip, &region, 1, _mem);
+	}
+
+	void TextureVK::update(uint8_t _side, uint8_t _mip, const TextureUpdateRegion* _region, uint32_t _num, const Memory* _mem)
+	{
 		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
 		VkDevice device = s_renderVK->m_device;
 
 		VkBuffer stagingBuffer = VK_NULL_HANDLE;
 		VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
 
+		uint32_t size = 0;
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			size = bx::max(size, _region[ii].m_offset + _region[ii].m_size);
+		}
+
 		// staging buffer creation
 		VkBufferCreateInfo bci;
 		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 		bci.pNext = NULL;
 		bci.flags = 0;
-		bci.size = (_pitch == UINT16_MAX ? _mem->size :_rect.m_height * _pitch * _depth);
+		bci.size = size;
 		bci.queueFamilyIndexCount = 0;
 		bci.pQueueFamilyIndices = NULL;
 		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -5473,19 +5497,29 @@ VK_DESTROY
 		bx::memCopy(directAccessPtr, _mem->data, size_t(bci.size));
 		vkUnmapMemory(device, stagingDeviceMem);
 
-		const uint32_t bpp    = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
-		VkBufferImageCopy region;
-		region.bufferOffset      = 0;
-		region.bufferRowLength   = (_pitch == UINT16_MAX ? 0 : _pitch * 8 / bpp);
-		region.bufferImageHeight = 0;
-		region.imageSubresource.aspectMask     = m_vkTextureAspect;
-		region.imageSubresource.mipLevel       = _mip;
-		region.imageSubresource.baseArrayLayer = _side;
-		region.imageSubresource.layerCount     = 1;
-		region.imageOffset = { _rect.m_x, _rect.m_y, _z };
-		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
+		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
 
-		copyBufferToTexture(stagingBuffer, 1, &region);
+		VkBufferImageCopy* bufferCopyInfo = (VkBufferImageCopy*)BX_ALLOC(g_allocator, sizeof(VkBufferImageCopy) * _num);
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const TextureUpdateRegion& region = _region[ii];
+
+			VkBufferImageCopy& copy = bufferCopyInfo[ii];
+			copy.bufferOffset      = region.m_offset;
+			copy.bufferRowLength   = (region.m_pitch == UINT16_MAX ? 0 : region.m_pitch * 8 / bpp);
+			copy.bufferImageHeight = 0;
+			copy.imageSubresource.aspectMask     = m_vkTextureAspect;
+			copy.imageSubresource.mipLevel       = _mip;
+			copy.imageSubresource.baseArrayLayer = _side;
+			copy.imageSubresource.layerCount     = 1;
+			copy.imageOffset = { region.m_rect.m_x, region.m_rect.m_y, region.m_z };
+			copy.imageExtent = { region.m_rect.m_width, region.m_rect.m_height, region.m_depth };
+		}
+
+		copyBufferToTexture(stagingBuffer, _num, bufferCopyInfo);
+
+		BX_FREE(g_allocator, bufferCopyInfo);
 
 		vkFreeMemory(device, stagingDeviceMem, allocatorCb);
 		vkDestroy(stagingBuffer);
@@ -5814,7 +5848,7 @@ VK_DESTROY
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->getRenderBind(itemIdx);
 				++item;
 
 				if (viewChanged || isCompute || wasCompute)
@@ -5844,6 +5878,11 @@ VK_DESTROY
 					currentProgram         = BGFX_INVALID_HANDLE;
 					hasPredefined          = false;
 
+					if (viewChanged)
+					{
+						rendererUpdateUniforms(this, _render->m_viewUniformBuffer, _render->m_view[view].m_uniformBegin, _render->m_view[view].m_uniformEnd);
+					}
+
 					VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
 					fbh = _render->m_view[view].m_fbh;
 					setFrameBuffer(fbh);
@@ -5936,12 +5975,10 @@ VK_DESTROY
 						currentDslHash = 0;
 					}
 
-					bool constantsChanged = false;
-					if (compute.m_uniformBegin < compute.m_uniformEnd
+					bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+					if (constantsChanged
 					||  currentProgram.idx != key.m_program.idx)
 					{
-						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
-
 						currentProgram = key.m_program;
 						ProgramVK& program = m_program[currentProgram.idx];
 
@@ -6106,7 +6143,7 @@ VK_DESTROY
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				const bool uniformsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (0 != draw.m_streamMask)
 				{
@@ -6230,7 +6267,7 @@ VK_DESTROY
 					}
 
 					bool constantsChanged = false;
-					if (draw.m_uniformBegin < draw.m_uniformEnd
+					if (uniformsChanged
 					||  currentProgram.idx != key.m_program.idx
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
@@ -0,0 +1,762 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bgfx/bgfx.h>
+
+#include <bx/commandline.h>
+#include <bx/math.h>
+#include <bx/readerwriter.h>
+#include <bx/rng.h>
+#include <bx/semaphore.h>
+#include <bx/sort.h>
+#include <bx/string.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+
+#define BGFX_BENCH_VERSION_MAJOR 1
+#define BGFX_BENCH_VERSION_MINOR 0
+
+static const uint32_t kMaxIterations = 1024;
+static const uint32_t kMaxEncoders   = 8;
+static const uint16_t kNumPrograms   = 32;
+static const uint16_t kNumViews      = 16;
+static const uint16_t kMaxUniforms   = 16;
+static const uint32_t kMaxVertices   = 1024;
+static const uint32_t kMaxBuffers    = 512;
+
+static float s_vertexData[kMaxVertices*3];
+static uint16_t s_indexData[96];
+
+static double toMs(int64_t _ticks)
+{
+	return double(_ticks)*1000.0/double(bx::getHPFrequency() );
+}
+
+struct Samples
+{
+	Samples()
+		: m_num(0)
+	{
+	}
+
+	void add(int64_t _ticks)
+	{
+		if (m_num < kMaxIterations)
+		{
+			m_value[m_num++] = toMs(_ticks);
+		}
+	}
+
+	double   m_value[kMaxIterations];
+	uint32_t m_num;
+};
+
+static int32_t compareDouble(const void* _lhs, const void* _rhs)
+{
+	const double lhs = *(const double*)_lhs;
+	const double rhs = *(const double*)_rhs;
+	return lhs < rhs ? -1 : lhs > rhs ? 1 : 0;
+}
+
+/// Writes benchmark results as JSON document:
+///
+///   { "bench": { ... }, "results": [ { "name": ..., <params>, <samples> }, ... ] }
+///
+/// Every sample set is written as `{ "min", "median", "avg", "max" }` in
+/// milliseconds.
+struct Report
+{
+	Report(FILE* _out)
+		: m_out(_out)
+		, m_numResults(0)
+	{
+	}
+
+	void begin(bgfx::RendererType::Enum _type, bool _multithreaded, uint32_t _iterations)
+	{
+		fprintf(m_out
+			, "{\n"
+			  "\t\"bench\": { \"version\": \"%d.%d.%d\", \"renderer\": \"%s\", \"multithreaded\": %s, \"iterations\": %d },\n"
+			  "\t\"results\": ["
+			, BGFX_BENCH_VERSION_MAJOR
+			, BGFX_BENCH_VERSION_MINOR
+			, BGFX_API_VERSION
+			, bgfx::getRendererName(_type)
+			, _multithreaded ? "true" : "false"
+			, _iterations
+			);
+	}
+
+	void end()
+	{
+		fprintf(m_out, "\n\t]\n}\n");
+		fflush(m_out);
+	}
+
+	void beginResult(const char* _name)
+	{
+		fprintf(m_out, "%s\n\t\t{ \"name\": \"%s\"", 0 == m_numResults ? "" : ",", _name);
+		++m_numResults;
+	}
+
+	void endResult()
+	{
+		fprintf(m_out, " }");
+	}
+
+	void value(const char* _key, uint32_t _value)
+	{
+		fprintf(m_out, ", \"%s\": %d", _key, _value);
+	}
+
+	void value(const char* _key, double _value)
+	{
+		fprintf(m_out, ", \"%s\": %.6f", _key, _value);
+	}
+
+	void samples(const char* _key, Samples& _samples)
+	{
+		if (0 == _samples.m_num)
+		{
+			fprintf(m_out, ", \"%s\": null", _key);
+			return;
+		}
+
+		bx::quickSort(_samples.m_value, _samples.m_num, sizeof(double), compareDouble);
+
+		double sum = 0.0;
+		for (uint32_t ii = 0; ii < _samples.m_num; ++ii)
+		{
+			sum += _samples.m_value[ii];
+		}
+
+		fprintf(m_out
+			, ", \"%s\": { \"min\": %.6f, \"median\": %.6f, \"avg\": %.6f, \"max\": %.6f }"
+			, _key
+			, _samples.m_value[0]
+			, _samples.m_value[_samples.m_num/2]
+			, sum/double(_samples.m_num)
+			, _samples.m_value[_samples.m_num-1]
+			);
+	}
+
+	FILE*    m_out;
+	uint32_t m_numResults;
+};
+
+static const bgfx::Memory* createShaderBinary(char _type, uint32_t _hashIn, uint32_t _hashOut)
+{
+	// Minimal shader binary accepted by bgfx::createShader. Noop renderer never
+	// looks at shader code, and shader doesn't declare any uniforms.
+	const bgfx::Memory* mem = bgfx::alloc(4+4+4+2+4+1+1+2);
+
+	bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+	bx::write(&writer, uint32_t(BX_MAKEFOURCC(_type, 'S', 'H', 6) ) );
+	bx::write(&writer, _hashIn);
+	bx::write(&writer, _hashOut);
+	bx::write(&writer, uint16_t(0) ); // Number of uniforms.
+	bx::write(&writer, uint32_t(0) ); // Shader code size.
+	bx::write(&writer, uint8_t(0) );  // Shader code terminator.
+	bx::write(&writer, uint8_t(0) );  // Number of attributes.
+	bx::write(&writer, uint16_t(0) ); // Constant buffer size.
+
+	return mem;
+}
+
+struct Scene
+{
+	void init()
+	{
+		m_layout
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.end();
+
+		m_vbh = bgfx::createVertexBuffer(bgfx::makeRef(s_vertexData, 64*m_layout.getStride() ), m_layout);
+		m_ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_indexData, sizeof(s_indexData) ) );
+
+		// Vertex shaders differ only by input hash, so each program gets its own
+		// shader, and sort keys are spread across all programs.
+		m_fsh = bgfx::createShader(createShaderBinary('F', 0xbe7c, 0) );
+
+		for (uint16_t ii = 0; ii < kNumPrograms; ++ii)
+		{
+			m_vsh[ii]     = bgfx::createShader(createShaderBinary('V', ii, 0xbe7c) );
+			m_program[ii] = bgfx::createProgram(m_vsh[ii], m_fsh);
+		}
+
+		for (uint16_t ii = 0; ii < kMaxUniforms; ++ii)
+		{
+			char name[32];
+			bx::snprintf(name, BX_COUNTOF(name), "u_bench%d", ii);
+			m_uniform[ii] = bgfx::createUniform(name, bgfx::UniformType::Vec4);
+		}
+	}
+
+	void shutdown()
+	{
+		for (uint16_t ii = 0; ii < kMaxUniforms; ++ii)
+		{
+			bgfx::destroy(m_uniform[ii]);
+		}
+
+		for (uint16_t ii = 0; ii < kNumPrograms; ++ii)
+		{
+			bgfx::destroy(m_program[ii]);
+			bgfx::destroy(m_vsh[ii]);
+		}
+
+		bgfx::destroy(m_fsh);
+		bgfx::destroy(m_ibh);
+		bgfx::destroy(m_vbh);
+	}
+
+	void submit(bgfx::Encoder* _encoder, uint32_t _begin, uint32_t _end, uint16_t _numUniforms) const
+	{
+		bx::RngMwc rng(_begin+1);
+
+		float mtx[16];
+		bx::mtxIdentity(mtx);
+
+		const float value[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const uint32_t rnd = rng.gen();
+
+			mtx[12] = float(ii);
+			_encoder->setTransform(mtx);
+
+			for (uint16_t uu = 0; uu < _numUniforms; ++uu)
+			{
+				_encoder->setUniform(m_uniform[uu], value);
+			}
+
+			_encoder->setVertexBuffer(0, m_vbh);
+			_encoder->setIndexBuffer(m_ibh);
+			_encoder->setState(BGFX_STATE_DEFAULT);
+			_encoder->submit(
+				  bgfx::ViewId(rnd%kNumViews)
+				, m_program[(rnd>>8)%kNumPrograms]
+				, rnd>>16
+				);
+		}
+	}
+
+	bgfx::VertexLayout       m_layout;
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle  m_ibh;
+	bgfx::ShaderHandle       m_fsh;
+	bgfx::ShaderHandle       m_vsh[kNumPrograms];
+	bgfx::ProgramHandle      m_program[kNumPrograms];
+	bgfx::UniformHandle      m_uniform[kMaxUniforms];
+};
+
+struct Worker
+{
+	Worker()
+		: m_scene(NULL)
+		, m_done(NULL)
+		, m_begin(0)
+		, m_end(0)
+		, m_numUniforms(0)
+		, m_quit(false)
+	{
+	}
+
+	void init(const Scene* _scene, bx::Semaphore* _done)
+	{
+		m_scene = _scene;
+		m_done  = _done;
+		m_thread.init(threadFunc, this, 0, "bgfx-bench - encoder thread");
+	}
+
+	void shutdown()
+	{
+		m_quit = true;
+		m_start.post();
+		m_thread.shutdown();
+	}
+
+	void kick(uint32_t _begin, uint32_t _end, uint16_t _numUniforms)
+	{
+		m_begin       = _begin;
+		m_end         = _end;
+		m_numUniforms = _numUniforms;
+		m_start.post();
+	}
+
+	static int32_t threadFunc(bx::Thread* /*_self*/, void* _userData)
+	{
+		Worker* worker = (Worker*)_userData;
+
+		for (;;)
+		{
+			worker->m_start.wait();
+
+			if (worker->m_quit)
+			{
+				break;
+			}
+
+			bgfx::Encoder* encoder = bgfx::begin(true);
+			if (NULL != encoder)
+			{
+				worker->m_scene->submit(encoder, worker->m_begin, worker->m_end, worker->m_numUniforms);
+				bgfx::end(encoder);
+			}
+
+			worker->m_done->post();
+		}
+
+		return 0;
+	}
+
+	bx::Thread     m_thread;
+	bx::Semaphore  m_start;
+	const Scene*   m_scene;
+	bx::Semaphore* m_done;
+	uint32_t       m_begin;
+	uint32_t       m_end;
+	uint16_t       m_numUniforms;
+	volatile bool  m_quit;
+};
+
+struct Bench
+{
+	Bench(Report& _report, uint32_t _iterations)
+		: m_report(_report)
+		, m_iterations(_iterations)
+		, m_warmup(bx::max<uint32_t>(_iterations/10, 2) )
+	{
+	}
+
+	void init()
+	{
+		m_scene.init();
+
+		m_numEncoders = bx::min<uint32_t>(kMaxEncoders, bgfx::getCaps()->limits.maxEncoders);
+		for (uint32_t ii = 1; ii < m_numEncoders; ++ii)
+		{
+			m_worker[ii].init(&m_scene, &m_done);
+		}
+
+		// Make sure all resources are created before measuring anything.
+		bgfx::frame();
+		bgfx::frame();
+	}
+
+	void shutdown()
+	{
+		for (uint32_t ii = 1; ii < m_numEncoders; ++ii)
+		{
+			m_worker[ii].shutdown();
+		}
+
+		m_scene.shutdown();
+		bgfx::frame();
+	}
+
+	/// Submits draws split evenly across encoders, returns time spent submitting.
+	int64_t submit(uint32_t _numDraws, uint32_t _numEncoders, uint16_t _numUniforms)
+	{
+		const uint32_t perEncoder = (_numDraws + _numEncoders - 1)/_numEncoders;
+
+		const int64_t start = bx::getHPCounter();
+
+		for (uint32_t ii = 1; ii < _numEncoders; ++ii)
+		{
+			const uint32_t begin = bx::min(ii*perEncoder, _numDraws);
+			const uint32_t end   = bx::min(begin+perEncoder, _numDraws);
+			m_worker[ii].kick(begin, end, _numUniforms);
+		}
+
+		bgfx::Encoder* encoder = bgfx::begin();
+		m_scene.submit(encoder, 0, bx::min(perEncoder, _numDraws), _numUniforms);
+		bgfx::end(encoder);
+
+		for (uint32_t ii = 1; ii < _numEncoders; ++ii)
+		{
+			m_done.wait();
+		}
+
+		return bx::getHPCounter() - start;
+	}
+
+	static int64_t frame()
+	{
+		const int64_t start = bx::getHPCounter();
+		bgfx::frame();
+		return bx::getHPCounter() - start;
+	}
+
+	void runFrameEmpty()
+	{
+		Samples frameMs;
+
+		for (uint32_t ii = 0; ii < m_warmup + m_iterations; ++ii)
+		{
+			const int64_t frameTime = frame();
+
+			if (ii >= m_warmup)
+			{
+				frameMs.add(frameTime);
+			}
+		}
+
+		m_report.beginResult("frame_empty");
+		m_report.samples("frameMs", frameMs);
+		m_report.endResult();
+	}
+
+	void runSubmit(uint32_t _numDraws)
+	{
+		for (uint32_t numEncoders = 1; numEncoders <= m_numEncoders; numEncoders *= 2)
+		{
+			Samples submitMs;
+			Samples frameMs;
+
+			for (uint32_t ii = 0; ii < m_warmup + m_iterations; ++ii)
+			{
+				const int64_t submitTime = submit(_numDraws, numEncoders, 0);
+				const int64_t frameTime  = frame();
+
+				if (ii >= m_warmup)
+				{
+					submitMs.add(submitTime);
+					frameMs.add(frameTime);
+				}
+			}
+
+			m_report.beginResult("submit");
+			m_report.value("encoders", numEncoders);
+			m_report.value("draws", _numDraws);
+			m_report.samples("submitMs", submitMs);
+			m_report.samples("frameMs", frameMs);
+			m_report.endResult();
+		}
+	}
+
+	void runSort()
+	{
+		const uint32_t maxDraws = bgfx::getCaps()->limits.maxDrawCalls;
+
+		for (uint32_t numDraws = 1024;; numDraws *= 4)
+		{
+			numDraws = bx::min(numDraws, maxDraws);
+
+			Samples sortMs;
+			Samples frameMs;
+
+			for (uint32_t ii = 0; ii < m_warmup + m_iterations; ++ii)
+			{
+				submit(numDraws, 1, 0);
+				const int64_t frameTime = frame();
+
+				if (ii >= m_warmup)
+				{
+					// Stats are from previously rendered frame, which had the
+					// same number of draws.
+					sortMs.add(bgfx::getStats()->cpuTimeSort);
+					frameMs.add(frameTime);
+				}
+			}
+
+			m_report.beginResult("sort");
+			m_report.value("draws", numDraws);
+			m_report.samples("sortMs", sortMs);
+			m_report.samples("frameMs", frameMs);
+			m_report.endResult();
+
+			if (numDraws == maxDraws)
+			{
+				break;
+			}
+		}
+	}
+
+	void runUniforms(uint32_t _numDraws)
+	{
+		static const uint16_t s_numUniforms[] = { 0, 1, 4, kMaxUniforms };
+
+		for (uint32_t jj = 0; jj < BX_COUNTOF(s_numUniforms); ++jj)
+		{
+			const uint16_t numUniforms = s_numUniforms[jj];
+
+			Samples submitMs;
+			Samples frameMs;
+
+			for (uint32_t ii = 0; ii < m_warmup + m_iterations; ++ii)
+			{
+				const int64_t submitTime = submit(_numDraws, 1, numUniforms);
+				const int64_t frameTime  = frame();
+
+				if (ii >= m_warmup)
+				{
+					submitMs.add(submitTime);
+					frameMs.add(frameTime);
+				}
+			}
+
+			m_report.beginResult("uniforms");
+			m_report.value("draws", _numDraws);
+			m_report.value("uniformsPerDraw", uint32_t(numUniforms) );
+			m_report.value("uniformsSkipped", bgfx::getStats()->numUniformsSkipped);
+			m_report.samples("submitMs", submitMs);
+			m_report.samples("frameMs", frameMs);
+			m_report.endResult();
+		}
+	}
+
+	void runTransient(uint32_t _numAllocs)
+	{
+		const uint32_t numVertices = 64;
+		const uint32_t numIndices  = BX_COUNTOF(s_indexData);
+
+		Samples allocMs;
+		Samples frameMs;
+		uint32_t numFailed = 0;
+
+		for (uint32_t ii = 0; ii < m_warmup + m_iterations; ++ii)
+		{
+			const int64_t start = bx::getHPCounter();
+
+			for (uint32_t jj = 0; jj < _numAllocs; ++jj)
+			{
+				bgfx::TransientVertexBuffer tvb;
+				bgfx::TransientIndexBuffer  tib;
+				if (!bgfx::allocTransientBuffers(&tvb, m_scene.m_layout, numVertices, &tib, numIndices) )
+				{
+					++numFailed;
+				}
+			}
+
+			const int64_t allocTime = bx::getHPCounter() - start;
+			const int64_t frameTime = frame();
+
+			if (ii >= m_warmup)
+			{
+				allocMs.add(allocTime);
+				frameMs.add(frameTime);
+			}
+		}
+
+		m_report.beginResult("transient");
+		m_report.value("allocs", _numAllocs);
+		m_report.value("failed", numFailed);
+		m_report.samples("allocMs", allocMs);
+		m_report.samples("frameMs", frameMs);
+		m_report.endResult();
+	}
+
+	void runDynamicChurn(uint32_t _numBuffers)
+	{
+		bgfx::DynamicVertexBufferHandle handles[kMaxBuffers];
+		_numBuffers = bx::min(_numBuffers, kMaxBuffers);
+
+		const uint16_t stride = m_scene.m_layout.getStride();
+
+		Samples createMs;
+		Samples updateMs;
+		Samples destroyMs;
+		Samples frameMs;
+
+		bx::RngMwc rng;
+
+		for (uint32_t ii = 0; ii < m_warmup + m_iterations; ++ii)
+		{
+			int64_t start = bx::getHPCounter();
+
+			for (uint32_t jj = 0; jj < _numBuffers; ++jj)
+			{
+				const uint32_t numVertices = 16 + rng.gen()%(kMaxVertices-16);
+				handles[jj] = bgfx::createDynamicVertexBuffer(
+					  bgfx::makeRef(s_vertexData, numVertices*stride)
+					, m_scene.m_layout
+					);
+			}
+
+			const int64_t createTime = bx::getHPCounter() - start;
+			start = bx::getHPCounter();
+
+			for (uint32_t jj = 0; jj < _numBuffers; ++jj)
+			{
+				bgfx::update(handles[jj], 0, bgfx::makeRef(s_vertexData, 16*stride) );
+			}
+
+			const int64_t updateTime = bx::getHPCounter() - start;
+			start = bx::getHPCounter();
+
+			for (uint32_t jj = 0; jj < _numBuffers; ++jj)
+			{
+				bgfx::destroy(handles[jj]);
+			}
+
+			const int64_t destroyTime = bx::getHPCounter() - start;
+			const int64_t frameTime   = frame();
+
+			if (ii >= m_warmup)
+			{
+				createMs.add(createTime);
+				updateMs.add(updateTime);
+				destroyMs.add(destroyTime);
+				frameMs.add(frameTime);
+			}
+		}
+
+		m_report.beginResult("dynamic_churn");
+		m_report.value("buffers", _numBuffers);
+		m_report.samples("createMs", createMs);
+		m_report.samples("updateMs", updateMs);
+		m_report.samples("destroyMs", destroyMs);
+		m_report.samples("frameMs", frameMs);
+		m_report.endResult();
+	}
+
+	Report&       m_report;
+	Scene         m_scene;
+	Worker        m_worker[kMaxEncoders];
+	bx::Semaphore m_done;
+	uint32_t      m_numEncoders;
+	uint32_t      m_iterations;
+	uint32_t      m_warmup;
+};
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		fprintf(stderr, "Error:\n%s\n\n", _error);
+	}
+
+	fprintf(stderr
+		, "bgfx-bench, bgfx headless submission benchmark, version %d.%d.%d.\n"
+		  "Copyright 2011-2020 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_BENCH_VERSION_MAJOR
+		, BGFX_BENCH_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	fprintf(stderr
+		, "Usage: bgfx-bench [options]\n"
+		  "\n"
+		  "Runs bgfx with Noop renderer, and measures CPU cost of submission: draw submit\n"
+		  "per number of encoders, frame sort per number of draws, uniform encoding,\n"
+		  "transient buffer allocation, dynamic buffer churn, and frame latency.\n"
+		  "Noop renderer doesn't execute frame, so backend cost is not measured.\n"
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -o <file path>           Output JSON file path (default: stdout).\n"
+		  "      --iterations <num>   Number of measured frames per benchmark (default: 30).\n"
+		  "      --draws <num>        Number of draws for submit and uniform benchmarks (default: 16384).\n"
+		  "      --mt                 Use bgfx render thread instead of single threaded mode.\n"
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		fprintf(stderr
+			, "bgfx-bench, bgfx headless submission benchmark, version %d.%d.%d.\n"
+			, BGFX_BENCH_VERSION_MAJOR
+			, BGFX_BENCH_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	uint32_t iterations = 30;
+	const char* str = cmdLine.findOption("iterations");
+	if (NULL != str)
+	{
+		bx::fromString(&iterations, str);
+		iterations = bx::clamp<uint32_t>(iterations, 1, kMaxIterations);
+	}
+
+	uint32_t numDraws = 16384;
+	str = cmdLine.findOption("draws");
+	if (NULL != str)
+	{
+		bx::fromString(&numDraws, str);
+		numDraws = bx::max<uint32_t>(numDraws, 1);
+	}
+
+	FILE* out = stdout;
+	const char* outFilePath = cmdLine.findOption('o');
+	if (NULL != outFilePath)
+	{
+		out = fopen(outFilePath, "wb");
+		if (NULL == out)
+		{
+			help("Failed to open output file.");
+			return bx::kExitFailure;
+		}
+	}
+
+	const bool multithreaded = cmdLine.hasArg("mt");
+	if (!multithreaded)
+	{
+		// Calling renderFrame before init puts bgfx into single threaded mode,
+		// so that frame time includes both submit and render side.
+		bgfx::renderFrame();
+	}
+
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+	init.resolution.reset  = BGFX_RESET_NONE;
+	init.limits.maxEncoders = kMaxEncoders;
+
+	if (!bgfx::init(init) )
+	{
+		help("Failed to initialize bgfx.");
+		return bx::kExitFailure;
+	}
+
+	numDraws = bx::min(numDraws, bgfx::getCaps()->limits.maxDrawCalls);
+
+	Report report(out);
+	report.begin(bgfx::getRendererType(), multithreaded, iterations);
+
+	Bench bench(report, iterations);
+	bench.init();
+
+	bench.runFrameEmpty();
+	bench.runSubmit(numDraws);
+	bench.runSort();
+	bench.runUniforms(numDraws);
+	bench.runTransient(4096);
+	bench.runDynamicChurn(kMaxBuffers);
+
+	bench.shutdown();
+
+	report.end();
+
+	bgfx::shutdown();
+
+	if (stdout != out)
+	{
+		fclose(out);
+	}
+
+	return bx::kExitSuccess;
+}
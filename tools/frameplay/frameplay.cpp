@@ -0,0 +1,169 @@
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+
+#include <bgfx/bgfx.h>
+
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <entry/entry.h>
+#include <bgfx_utils.h>
+
+#define BGFX_FRAMEPLAY_VERSION_MAJOR 1
+#define BGFX_FRAMEPLAY_VERSION_MINOR 0
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		fprintf(stderr, "Error:\n%s\n\n", _error);
+	}
+
+	fprintf(stderr
+		, "frameplay, bgfx frame trace player tool, version %d.%d.%d.\n"
+		  "Copyright 2011-2020 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_FRAMEPLAY_VERSION_MAJOR
+		, BGFX_FRAMEPLAY_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	fprintf(stderr
+		, "Usage: frameplay -f <frame trace file path>\n"
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -f <file path>           Frame trace file path (captured with bgfx::startFrameTrace).\n"
+		  "      --loops <num>        Number of times to replay frame trace (default: 10).\n"
+		  "      --noop               Replay with Noop renderer (measures CPU submission cost only).\n"
+		  "      --gl, --vk, ...      Select renderer.\n"
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int _main_(int _argc, char** _argv)
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		fprintf(stderr
+			, "frameplay, bgfx frame trace player tool, version %d.%d.%d.\n"
+			, BGFX_FRAMEPLAY_VERSION_MAJOR
+			, BGFX_FRAMEPLAY_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	const char* filePath = cmdLine.findOption('f');
+	if (NULL == filePath)
+	{
+		help("Frame trace file must be specified.");
+		return bx::kExitFailure;
+	}
+
+	uint32_t numLoops = 10;
+	const char* loops = cmdLine.findOption("loops");
+	if (NULL != loops)
+	{
+		bx::fromString(&numLoops, loops);
+		numLoops = bx::max<uint32_t>(numLoops, 1);
+	}
+
+	Args args(_argc, _argv);
+
+	uint32_t width  = 1280;
+	uint32_t height = 720;
+	uint32_t debug  = BGFX_DEBUG_NONE;
+	uint32_t reset  = BGFX_RESET_NONE;
+
+	bgfx::Init init;
+	init.type     = args.m_type;
+	init.vendorId = args.m_pciId;
+	init.resolution.width  = width;
+	init.resolution.height = height;
+	init.resolution.reset  = reset;
+	bgfx::init(init);
+
+	bgfx::setDebug(debug);
+
+	const uint32_t numFrames = bgfx::openFrameTrace(filePath);
+	if (0 == numFrames)
+	{
+		bgfx::shutdown();
+
+		help("Failed to open frame trace file.");
+		return bx::kExitFailure;
+	}
+
+	fprintf(stderr
+		, "Replaying %d frames, %d loops, renderer %s.\n"
+		, numFrames
+		, numLoops
+		, bgfx::getRendererName(bgfx::getRendererType() )
+		);
+
+	const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+	int64_t minTime   = INT64_MAX;
+	int64_t maxTime   = 0;
+	int64_t totalTime = 0;
+	uint32_t numTimed = 0;
+	bool exit = false;
+
+	for (uint32_t loop = 0; loop < numLoops && !exit; ++loop)
+	{
+		int64_t loopTime = 0;
+
+		while (!exit
+		&&     bgfx::replayFrameTrace() )
+		{
+			const int64_t now = bx::getHPCounter();
+			bgfx::frame();
+			const int64_t frameTime = bx::getHPCounter() - now;
+
+			minTime    = bx::min(minTime, frameTime);
+			maxTime    = bx::max(maxTime, frameTime);
+			loopTime  += frameTime;
+			totalTime += frameTime;
+			++numTimed;
+
+			exit = entry::processEvents(width, height, debug, reset);
+		}
+
+		fprintf(stderr, "Loop %3d: %10.3f [ms]\n", loop, double(loopTime)*toMs);
+	}
+
+	// Flush destroy commands for resources created by replay.
+	bgfx::closeFrameTrace();
+	bgfx::frame();
+
+	if (0 < numTimed)
+	{
+		fprintf(stderr
+			, "Frame: min %.3f [ms], avg %.3f [ms], max %.3f [ms], %d frames.\n"
+			, double(minTime)*toMs
+			, double(totalTime)*toMs/double(numTimed)
+			, double(maxTime)*toMs
+			, numTimed
+			);
+	}
+
+	bgfx::shutdown();
+
+	return bx::kExitSuccess;
+}